@@ -0,0 +1,59 @@
+#include <M5Core2.h>
+#include <lvgl.h>
+#include <DevDashM5Core2/LVGLRenderer.h>
+#include <DevDashM5Core2/WifiListView.h>
+#include <DevDashM5Core2/AllocCounter.h>
+#include <ThemeManager.h>
+
+// Heap allocations per scan, list refresh and connect cycle, as counted by
+// AllocCounter. Build with the allocator wrapped (uncomment the lines in platformio.ini):
+//   -D DEVDASH_HEAP_TRACKING=1 -Wl,--wrap=malloc -Wl,--wrap=calloc -Wl,--wrap=realloc -Wl,--wrap=free
+// The first cycle may allocate (the list grows its rows, the store file is
+// written for new credentials); after that the list refresh should report
+// 0. Scan and connect counts cover the whole cycle, including what
+// WiFi.scanNetworks() and WiFi.begin() allocate on this task, so they need
+// not reach 0; allocations in the Wi-Fi driver's own tasks are not counted.
+// Set kSsid/kPassword to a reachable network to include connects.
+static const int kCycles = 10;
+static const char* kSsid = "";
+static const char* kPassword = "";
+
+static LVGLRenderer renderer;
+static ThemeManager theme;
+static WifiManager  manager;
+static WifiListView view;
+
+void setup() {
+    M5.begin();
+    Serial.begin(115200);
+    if (!AllocCounter::available()) {
+        Serial.println("Built without DEVDASH_HEAP_TRACKING; every count below is 0");
+    }
+    renderer.begin();
+    theme.begin();
+    theme.apply(theme.current());
+    manager.begin();
+    manager.loadCredentials();
+
+    lv_obj_t* panel = theme.createPanel(theme.createContainer(lv_screen_active()));
+    view.begin(panel, &theme, nullptr, nullptr);
+
+    for (int i = 0; i < kCycles; ++i) {
+        manager.scanNetworks(WifiManager::kMaxScanResults);
+        view.update(manager.getScannedNetworks(), manager);
+        lv_refr_now(nullptr);
+
+        unsigned connectAllocs = 0;
+        if (kSsid[0]) {
+            manager.disconnect();
+            if (manager.connect(kSsid, kPassword)) connectAllocs = manager.lastConnectAllocs();
+        }
+        Serial.printf("cycle %2d: scan %u allocs, refresh %u allocs, connect %u allocs (%u networks)\n", i,
+                      (unsigned)manager.lastScanStats().allocs, (unsigned)view.stats().allocs, connectAllocs,
+                      (unsigned)manager.getScannedNetworks().size());
+    }
+}
+
+void loop() {
+    delay(1000);
+}
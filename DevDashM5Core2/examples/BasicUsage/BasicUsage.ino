@@ -9,6 +9,8 @@ void setup() {
       1500
     };
     DevDash::begin("M5Core2", cfg);
+    // Optional: prepare the dashboard in the background so the gesture opens it instantly
+    // DevDash::setWarmStandby(true);
 }
 
 void loop() {
@@ -0,0 +1,65 @@
+#include <SPIFFS.h>
+#include <DevDashM5Core2/CredentialStore.h>
+
+// Times save/load/compact of the credential log at a few sizes. The store
+// holds at most CredentialStore::kMaxEntries networks, so past that the puts
+// update the saved ones with alternating keys: the log keeps growing and
+// the automatic compactions are part of the save time.
+static const size_t kSizes[] = { 10, 100, 1000 };
+static const char* const kKeys[] = { "correct horse battery staple", "tr0ub4dor&3" };
+
+void setup() {
+    Serial.begin(115200);
+    while (!Serial) { delay(10); }
+    if (!SPIFFS.begin(true)) {
+        Serial.println("SPIFFS mount failed");
+        return;
+    }
+
+    char ssid[CredentialStore::kMaxSsidLen + 1];
+    {
+        // The cap itself: one SSID more than kMaxEntries must be refused
+        CredentialStore store(SPIFFS, "/bench.db");
+        store.clear();
+        size_t stored = 0;
+        for (size_t i = 0; i <= CredentialStore::kMaxEntries; ++i) {
+            snprintf(ssid, sizeof(ssid), "bench-network-%u", (unsigned)i);
+            if (store.put(ssid, kKeys[0])) ++stored;
+        }
+        Serial.printf("cap: kMaxEntries=%u, stored %u of %u distinct SSIDs%s\n",
+                      (unsigned)CredentialStore::kMaxEntries, (unsigned)stored,
+                      (unsigned)(CredentialStore::kMaxEntries + 1),
+                      stored == CredentialStore::kMaxEntries ? "" : "  UNEXPECTED");
+        store.clear();
+    }
+
+    for (size_t n : kSizes) {
+        CredentialStore store(SPIFFS, "/bench.db");
+        store.clear();
+
+        size_t written = 0, failed = 0;
+        uint32_t start = micros();
+        for (size_t i = 0; i < n; ++i) {
+            snprintf(ssid, sizeof(ssid), "bench-network-%u", (unsigned)(i % CredentialStore::kMaxEntries));
+            if (store.put(ssid, kKeys[(i / CredentialStore::kMaxEntries) % 2])) ++written;
+            else ++failed;
+        }
+        uint32_t saveUs = micros() - start;
+
+        start = micros();
+        store.load();
+        uint32_t loadUs = micros() - start;
+
+        start = micros();
+        store.compact();
+        uint32_t compactUs = micros() - start;
+
+        Serial.printf("n=%4u  entries %2u  save %8lu us (%6lu us/put, %u failed)  load %8lu us  compact %8lu us\n",
+                      (unsigned)n, (unsigned)store.size(), (unsigned long)saveUs,
+                      (unsigned long)(written ? saveUs / written : 0), (unsigned)failed,
+                      (unsigned long)loadUs, (unsigned long)compactUs);
+        store.clear();
+    }
+}
+
+void loop() {}
@@ -0,0 +1,65 @@
+#include <M5Core2.h>
+#include <DevDashM5Core2/WorkExecutor.h>
+#include <BenchStats.h>
+
+// Measures the work executor on the device. Empty jobs are submitted from
+// loop()'s core while it drains completions, as the dashboard does; for
+// each job the sketch records the queue latency (submit to start of work on
+// the other core) and the round trip (submit to completion delivered by
+// drain()). It reports the BenchStats percentiles of both and the sustained throughput
+// with the queue kept full.
+static const int kJobs = 2000;
+
+struct Sample {
+    uint32_t submitUs;
+    uint32_t startUs;
+};
+
+static WorkExecutor work;
+static Sample samples[kJobs];
+static uint32_t waitUs[kJobs];
+static uint32_t roundUs[kJobs];
+static int delivered = 0;
+
+void setup() {
+    M5.begin();
+    Serial.begin(115200);
+    if (!work.begin()) return;
+
+    uint32_t start = micros();
+    int submitted = 0;
+    while (delivered < kJobs) {
+        // Keep the queue full: the rejected submit is the back-pressure
+        while (submitted < kJobs) {
+            samples[submitted].submitUs = micros();
+            if (!work.submit(
+                    [](void* user, const volatile bool&) {
+                        static_cast<Sample*>(user)->startUs = micros();
+                        return true;
+                    },
+                    [](void* user, WorkExecutor::Outcome) {
+                        Sample* s = static_cast<Sample*>(user);
+                        waitUs[delivered] = s->startUs - s->submitUs;
+                        roundUs[delivered] = micros() - s->submitUs;
+                        ++delivered;
+                    }, &samples[submitted])) {
+                break;
+            }
+            ++submitted;
+        }
+        work.drain();
+    }
+    uint32_t elapsed = micros() - start;
+
+    Serial.printf("%d jobs in %lu us: %.0f jobs/s (queue of %u)\n", kJobs, (unsigned long)elapsed,
+                  kJobs * 1e6f / elapsed, (unsigned)WorkExecutor::kCapacity);
+    BenchStats::report(Serial, "queue", waitUs, kJobs);
+    BenchStats::report(Serial, "roundtrip", roundUs, kJobs);
+    const WorkExecutor::Stats& st = work.stats();
+    Serial.printf("rejected submits %lu (queue full)\n", (unsigned long)st.rejected);
+    work.end();
+}
+
+void loop() {
+    delay(1000);
+}
@@ -0,0 +1,31 @@
+#include <M5Core2.h>
+#include <DevDashM5Core2/DevDashM5Core2.h>
+#include <DevDashM5Core2/HeapTracker.h>
+
+// Runs the dashboard and logs a heap report every minute, each one diffed
+// against the last, so a slow leak shows up as one tag's live bytes
+// climbing. Tag figures need the allocator wrapped (uncomment the lines in platformio.ini);
+// region figures are reported either way. The sketch's own allocations are
+// tagged Work here only to show a scope in use.
+static DevDashM5Core2 dash;
+
+void setup() {
+    M5.begin();
+    Serial.begin(115200);
+    if (!HeapTracker::tracking()) {
+        Serial.println("Built without DEVDASH_HEAP_TRACKING; only region figures are reported");
+    }
+    HeapTracker::setReportInterval(60UL * 1000);
+    dash.begin();
+}
+
+void loop() {
+    static uint32_t lastMs = 0;
+    if (millis() - lastMs > 5000) {
+        HeapTracker::Scope heap(HeapTracker::Tag::Work);
+        static String history;
+        history += '.'; // grows by a byte every 5 s
+        lastMs = millis();
+    }
+    dash.loop(); // also runs the periodic report
+}
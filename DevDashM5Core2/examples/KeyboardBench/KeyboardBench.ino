@@ -0,0 +1,103 @@
+#include <M5Core2.h>
+#include <lvgl.h>
+#include <DevDashM5Core2/LVGLRenderer.h>
+#include <DevDashM5Core2/SnapshotKeyboard.h>
+#include <ThemeManager.h>
+#include <BenchStats.h>
+#include "widgets/buttonmatrix/lv_buttonmatrix_private.h"
+
+// Types the same keys on the stock lv_keyboard and on SnapshotKeyboard
+// through a scripted pointer, and reports per keystroke (press + release)
+// the pixels flushed to the panel and the time from the input read until
+// the frame was pushed.
+static const int kKeys = 40;
+
+static LVGLRenderer renderer;
+static ThemeManager theme;
+static lv_point_t   script_point = { 0, 0 };
+static bool         script_pressed = false;
+static uint32_t     key_us[kKeys];
+
+static void scriptRead(lv_indev_t*, lv_indev_data_t* data) {
+    data->point = script_point;
+    data->state = script_pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+/** Center of a letter key on the default map, cycling through the rows */
+static lv_point_t keyCenter(lv_obj_t* kb, int n) {
+    const lv_buttonmatrix_t* btnm = reinterpret_cast<const lv_buttonmatrix_t*>(kb);
+    uint32_t id = 1 + (n * 7) % 20; // skip the edge keys (mode switch, backspace)
+    lv_area_t a = btnm->button_areas[id];
+    lv_area_t c;
+    lv_obj_get_coords(kb, &c);
+    lv_point_t p = { c.x1 + (a.x1 + a.x2) / 2, c.y1 + (a.y1 + a.y2) / 2 };
+    return p;
+}
+
+static void typeKeys(const char* name, lv_indev_t* indev, lv_obj_t* layout_kb, lv_obj_t* ta) {
+    uint32_t total_px = 0;
+    for (int i = 0; i < kKeys; ++i) {
+        script_point = keyCenter(layout_kb, i);
+        LVGLRenderer::resetFlushStats();
+
+        uint32_t t = micros();
+        script_pressed = true;
+        lv_indev_read(indev);
+        lv_refr_now(nullptr);
+        script_pressed = false;
+        lv_indev_read(indev);
+        lv_refr_now(nullptr);
+        const LVGLRenderer::FlushStats& fs = LVGLRenderer::flushStats();
+        t = (fs.frames ? fs.lastFrameUs : micros()) - t;
+
+        key_us[i] = t;
+        total_px += LVGLRenderer::flushStats().pixels;
+    }
+    BenchStats::report(Serial, name, key_us, kKeys);
+    Serial.printf("%-10s %lu px/key  (text: %u chars)\n", "", (unsigned long)(total_px / kKeys),
+                  (unsigned)strlen(lv_textarea_get_text(ta)));
+    lv_textarea_set_text(ta, "");
+    lv_refr_now(nullptr);
+}
+
+void setup() {
+    M5.begin();
+    Serial.begin(115200);
+    renderer.begin();
+    theme.begin();
+
+    lv_indev_t* indev = lv_indev_create();
+    lv_indev_set_type(indev, LV_INDEV_TYPE_POINTER);
+    lv_indev_set_read_cb(indev, scriptRead);
+    lv_timer_pause(lv_indev_get_read_timer(indev)); // read only when the script says so
+
+    lv_obj_t* ta = lv_textarea_create(lv_screen_active());
+    lv_textarea_set_one_line(ta, true);
+    lv_obj_align(ta, LV_ALIGN_TOP_MID, 0, 10);
+    lv_obj_add_state(ta, LV_STATE_FOCUSED);
+
+    // Stock keyboard
+    lv_obj_t* stock = lv_keyboard_create(lv_layer_top());
+    theme.addStyle(stock, ThemeManager::Role::Keyboard);
+    lv_keyboard_set_textarea(stock, ta);
+    lv_refr_now(nullptr);
+    typeKeys("stock", indev, stock, ta);
+    lv_obj_delete(stock);
+
+    // Snapshot-cached keyboard
+    SnapshotKeyboard cached;
+    cached.begin(lv_layer_top(), &theme);
+    cached.setTextarea(ta);
+    cached.show();
+    lv_refr_now(nullptr);
+    lv_obj_update_layout(cached.keyboard());
+    typeKeys("snapshot", indev, cached.keyboard(), ta);
+    Serial.printf("snapshot: %u maps cached in %lu us\n",
+                  cached.stats().snapshots, (unsigned long)cached.stats().snapshotUs);
+    cached.destroy();
+}
+
+void loop() {
+    renderer.loop();
+    delay(5);
+}
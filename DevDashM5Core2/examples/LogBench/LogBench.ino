@@ -0,0 +1,70 @@
+#include <M5Core2.h>
+#include <DevDashLog.h>
+#include <BenchStats.h>
+
+// Cost of a log call to the code that makes it, in CPU cycles: a record
+// queued for the drain task, a call below its module's level, a call over
+// its site's rate limit, and the Serial.printf() the dashboard used before.
+// Each case is timed per call and reported through BenchStats.
+static const int kCalls = 200;
+
+static uint32_t cycles[kCalls];
+
+static void report(const char* name) {
+    BenchStats::report(Serial, name, cycles, kCalls, "cycles");
+}
+
+void setup() {
+    M5.begin();
+    Serial.begin(115200);
+    DevDashLog::begin();
+    delay(100);
+
+    // Queued: spaced out so the ring never fills and no site hits its limit
+    DevDashLog::setRateLimit(0);
+    for (int i = 0; i < kCalls; ++i) {
+        uint32_t t = ESP.getCycleCount();
+        DD_LOGI(Core, "bench %d: %s %.2f", i, "queued", i * 0.5f);
+        cycles[i] = ESP.getCycleCount() - t;
+        if (i % 32 == 31) DevDashLog::flush();
+    }
+    DevDashLog::flush();
+    report("queued");
+
+    DevDashLog::setLevel(DevDashLog::Module::Core, DevDashLog::Level::Warn);
+    for (int i = 0; i < kCalls; ++i) {
+        uint32_t t = ESP.getCycleCount();
+        DD_LOGI(Core, "bench %d: %s %.2f", i, "disabled", i * 0.5f);
+        cycles[i] = ESP.getCycleCount() - t;
+    }
+    report("disabled");
+    DevDashLog::setLevel(DevDashLog::Module::Core, DevDashLog::Level::Info);
+
+    // One record gets through, the rest are counted against the site
+    DevDashLog::setRateLimit(1);
+    for (int i = 0; i < kCalls; ++i) {
+        uint32_t t = ESP.getCycleCount();
+        DD_LOGI(Core, "bench %d: %s %.2f", i, "limited", i * 0.5f);
+        cycles[i] = ESP.getCycleCount() - t;
+    }
+    DevDashLog::setRateLimit(DevDashLog::kDefaultRate);
+    DevDashLog::flush();
+    report("limited");
+
+    for (int i = 0; i < kCalls; ++i) {
+        uint32_t t = ESP.getCycleCount();
+        Serial.printf("bench %d: %s %.2f\n", i, "printf", i * 0.5f);
+        cycles[i] = ESP.getCycleCount() - t;
+    }
+    Serial.flush();
+    report("printf");
+
+    DevDashLog::Stats st = DevDashLog::stats();
+    Serial.printf("written %lu, dropped %lu, suppressed %lu, ring high water %u of %u\n",
+                  (unsigned long)st.written, (unsigned long)st.dropped, (unsigned long)st.suppressed,
+                  (unsigned)st.highWater, (unsigned)DevDashLog::kSlots);
+}
+
+void loop() {
+    delay(1000);
+}
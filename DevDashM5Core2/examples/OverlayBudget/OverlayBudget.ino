@@ -0,0 +1,69 @@
+#include <M5Core2.h>
+#include <DevDash.h>
+#include <BenchStats.h>
+
+// Host-sketch harness for overlay mode. The sketch animates a bar on the
+// left of the screen and calls DevDash::loop() every iteration; each phase
+// opens the dashboard, runs for kPhaseMs (scans, auto-reconnect attempts and
+// one suspend/resume included) and reports how long DevDash::loop() took:
+// median, p99, worst, and calls over the budget. Phase 1 is the unbounded
+// full-screen dashboard, phase 2 the 200 px overlay with kBudgetUs. The
+// percentiles cover the first kMaxSamples calls; worst covers all of them.
+static const uint32_t kPhaseMs  = 30000;
+static const uint32_t kBudgetUs = 8000;
+static const int kMaxSamples = 8000;
+
+static uint32_t samples[kMaxSamples];
+
+static void hostFrame(int16_t width) {
+    // Stand-in for the host sketch's own work
+    static int16_t x = 0;
+    M5.Lcd.fillRect(x, 100, 4, 40, BLACK);
+    x = (x + 2) % (width - 4);
+    M5.Lcd.fillRect(x, 100, 4, 40, GREEN);
+}
+
+static void phase(const char* name, int16_t hostWidth) {
+    DevDash::resetLoopStats();
+    DevDash::open();
+    int n = 0;
+    bool suspended = false;
+    uint32_t start = millis();
+    while (millis() - start < kPhaseMs) {
+        M5.update();
+        if (hostWidth) hostFrame(hostWidth);
+
+        uint32_t elapsed = millis() - start;
+        if (!suspended && elapsed > kPhaseMs / 2) {
+            DevDash::suspend(true);
+            DevDash::resume();
+            suspended = true;
+        }
+        uint32_t t = micros();
+        DevDash::loop();
+        if (n < kMaxSamples) samples[n++] = micros() - t;
+    }
+    BenchStats::report(Serial, name, samples, n);
+    const DevDash::LoopStats& s = DevDash::loopStats();
+    Serial.printf("%-10s worst %lu us  over budget %lu\n", "", (unsigned long)s.worstUs,
+                  (unsigned long)s.overBudget);
+    DevDash::destroy();
+}
+
+void setup() {
+    M5.begin();
+    Serial.begin(115200);
+
+    DevDash::begin("M5Core2");
+    phase("full", 0);
+
+    M5.Lcd.fillScreen(BLACK);
+    DevDash::begin("M5Core2");
+    DevDash::setOverlay(120, 0, 200, 240);
+    DevDash::setLoopBudget(kBudgetUs);
+    phase("overlay", 120);
+}
+
+void loop() {
+    delay(1000);
+}
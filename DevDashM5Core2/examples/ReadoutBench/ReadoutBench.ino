@@ -0,0 +1,84 @@
+#include <M5Core2.h>
+#include <lvgl.h>
+#include <DevDashM5Core2/LVGLRenderer.h>
+#include <DevDashM5Core2/NumericReadout.h>
+#include <BenchStats.h>
+
+// Updates four sensor-style values at 100 Hz for kUpdates rounds, first as
+// labels through lv_label_set_text_fmt() and then as NumericReadouts, and
+// reports per update the time spent in the setter, the time to render and
+// flush the frame, and the pixels flushed.
+static const int kValues  = 4;
+static const int kUpdates = 500;
+static const uint32_t kPeriodUs = 10000; // 100 Hz
+
+static LVGLRenderer renderer;
+static uint32_t set_us[kUpdates];
+static uint32_t frame_us[kUpdates];
+
+static float sample(int value, int round) {
+    // Slowly drifting readings: most updates change only the last digits
+    return 20.0f * value + 5.0f * sinf(round * 0.02f + value) + (round % 7) * 0.01f;
+}
+
+static lv_obj_t* makeColumn() {
+    lv_obj_t* col = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(col, lv_pct(100), lv_pct(100));
+    lv_obj_set_flex_flow(col, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_style_bg_color(col, lv_color_white(), 0);
+    return col;
+}
+
+template <typename Update>
+static void run(const char* name, Update update) {
+    uint32_t pixels = 0;
+    uint32_t next = micros();
+    for (int r = 0; r < kUpdates; ++r) {
+        while ((int32_t)(micros() - next) < 0) {}
+        next += kPeriodUs;
+
+        LVGLRenderer::resetFlushStats();
+        uint32_t t = micros();
+        for (int v = 0; v < kValues; ++v) update(v, sample(v, r));
+        uint32_t t1 = micros();
+        lv_refr_now(nullptr);
+        uint32_t t2 = micros();
+
+        set_us[r] = t1 - t;
+        frame_us[r] = t2 - t1;
+        pixels += LVGLRenderer::flushStats().pixels;
+    }
+    Serial.printf("%s: %lu px/update\n", name, (unsigned long)(pixels / kUpdates));
+    BenchStats::report(Serial, "  set", set_us, kUpdates);
+    BenchStats::report(Serial, "  frame", frame_us, kUpdates);
+}
+
+void setup() {
+    M5.begin();
+    Serial.begin(115200);
+    renderer.begin();
+
+    static lv_obj_t* labels[kValues];
+    lv_obj_t* col = makeColumn();
+    for (auto& l : labels) {
+        l = lv_label_create(col);
+        lv_obj_set_style_text_font(l, &lv_font_montserrat_22, 0);
+    }
+    lv_refr_now(nullptr);
+    run("label", [](int v, float x) { lv_label_set_text_fmt(labels[v], "%7.2f", x); });
+    lv_obj_delete(col);
+
+    static NumericReadout readouts[kValues];
+    col = makeColumn();
+    for (auto& ro : readouts) ro.create(col, &lv_font_montserrat_22, lv_color_black(), lv_color_white(), 7, 2);
+    lv_refr_now(nullptr);
+    run("readout", [](int v, float x) { readouts[v].set(x); });
+    uint32_t cells = 0;
+    for (auto& ro : readouts) cells += ro.stats().cellsChanged;
+    Serial.printf("readout: %.2f cells redrawn per value update\n", (float)cells / (kValues * kUpdates));
+}
+
+void loop() {
+    renderer.loop();
+    delay(5);
+}
@@ -0,0 +1,53 @@
+#include <M5Core2.h>
+#include <DevDashM5Core2/DevDashM5Core2.h>
+#include <BenchStats.h>
+
+// Full-frame time of each dashboard screen and of the password keyboard.
+// Every frame invalidates the whole screen and renders it with
+// lv_refr_now(). The time includes pushing the pixels to the panel, which
+// does not depend on the draw units, so build once with
+// LV_DRAW_SW_DRAW_UNIT_CNT 1 and once with 2 in include/lv_conf.h and the
+// difference between the runs is rendering.
+static const int kFrames = 60;
+
+static DevDashM5Core2* device = nullptr;
+static uint32_t frame_us[kFrames];
+
+static void measure(const char* name) {
+    for (int i = 0; i < kFrames; ++i) {
+        lv_obj_invalidate(lv_screen_active());
+        lv_obj_invalidate(lv_layer_top());
+        uint32_t t = micros();
+        lv_refr_now(nullptr);
+        frame_us[i] = micros() - t;
+    }
+    BenchStats::report(Serial, name, frame_us, kFrames);
+}
+
+void setup() {
+    M5.begin();
+    Serial.begin(115200);
+    Serial.printf("draw units %d\n", LV_DRAW_SW_DRAW_UNIT_CNT);
+    device = new DevDashM5Core2();
+    if (!device->begin()) {
+        Serial.println("begin() failed");
+        return;
+    }
+
+    ScreenManager& screens = device->screens();
+    for (size_t id = 0; id < screens.count(); ++id) {
+        screens.show((int)id);
+        measure(screens.name((int)id));
+    }
+#if DEVDASH_ENABLE_WIFI_UI
+    screens.show(0);
+    device->showPasswordModal("RenderBench");
+    measure("keyboard");
+    device->hidePasswordModal();
+#endif
+}
+
+void loop() {
+    M5.update();
+    device->loop();
+}
@@ -0,0 +1,61 @@
+#include <M5Core2.h>
+#include <DevDashM5Core2/DevDashM5Core2.h>
+
+// Reports gesture-to-first-frame latency for a cold start and for warm
+// standby. The gesture is simulated kGestureMs after boot. Each boot runs
+// one mode and restarts into the other, so both start from a fresh heap;
+// the results of earlier boots are kept in RTC memory across the restart.
+static const uint32_t kGestureMs = 8000;
+static const uint32_t kMagic = 0x5747A11u;
+
+RTC_NOINIT_ATTR static uint32_t magic;
+RTC_NOINIT_ATTR static uint32_t runs;
+RTC_NOINIT_ATTR static uint32_t cold_us;
+RTC_NOINIT_ATTR static uint32_t warm_us;
+
+static DevDashM5Core2* device = nullptr;
+static bool warm = false;
+static bool opened = false;
+
+void setup() {
+    M5.begin();
+    Serial.begin(115200);
+    if (magic != kMagic) {
+        magic = kMagic;
+        runs = cold_us = warm_us = 0;
+    }
+    warm = runs & 1;
+    Serial.printf("Run %lu: %s start, gesture at %lu ms\n", (unsigned long)runs, warm ? "warm" : "cold",
+                  (unsigned long)kGestureMs);
+    device = new DevDashM5Core2();
+}
+
+void loop() {
+    M5.update();
+    if (!opened) {
+        if (millis() < kGestureMs) {
+            if (warm) device->prepare();
+            return;
+        }
+        uint32_t start = micros();
+        bool ready = warm && device->prepare();
+        if (!device->begin()) {
+            Serial.println("begin() failed");
+            while (true) delay(1000);
+        }
+        uint32_t us = micros() - start;
+        opened = true;
+        if (warm) warm_us = us;
+        else cold_us = us;
+        Serial.printf("%s: gesture to first frame %.1f ms%s\n", warm ? "warm" : "cold", us / 1000.0f,
+                      warm && !ready ? " (standby not finished)" : "");
+        if (cold_us && warm_us) {
+            Serial.printf("cold %.1f ms, warm %.1f ms\n", cold_us / 1000.0f, warm_us / 1000.0f);
+        }
+    }
+    device->loop();
+    if (millis() > kGestureMs + 3000 && runs < 3) {
+        ++runs;
+        ESP.restart();
+    }
+}
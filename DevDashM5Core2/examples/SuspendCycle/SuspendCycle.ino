@@ -0,0 +1,82 @@
+#include <M5Core2.h>
+#include <DevDashM5Core2/DevDashM5Core2.h>
+#include <BenchStats.h>
+
+// Runs the dashboard through kCycles suspend/resume cycles, visiting every
+// screen and the password modal in each, and prints the heap counters after
+// every suspend. The first cycle pays one-time costs (Wi-Fi driver, SPIFFS,
+// font caches); from the second on, free memory and the largest free block
+// must come back to the same values, otherwise the cycle leaks. Cycles
+// alternate keeping state, so PSRAM differs by the parked block (~1 KB).
+static const int kCycles = 10;
+static const uint32_t kRunMs = 1500;
+
+static DevDashM5Core2* device = nullptr;
+static uint32_t resume_us[kCycles];
+
+struct HeapCounters {
+    size_t internal, internalBlock, psram, psramBlock;
+};
+
+static HeapCounters sample() {
+    HeapCounters h;
+    h.internal = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    h.internalBlock = heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL);
+    h.psram = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+    h.psramBlock = heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM);
+    return h;
+}
+
+static void run(uint32_t ms) {
+    uint32_t until = millis() + ms;
+    while ((int32_t)(millis() - until) < 0) {
+        M5.update();
+        device->loop();
+    }
+}
+
+void setup() {
+    M5.begin();
+    Serial.begin(115200);
+    device = new DevDashM5Core2();
+
+    HeapCounters before = sample();
+    HeapCounters baseline = before;
+    Serial.printf("start: internal %u (block %u), PSRAM %u (block %u)\n", (unsigned)before.internal,
+                  (unsigned)before.internalBlock, (unsigned)before.psram, (unsigned)before.psramBlock);
+    for (int c = 0; c < kCycles; ++c) {
+        uint32_t t = micros();
+        if (!device->begin()) {
+            Serial.println("begin() failed");
+            return;
+        }
+        uint32_t resumeUs = micros() - t;
+        resume_us[c] = resumeUs;
+        run(kRunMs);
+        device->screens().next();
+        run(kRunMs);
+        device->screens().next();
+        run(kRunMs);
+        device->showPasswordModal("bench");
+        run(kRunMs);
+        device->hidePasswordModal();
+
+        device->suspend(c % 2 == 0); // alternate keeping state
+        HeapCounters h = sample();
+        if (c == 0) baseline = h;
+        Serial.printf("cycle %d (%s): resume %lu us, internal %u (%+d vs cycle 0, block %u), "
+                      "PSRAM %u (%+d, block %u)\n",
+                      c, c % 2 == 0 ? "kept" : "dropped", (unsigned long)resumeUs,
+                      (unsigned)h.internal, (int)(h.internal - baseline.internal), (unsigned)h.internalBlock,
+                      (unsigned)h.psram, (int)(h.psram - baseline.psram), (unsigned)h.psramBlock);
+    }
+    BenchStats::report(Serial, "resume", resume_us, kCycles);
+    device->destroy();
+    HeapCounters after = sample();
+    Serial.printf("after destroy: internal %+d, PSRAM %+d vs start\n",
+                  (int)(after.internal - before.internal), (int)(after.psram - before.psram));
+}
+
+void loop() {
+    delay(1000);
+}
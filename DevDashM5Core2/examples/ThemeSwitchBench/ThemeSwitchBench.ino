@@ -0,0 +1,86 @@
+#include <M5Core2.h>
+#include <lvgl.h>
+#include <DevDashM5Core2/LVGLRenderer.h>
+#include <DevDashM5Core2/WifiListView.h>
+#include <ThemeManager.h>
+#include <BenchStats.h>
+
+// Times light/dark switches on a populated screen: header, a Wi-Fi list of
+// kNetworks rows, a plain list and a (hidden) modal on the top layer. Reports
+// the rebind + notification time reported by ThemeManager and the time until
+// the repainted frame has been flushed, against the one-frame budget, and
+// what a style lookup costs on the screen and the modal (the dashboard only
+// measures that when built with DEVDASH_STYLE_TIMING).
+static const int kNetworks = 30;
+static const int kRounds   = 20;
+
+static LVGLRenderer renderer;
+static ThemeManager theme;
+static WifiManager  manager;
+static WifiListView wifiList;
+static uint32_t switch_us[kRounds];
+static uint32_t frame_us[kRounds];
+
+static void buildScreen() {
+    lv_obj_t* container = theme.createContainer(lv_screen_active());
+    theme.createHeader(container, "Theme bench", nullptr, nullptr);
+    lv_obj_t* panel = theme.createPanel(container);
+
+    wifiList.begin(panel, &theme, nullptr, nullptr);
+    std::vector<WiFiNetwork> networks;
+    for (int i = 0; i < kNetworks; ++i) {
+        WiFiNetwork nw;
+        nw.ssid = ("bench-" + String(i)).c_str();
+        nw.rssi = -40 - (i * 7) % 50;
+        networks.push_back(nw);
+    }
+    wifiList.update(networks, manager);
+
+    lv_obj_t* list = theme.createList(panel);
+    for (int i = 0; i < 10; ++i) {
+        theme.addListItem(list, "List item", [](lv_event_t*) {}, nullptr);
+    }
+
+    lv_obj_t* modal = theme.createModal();
+    lv_obj_t* row = theme.createFormRow(modal);
+    theme.createButton(row, "Cancel", [](lv_event_t*) {}, nullptr);
+    theme.createButton(row, "OK", [](lv_event_t*) {}, nullptr);
+}
+
+void setup() {
+    M5.begin();
+    Serial.begin(115200);
+    renderer.begin();
+    theme.begin();
+    buildScreen();
+    lv_refr_now(nullptr);
+
+    for (int r = 0; r < kRounds; ++r) {
+        ThemeManager::Mode next = theme.current() == ThemeManager::Mode::Light
+                                  ? ThemeManager::Mode::Dark : ThemeManager::Mode::Light;
+        uint32_t t = micros();
+        theme.apply(next);
+        lv_refr_now(nullptr);
+        t = micros() - t;
+
+        switch_us[r] = theme.lastSwitch().totalUs;
+        frame_us[r] = t;
+    }
+    Serial.printf("%u objects, %u styles rebound per switch\n",
+                  theme.lastSwitch().objects, theme.lastSwitch().rebound);
+    BenchStats::report(Serial, "switch", switch_us, kRounds);
+    BenchStats s = BenchStats::report(Serial, "+ frame", frame_us, kRounds);
+    Serial.printf("budget %lu us: %s\n", (unsigned long)ThemeManager::kSwitchBudgetUs,
+                  s.max <= ThemeManager::kSwitchBudgetUs ? "met" : "MISSED");
+
+    ThemeManager::LookupStats onScreen = ThemeManager::timeLookups(lv_screen_active());
+    ThemeManager::LookupStats onModal = ThemeManager::timeLookups(lv_layer_top());
+    Serial.printf("style lookup:     screen %lu ns (%lu objects)  modal %lu ns (%lu objects)\n",
+                  (unsigned long)onScreen.nsPerLookup(), (unsigned long)onScreen.objects,
+                  (unsigned long)onModal.nsPerLookup(), (unsigned long)onModal.objects);
+}
+
+void loop() {
+    renderer.loop();
+    delay(5);
+}
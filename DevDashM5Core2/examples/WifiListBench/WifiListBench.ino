@@ -0,0 +1,118 @@
+#include <M5Core2.h>
+#include <lvgl.h>
+#include <algorithm>
+#include <DevDashM5Core2/LVGLRenderer.h>
+#include <DevDashM5Core2/WifiListView.h>
+#include <ThemeManager.h>
+#include <BenchStats.h>
+
+// Compares the recycling, custom-drawn list against the old clean-and-rebuild
+// refresh of three-object flex rows, using 50 synthetic networks whose RSSI
+// and order change every round. Also reports LVGL heap per row and the time
+// to render one scroll step.
+static const int kNetworks = 50;
+static const int kRounds   = 20;
+
+static LVGLRenderer renderer;
+static ThemeManager theme;
+static WifiManager  manager;
+static uint32_t round_us[kRounds];
+
+static std::vector<WiFiNetwork> makeNetworks(int round) {
+    std::vector<WiFiNetwork> out;
+    for (int i = 0; i < kNetworks; ++i) {
+        WiFiNetwork nw;
+        nw.ssid = ("bench-" + String(i)).c_str();
+        nw.rssi = -40 - ((i * 7 + round * 13) % 50);
+        out.push_back(nw);
+    }
+    // Scan results arrive sorted by RSSI, so the order shifts every round
+    std::sort(out.begin(), out.end(), [](const WiFiNetwork& a, const WiFiNetwork& b) { return a.rssi > b.rssi; });
+    return out;
+}
+
+static void rebuild(lv_obj_t* panel, const std::vector<WiFiNetwork>& networks) {
+    lv_obj_clean(panel);
+    for (const auto& nw : networks) {
+        lv_obj_t* row = lv_obj_create(panel);
+        lv_obj_set_width(row, lv_pct(100));
+        lv_obj_set_height(row, LV_SIZE_CONTENT);
+        lv_obj_set_flex_flow(row, LV_FLEX_FLOW_ROW);
+        lv_obj_set_style_pad_row(row, 0, 0);
+        lv_obj_set_style_pad_column(row, 10, 0);
+        lv_obj_set_style_border_width(row, 0, 0);
+        lv_obj_set_style_bg_opa(row, LV_OPA_TRANSP, 0);
+        lv_obj_t* ssid = lv_label_create(row);
+        lv_label_set_text(ssid, nw.ssid.c_str());
+        lv_obj_set_flex_grow(ssid, 1);
+        lv_obj_t* rssi = lv_label_create(row);
+        lv_label_set_text_fmt(rssi, "%d dBm", (int)nw.rssi);
+        lv_obj_set_style_text_color(rssi, lv_palette_main(LV_PALETTE_BLUE), 0);
+        lv_obj_add_event_cb(row, [](lv_event_t*) {}, LV_EVENT_ALL, nullptr);
+    }
+}
+
+static size_t lvUsed() {
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+}
+
+static uint32_t scrollFrameUs(lv_obj_t* panel) {
+    const int kSteps = 20;
+    uint32_t total = 0;
+    for (int i = 0; i < kSteps; ++i) {
+        lv_obj_scroll_by(panel, 0, (i < kSteps / 2) ? -24 : 24, LV_ANIM_OFF);
+        uint32_t t = micros();
+        lv_refr_now(nullptr);
+        total += micros() - t;
+    }
+    return total / kSteps;
+}
+
+static lv_obj_t* makePanel() {
+    lv_obj_t* panel = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(panel, lv_pct(100), lv_pct(100));
+    lv_obj_set_flex_flow(panel, LV_FLEX_FLOW_COLUMN);
+    return panel;
+}
+
+void setup() {
+    M5.begin();
+    Serial.begin(115200);
+    renderer.begin();
+    theme.begin();
+    theme.apply(theme.current());
+
+    lv_obj_t* panel = makePanel();
+    size_t base = lvUsed();
+    for (int r = 0; r < kRounds; ++r) {
+        uint32_t t = micros();
+        rebuild(panel, makeNetworks(r));
+        lv_refr_now(nullptr);
+        round_us[r] = micros() - t;
+    }
+    BenchStats::report(Serial, "rebuild", round_us, kRounds);
+    Serial.printf("%-10s objects created %d  %u B/row  scroll frame %lu us\n", "", kRounds * kNetworks * 3,
+                  (unsigned)((lvUsed() - base) / kNetworks), (unsigned long)scrollFrameUs(panel));
+    lv_obj_delete(panel);
+
+    panel = makePanel();
+    base = lvUsed();
+    WifiListView view;
+    view.begin(panel, &theme, nullptr, nullptr);
+    uint32_t created = 0, moved = 0;
+    for (int r = 0; r < kRounds; ++r) {
+        uint32_t t = micros();
+        view.update(makeNetworks(r), manager);
+        lv_refr_now(nullptr);
+        round_us[r] = micros() - t;
+        created += view.stats().created;
+        moved += view.stats().moved;
+    }
+    BenchStats::report(Serial, "recycling", round_us, kRounds);
+    Serial.printf("%-10s objects created %lu  rows moved %lu  %u B/row  scroll frame %lu us\n", "", (unsigned long)created,
+                  (unsigned long)moved, (unsigned)((lvUsed() - base) / kNetworks), (unsigned long)scrollFrameUs(panel));
+}
+
+void loop() {}
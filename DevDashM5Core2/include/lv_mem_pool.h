@@ -0,0 +1,21 @@
+/**
+ * @file lv_mem_pool.h
+ * Pool provider for LVGL's built-in allocator (see LV_MEM_POOL_ALLOC in lv_conf.h).
+ */
+#ifndef LV_MEM_POOL_H
+#define LV_MEM_POOL_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Called by lv_init(); implemented in LVGLRenderer.cpp */
+void * devdash_lv_pool_alloc(size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*LV_MEM_POOL_H*/
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Arduino.h>
+#include <algorithm>
+
+/**
+ * Summary of a benchmark's per-run samples, shared by the example sketches
+ * and the host tests so every bench reports the same figures the same way:
+ *
+ *   queue      n 2000  avg    41  p50    38  p90    52  p99    97  max   410 us
+ *
+ * Percentiles are nearest-rank. Collect one sample per run into an array,
+ * then call of() or report(); both sort the array in place.
+ */
+struct BenchStats {
+    uint32_t n   = 0;
+    uint32_t avg = 0;
+    uint32_t p50 = 0;
+    uint32_t p90 = 0;
+    uint32_t p99 = 0;
+    uint32_t max = 0;
+
+    static BenchStats of(uint32_t* samples, size_t n) {
+        BenchStats s;
+        if (!n) return s;
+        std::sort(samples, samples + n);
+        uint64_t sum = 0;
+        for (size_t i = 0; i < n; ++i) sum += samples[i];
+        s.n   = (uint32_t)n;
+        s.avg = (uint32_t)(sum / n);
+        s.p50 = samples[rank_(n, 50)];
+        s.p90 = samples[rank_(n, 90)];
+        s.p99 = samples[rank_(n, 99)];
+        s.max = samples[n - 1];
+        return s;
+    }
+
+    /** Print one line as above to out (Serial on the device) and return the summary */
+    static BenchStats report(Print& out, const char* name, uint32_t* samples, size_t n,
+                             const char* unit = "us") {
+        BenchStats s = of(samples, n);
+        out.printf("%-10s n %4lu  avg %5lu  p50 %5lu  p90 %5lu  p99 %5lu  max %5lu %s\n", name,
+                   (unsigned long)s.n, (unsigned long)s.avg, (unsigned long)s.p50, (unsigned long)s.p90,
+                   (unsigned long)s.p99, (unsigned long)s.max, unit);
+        return s;
+    }
+
+private:
+    static size_t rank_(size_t n, uint8_t pct) {
+        size_t r = (n * pct + 99) / 100; // 1-based
+        return r ? r - 1 : 0;
+    }
+};
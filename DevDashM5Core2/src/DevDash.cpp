@@ -1,11 +1,24 @@
 #include <Arduino.h>
 #include "DevDash.h"
 #include <WString.h>
-#include "DevDashM5Core2/DevDashM5Core2.h"
+#include "DevDashDevice.h"
+#include "DevDashLog.h"
+#include "DevDashConsole.h"
 
-String DevDash::deviceName = "M5Core2";
-IDevice* DevDash::device   = nullptr;
+// Chosen at compile time (DevDashConfig.h), so calls into it are not virtual
+static DevDashDevice* device = nullptr;
+
+String DevDash::deviceName = DevDashDevice::kName;
 GestureTrigger* DevDash::gesture = nullptr;
+bool DevDash::warmStandby = false;
+bool DevDash::opened      = false;
+bool DevDash::prepared    = false;
+bool DevDash::suspended   = false;
+bool DevDash::opening     = false;
+uint32_t DevDash::openStartUs  = 0;
+uint32_t DevDash::loopBudgetUs = 0;
+int16_t  DevDash::overlay[4]   = { 0, 0, 0, 0 };
+DevDash::LoopStats DevDash::stats;
 
 void DevDash::begin() {
     GestureTrigger::Config defaultCfg{
@@ -35,26 +48,162 @@ void DevDash::begin(const String& devName, const GestureTrigger::Config& gesture
     if (gesture) { gesture->destroy(); delete gesture; }
     gesture = new GestureTrigger(gestureCfg);
     gesture->begin();
+#if DEVDASH_ENABLE_CONSOLE
+    addCommands_();
+#endif
 }
 
 void DevDash::loop() {
-    if (!device && gesture && gesture->checkAndFire()) {
-        if (deviceName == "M5Core2") {
-            device = new DevDashM5Core2();
-        } else {
-            Serial.print("DevDash::begin: Unknown device \"");
-            Serial.print(deviceName);
-            Serial.println("\". Initialization failed.");
+    uint32_t start = micros();
+#if DEVDASH_ENABLE_CONSOLE
+    DevDashConsole::poll();
+#endif
+    if (!opened) {
+        if (!opening && gesture && gesture->checkAndFire()) {
+            opening = true;
+            openStartUs = start;
+        }
+        if (!opening && (!warmStandby || suspended)) return;
+        if (!device && !createDevice_()) {
+            warmStandby = opening = false; // don't retry every loop
             return;
         }
-        device->begin();
+        if (!opening) {
+            prepared = device->prepare();
+        } else if (!loopBudgetUs || device->prepare()) {
+            // Unbounded: begin() does whatever is left in one go. Bounded:
+            // prepare() took one slice per call until only drawing was left
+            open_();
+        }
+        noteLoop_(start);
+        return;
     }
-    if (device) {
-        device->loop();
+    device->loop();
+    noteLoop_(start);
+}
+
+void DevDash::suspend(bool keepState) {
+    if (!device || !opened) return;
+    device->suspend(keepState);
+    opened = prepared = false;
+    suspended = true;
+}
+
+bool DevDash::resume() {
+    if (!suspended) return opened;
+    return open();
+}
+
+bool DevDash::open() {
+    if (opened) return true;
+    if (!device && !createDevice_()) return false;
+    opening = true;
+    openStartUs = micros();
+    if (loopBudgetUs) return true; // loop() brings it up a slice at a time
+    return open_();
+}
+
+void DevDash::setOverlay(int16_t x, int16_t y, int16_t w, int16_t h) {
+    overlay[0] = x;
+    overlay[1] = y;
+    overlay[2] = w;
+    overlay[3] = h;
+    if (device) device->setRegion(x, y, w, h);
+}
+
+void DevDash::setLoopBudget(uint32_t us) {
+    loopBudgetUs = us;
+    if (device) device->setLoopBudget(us);
+}
+
+bool DevDash::open_() {
+    opening = false;
+    if (!device->begin()) {
+        DD_LOGE(Core, "DevDash: device start failed.");
+        return false;
+    }
+    DD_LOGI(Core, "DevDash: %s start, gesture to first frame %.1f ms",
+            suspended ? "resumed" : prepared ? "warm" : "cold", (micros() - openStartUs) / 1000.0f);
+    opened = true;
+    suspended = false;
+    return true;
+}
+
+void DevDash::noteLoop_(uint32_t start) {
+    uint32_t us = micros() - start;
+    ++stats.calls;
+    stats.lastUs = us;
+    if (us > stats.worstUs) stats.worstUs = us;
+    if (loopBudgetUs && us > loopBudgetUs) ++stats.overBudget;
+}
+
+#if DEVDASH_ENABLE_CONSOLE
+/** Module or level by name; -1 if none matches */
+static int lookup(const char* name, const char* const* names, uint8_t count) {
+    for (uint8_t i = 0; i < count; ++i) {
+        if (strcmp(name, names[i]) == 0) return i;
+    }
+    return -1;
+}
+
+void DevDash::addCommands_() {
+    typedef DevDashConsole Con;
+    Con::add("log", "log [module|all] [off|error|warn|info|debug]: show or set levels", [](void*, uint8_t argc, char** argv) {
+        static const char* const kLevels[] = { "off", "error", "warn", "info", "debug" };
+        const uint8_t kModules = static_cast<uint8_t>(DevDashLog::Module::Count);
+        if (argc == 3) {
+            int level = lookup(argv[2], kLevels, 5);
+            bool all = strcmp(argv[1], "all") == 0;
+            int module = -1;
+            for (uint8_t m = 0; m < kModules && !all; ++m) {
+                if (strcmp(argv[1], DevDashLog::moduleName(static_cast<DevDashLog::Module>(m))) == 0) module = m;
+            }
+            if (level < 0 || (!all && module < 0)) {
+                Con::printf("log: unknown module or level\n");
+                return;
+            }
+            if (all) DevDashLog::setLevel(static_cast<DevDashLog::Level>(level));
+            else DevDashLog::setLevel(static_cast<DevDashLog::Module>(module), static_cast<DevDashLog::Level>(level));
+        }
+        for (uint8_t m = 0; m < kModules; ++m) {
+            DevDashLog::Module mod = static_cast<DevDashLog::Module>(m);
+            Con::printf("  %-8s %s\n", DevDashLog::moduleName(mod), kLevels[static_cast<uint8_t>(DevDashLog::level(mod))]);
+        }
+        DevDashLog::Stats st = DevDashLog::stats();
+        Con::printf("  %lu written, %lu dropped, %lu rate-limited, ring high water %u of %u\n",
+                    (unsigned long)st.written, (unsigned long)st.dropped, (unsigned long)st.suppressed,
+                    (unsigned)st.highWater, (unsigned)DevDashLog::kSlots);
+    });
+    Con::add("loop", "DevDash::loop() timing since the last reset; loop reset clears it", [](void*, uint8_t argc, char** argv) {
+        Con::printf("%lu calls, last %lu us, worst %lu us, %lu over budget (%lu us)\n",
+                    (unsigned long)stats.calls, (unsigned long)stats.lastUs, (unsigned long)stats.worstUs,
+                    (unsigned long)stats.overBudget, (unsigned long)loopBudgetUs);
+        if (argc > 1 && strcmp(argv[1], "reset") == 0) resetLoopStats();
+    });
+    Con::add("open", "open the dashboard", [](void*, uint8_t, char**) {
+        Con::printf(open() ? "open\n" : "open failed\n");
+    });
+    Con::add("suspend", "suspend the dashboard, keeping its state", [](void*, uint8_t, char**) {
+        suspend(true);
+        Con::printf(suspended ? "suspended\n" : "not open\n");
+    });
+}
+#endif
+
+bool DevDash::createDevice_() {
+    if (deviceName != DevDashDevice::kName) {
+        DD_LOGE(Core, "DevDash::begin: Device \"%s\" is not the one this firmware was built for (%s). "
+                "Initialization failed.", deviceName, DevDashDevice::kName);
+        return false;
     }
+    device = new DevDashDevice();
+    device->setRegion(overlay[0], overlay[1], overlay[2], overlay[3]);
+    device->setLoopBudget(loopBudgetUs);
+    return true;
 }
 
 void DevDash::destroy() {
     if (device) { device->destroy(); delete device; device = nullptr; }
+    opened = prepared = suspended = opening = false;
     if (gesture) { gesture->destroy(); delete gesture; gesture = nullptr; }
 }
\ No newline at end of file
@@ -11,6 +11,47 @@ public:
     static void begin(const GestureTrigger::Config& gestureCfg);
     static void begin(const String& deviceName, const GestureTrigger::Config& gestureCfg);
     static void loop();
+
+    /**
+     * Warm standby: build the device and prepare LVGL, styles, credentials
+     * and screens a slice per loop() before the gesture, so opening only
+     * has to draw. Off by default; call before the first loop().
+     */
+    static void setWarmStandby(bool enable) { warmStandby = enable; }
+
+    /**
+     * Give the dashboard's RAM back to the host sketch. The gesture (or
+     * resume()) rebuilds it; keepState parks what was on screen in PSRAM.
+     */
+    static void suspend(bool keepState = true);
+    static bool resume();
+
+    /** Open now, as if the gesture had fired */
+    static bool open();
+
+    /**
+     * Overlay mode: draw into this part of the screen and leave the rest to
+     * the host sketch. Call before the dashboard opens; zero size = full screen.
+     */
+    static void setOverlay(int16_t x, int16_t y, int16_t w, int16_t h);
+
+    /**
+     * Keep each loop() call to roughly `us` microseconds: no blocking radio
+     * work or idle delay, start-up split into slices, and work that does not
+     * fit deferred to later calls. 0 (default) means unbounded.
+     */
+    static void setLoopBudget(uint32_t us);
+
+    /** Timing of loop() calls since the last reset */
+    struct LoopStats {
+        uint32_t calls = 0;
+        uint32_t overBudget = 0;  // calls longer than the budget
+        uint32_t lastUs = 0;
+        uint32_t worstUs = 0;
+    };
+    static const LoopStats& loopStats() { return stats; }
+    static void resetLoopStats() { stats = LoopStats(); }
+
     static void destroy();
 
 private:
@@ -18,6 +59,20 @@ private:
     ~DevDash() = delete;
 
     static String deviceName;
-    static IDevice* device;
     static GestureTrigger* gesture;
+    static bool warmStandby;
+    static bool opened;
+    static bool prepared;
+    static bool suspended;
+    static bool opening;
+    static uint32_t openStartUs;
+    static uint32_t loopBudgetUs;
+    static int16_t  overlay[4];
+    static LoopStats stats;
+
+    static bool open_();
+    static void noteLoop_(uint32_t start);
+
+    static bool createDevice_();
+    static void addCommands_();
 };
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+/*
+ * Build-time selection of the device and of the dashboard's optional parts.
+ * Override any of these with -D in build_flags (or edit the defaults here
+ * for the Arduino IDE). A disabled part is not compiled, so neither its code
+ * nor the libraries only it uses end up in the firmware.
+ */
+
+// Exactly one device
+#ifndef DEVDASH_DEVICE_M5CORE2
+#define DEVDASH_DEVICE_M5CORE2 1
+#endif
+
+// Wi-Fi screen: network list, password modal and keyboard. Connectivity
+// itself (WifiManager, saved credentials, auto-reconnect) is always built.
+#ifndef DEVDASH_ENABLE_WIFI_UI
+#define DEVDASH_ENABLE_WIFI_UI 1
+#endif
+
+// Link diagnostics modal, power-profile measurement and NetBench; it is
+// opened from the Wi-Fi screen header, so it follows that by default
+#ifndef DEVDASH_ENABLE_DIAGNOSTICS
+#define DEVDASH_ENABLE_DIAGNOSTICS DEVDASH_ENABLE_WIFI_UI
+#endif
+
+// Sensor screen (IMU, AXP192) and the sprite readouts it draws with
+#ifndef DEVDASH_ENABLE_SENSORS
+#define DEVDASH_ENABLE_SENSORS 1
+#endif
+
+#ifndef DEVDASH_ENABLE_SYSTEM_SCREEN
+#define DEVDASH_ENABLE_SYSTEM_SCREEN 1
+#endif
+
+// Command console on Serial (see DevDashConsole.h); type "help" for the list
+#ifndef DEVDASH_ENABLE_CONSOLE
+#define DEVDASH_ENABLE_CONSOLE 1
+#endif
+
+// Tag heap use by subsystem (see HeapTracker.h) and count allocations on the
+// Wi-Fi paths (AllocCounter.h). Also needs the allocator wrapped at link time:
+// -Wl,--wrap=malloc -Wl,--wrap=calloc -Wl,--wrap=realloc -Wl,--wrap=free
+#ifndef DEVDASH_HEAP_TRACKING
+#define DEVDASH_HEAP_TRACKING 0
+#endif
+
+// Walk every freshly built screen and modal to time style lookups
+// (ThemeManager::timeLookups) and show the figure on the System screen.
+// A debug aid: the walk adds to every screen build.
+#ifndef DEVDASH_STYLE_TIMING
+#define DEVDASH_STYLE_TIMING 0
+#endif
+
+#if DEVDASH_ENABLE_DIAGNOSTICS && !DEVDASH_ENABLE_WIFI_UI
+#error "DEVDASH_ENABLE_DIAGNOSTICS needs DEVDASH_ENABLE_WIFI_UI"
+#endif
+
+#if !DEVDASH_ENABLE_WIFI_UI && !DEVDASH_ENABLE_SENSORS && !DEVDASH_ENABLE_SYSTEM_SCREEN
+#error "DevDash needs at least one screen enabled"
+#endif
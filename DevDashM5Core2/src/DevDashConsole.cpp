@@ -0,0 +1,154 @@
+#include "DevDashConsole.h"
+#include <stdarg.h>
+
+constexpr uint8_t  DevDashConsole::kMaxCommands;
+constexpr uint8_t  DevDashConsole::kMaxArgs;
+constexpr uint8_t  DevDashConsole::kLineBytes;
+constexpr uint8_t  DevDashConsole::kMaxOutLine;
+constexpr uint16_t DevDashConsole::kOutBytes;
+constexpr uint8_t  DevDashConsole::kReadPerPoll;
+
+static const size_t kFormatBytes = 256; // one printf() call
+
+DevDashConsole::Command DevDashConsole::commands[kMaxCommands] = {
+    { "help", "list commands", DevDashConsole::help_, nullptr }
+};
+uint8_t  DevDashConsole::commandCount = 1;
+char     DevDashConsole::line[kLineBytes + 1];
+uint8_t  DevDashConsole::lineLen = 0;
+bool     DevDashConsole::skipping = false;
+char     DevDashConsole::out[kOutBytes];
+uint16_t DevDashConsole::outHead = 0;
+uint16_t DevDashConsole::outTail = 0;
+DevDashConsole::Stats DevDashConsole::counters = {};
+
+bool DevDashConsole::add(const char* name, const char* help, CommandFn fn, void* user) {
+    if (!name || !fn) return false;
+    for (uint8_t i = 0; i < commandCount; ++i) {
+        if (strcmp(commands[i].name, name) == 0) {
+            commands[i] = Command{ name, help ? help : "", fn, user }; // a newer owner replaces it
+            return true;
+        }
+    }
+    if (commandCount == kMaxCommands) return false;
+    commands[commandCount++] = Command{ name, help ? help : "", fn, user };
+    return true;
+}
+
+void DevDashConsole::removeAll(void* user) {
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < commandCount; ++i) {
+        if (commands[i].user != user || commands[i].fn == help_) commands[kept++] = commands[i];
+    }
+    commandCount = kept;
+}
+
+void DevDashConsole::printf(const char* fmt, ...) {
+    char buf[kFormatBytes];
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(buf, sizeof(buf), fmt, ap);
+    va_end(ap);
+    if (n <= 0) return;
+    if ((size_t)n >= sizeof(buf)) {
+        n = sizeof(buf) - 1;
+        buf[n - 1] = '\n'; // keep the line whole
+    }
+    write(buf, n);
+}
+
+void DevDashConsole::write(const char* text, size_t len) {
+    uint16_t used = outTail - outHead;
+    if (len > (size_t)(kOutBytes - used)) {
+        ++counters.dropped;
+        return;
+    }
+    for (size_t i = 0; i < len; ++i) out[(outTail + i) & (kOutBytes - 1)] = text[i];
+    outTail += len;
+}
+
+void DevDashConsole::poll() {
+    for (uint8_t budget = kReadPerPoll; budget && Serial.available() > 0; --budget) {
+        int c = Serial.read();
+        if (c < 0) break;
+        if (c == '\r' || c == '\n') {
+            if (skipping) {
+                skipping = false;
+                ++counters.overlong;
+                printf("line longer than %u characters ignored\n", (unsigned)kLineBytes);
+                continue;
+            }
+            if (!lineLen) continue; // the \n of \r\n, or an empty line
+            line[lineLen] = 0;
+            lineLen = 0;
+            run_();
+            break; // one command per poll; the rest waits for the next
+        }
+        if (skipping) continue;
+        if (c == '\b' || c == 0x7F) {
+            if (lineLen) --lineLen;
+            continue;
+        }
+        if (lineLen == kLineBytes) {
+            skipping = true;
+            lineLen = 0;
+            continue;
+        }
+        line[lineLen++] = (char)c;
+    }
+    drain_();
+}
+
+void DevDashConsole::run_() {
+    char* argv[kMaxArgs];
+    uint8_t argc = split_(line, argv);
+    if (!argc) return;
+    for (uint8_t i = 0; i < commandCount; ++i) {
+        if (strcmp(commands[i].name, argv[0]) == 0) {
+            ++counters.commands;
+            commands[i].fn(commands[i].user, argc, argv);
+            return;
+        }
+    }
+    ++counters.unknown;
+    printf("unknown command: %s (try help)\n", argv[0]);
+}
+
+uint8_t DevDashConsole::split_(char* s, char** argv) {
+    uint8_t argc = 0;
+    while (*s && argc < kMaxArgs) {
+        while (*s == ' ' || *s == '\t') ++s;
+        if (!*s) break;
+        char end = ' ';
+        if (*s == '"') { end = '"'; ++s; }
+        argv[argc++] = s;
+        while (*s && *s != end && !(end == ' ' && *s == '\t')) ++s;
+        if (*s) *s++ = 0;
+    }
+    return argc;
+}
+
+void DevDashConsole::drain_() {
+    // Whole lines only, and only when the UART can take one without waiting
+    for (;;) {
+        uint16_t used = outTail - outHead;
+        if (!used) return;
+        uint16_t len = 0;
+        uint16_t limit = used < kMaxOutLine ? used : kMaxOutLine;
+        while (len < limit && out[(outHead + len) & (kOutBytes - 1)] != '\n') ++len;
+        if (len < limit) ++len;              // through the newline
+        else if (len < kMaxOutLine) return;  // the rest of this line is not queued yet
+        if (Serial.availableForWrite() < (int)len) return;
+
+        char chunk[kMaxOutLine];
+        for (uint16_t i = 0; i < len; ++i) chunk[i] = out[(outHead + i) & (kOutBytes - 1)];
+        Serial.write((const uint8_t*)chunk, len);
+        outHead += len;
+    }
+}
+
+void DevDashConsole::help_(void*, uint8_t, char**) {
+    for (uint8_t i = 0; i < commandCount; ++i) {
+        printf("  %-10s %s\n", commands[i].name, commands[i].help);
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * Command console on Serial.
+ *
+ * poll() reads at most kReadPerPoll bytes of whatever has arrived, so a
+ * line is assembled over as many calls as it takes; when one is complete it
+ * is split into words (double quotes keep spaces, e.g. an SSID) and the
+ * matching command runs on the calling task. Output goes into a ring and
+ * is written a whole line at a time, only as far as the UART has room, so
+ * neither input nor output ever waits. A line that does not fit in the
+ * ring is dropped and counted. Lines are written with a single Serial
+ * call each, so they do not interleave with DevDashLog's.
+ *
+ *   DevDashConsole::add("ping", "reply pong", [](void*, uint8_t, char**) {
+ *       DevDashConsole::printf("pong\n");
+ *   });
+ */
+class DevDashConsole {
+public:
+    static constexpr uint8_t  kMaxCommands = 24;
+    static constexpr uint8_t  kMaxArgs     = 6;    // including the command name
+    static constexpr uint8_t  kLineBytes   = 96;   // longest input line
+    static constexpr uint8_t  kMaxOutLine  = 120;  // longer output lines are split
+    static constexpr uint16_t kOutBytes    = 2048; // output ring, power of two
+    static constexpr uint8_t  kReadPerPoll = 64;
+
+    /** argv[0] is the command name; the strings live until the command returns */
+    typedef void (*CommandFn)(void* user, uint8_t argc, char** argv);
+
+    /** Register a command; false if the table is full. Names must be literals. */
+    static bool add(const char* name, const char* help, CommandFn fn, void* user = nullptr);
+    /** Drop every command registered with this user pointer */
+    static void removeAll(void* user);
+
+    /** Queue formatted output, up to 255 characters of whole lines per call */
+    static void printf(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+    /** Queue text of any length; all of it, or nothing if the ring is full */
+    static void write(const char* text, size_t len);
+
+    /** Read input, run a finished command, write queued output; call from loop() */
+    static void poll();
+
+    struct Stats {
+        uint32_t commands;   // lines run
+        uint32_t unknown;    // lines naming no command
+        uint32_t overlong;   // input lines longer than kLineBytes, ignored
+        uint32_t dropped;    // output lines the ring had no room for
+    };
+    static const Stats& stats() { return counters; }
+
+private:
+    DevDashConsole() = delete;
+
+    struct Command {
+        const char* name;
+        const char* help;
+        CommandFn   fn;
+        void*       user;
+    };
+
+    static Command  commands[kMaxCommands];
+    static uint8_t  commandCount;
+    static char     line[kLineBytes + 1];
+    static uint8_t  lineLen;
+    static bool     skipping;      // discarding the rest of an overlong line
+    static char     out[kOutBytes];
+    static uint16_t outHead;       // next byte to write to Serial
+    static uint16_t outTail;       // next byte to fill
+    static Stats    counters;
+
+    static void run_();
+    static void drain_();
+    static uint8_t split_(char* s, char** argv);
+    static void help_(void*, uint8_t, char**);
+};
@@ -0,0 +1,14 @@
+#pragma once
+#include "DevDashConfig.h"
+
+/*
+ * The device implementation this firmware is built for. DevDash holds it by
+ * its concrete type, so calls into it are direct and no other device is
+ * linked in.
+ */
+#if DEVDASH_DEVICE_M5CORE2
+#include "DevDashM5Core2/DevDashM5Core2.h"
+typedef DevDashM5Core2 DevDashDevice;
+#else
+#error "No DevDash device selected; define DEVDASH_DEVICE_M5CORE2=1"
+#endif
@@ -0,0 +1,265 @@
+#include "DevDashLog.h"
+
+constexpr uint8_t  DevDashLog::kSlots;
+constexpr uint8_t  DevDashLog::kMaxArgs;
+constexpr uint8_t  DevDashLog::kDataBytes;
+constexpr uint16_t DevDashLog::kDefaultRate;
+
+static const uint32_t kDrainIdleMs = 10;
+static const uint32_t kTaskStack   = 4096;
+static const size_t   kLineBytes   = 256;
+
+static const char* const kModuleNames[] = {
+    "core", "boot", "lvgl", "ui", "wifi", "storage", "work", "sensors"
+};
+static const char kLevelChars[] = "-EWID";
+
+uint8_t DevDashLog::levels[static_cast<uint8_t>(Module::Count)] = {
+    3, 3, 3, 3, 3, 3, 3, 3 // Info
+};
+uint16_t DevDashLog::rateLimit = DevDashLog::kDefaultRate;
+
+/*
+ * Bounded multi-producer ring (Vyukov). A slot's sequence number says whose
+ * turn it is: producers wait for `pos`, the drain for `pos + 1`. It is
+ * stored minus the slot index so the zero-initialised ring is already
+ * empty, whatever static constructors log before setup().
+ */
+DevDashLog::Record DevDashLog::ring[DevDashLog::kSlots];
+static std::atomic<uint32_t> tail{0};    // next position producers claim
+static uint32_t head = 0;                // next position the drain reads
+static std::atomic<bool> draining{false};
+static std::atomic<bool> started{false};
+
+static std::atomic<uint32_t> written{0};
+static std::atomic<uint32_t> dropped{0};
+static std::atomic<uint32_t> suppressed{0};
+static std::atomic<uint8_t>  highWater{0};
+static uint32_t reportedDrops = 0;
+
+void DevDashLog::setLevel(Level l) {
+    for (auto& v : levels) v = static_cast<uint8_t>(l);
+}
+
+const char* DevDashLog::moduleName(Module m) {
+    uint8_t i = static_cast<uint8_t>(m);
+    return i < sizeof(kModuleNames) / sizeof(kModuleNames[0]) ? kModuleNames[i] : "?";
+}
+
+DevDashLog::Stats DevDashLog::stats() {
+    Stats s;
+    s.written = written;
+    s.dropped = dropped;
+    s.suppressed = suppressed;
+    s.highWater = highWater;
+    return s;
+}
+
+void DevDashLog::begin() {
+    if (started.exchange(true)) return;
+    xTaskCreatePinnedToCore(taskMain_, "devdash-log", kTaskStack, nullptr, tskIDLE_PRIORITY + 1, nullptr,
+                            tskNO_AFFINITY);
+}
+
+void DevDashLog::flush() {
+    while (draining.exchange(true)) vTaskDelay(1);
+    drainLocked_();
+    draining = false;
+    Serial.flush();
+}
+
+/* -------------------- Producers -------------------- */
+
+DevDashLog::Record* DevDashLog::claim_(Site& site, Module m, Level l, const char* fmt) {
+    if (!started) begin();
+    uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+
+    // Sites are shared unlocked between cores, so these counts are approximate
+    if (now - site.windowMs >= 1000) {
+        site.windowMs = now;
+        site.count = 0;
+    }
+    if (rateLimit && site.count >= rateLimit) {
+        ++site.suppressed;
+        suppressed.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    ++site.count;
+
+    uint32_t pos = tail.load(std::memory_order_relaxed);
+    Record* r;
+    for (;;) {
+        uint32_t i = pos & (kSlots - 1);
+        r = &ring[i];
+        int32_t diff = (int32_t)(r->seq.load(std::memory_order_acquire) + i - pos);
+        if (diff == 0) {
+            if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            dropped.fetch_add(1, std::memory_order_relaxed); // full: the drain is behind
+            return nullptr;
+        } else {
+            pos = tail.load(std::memory_order_relaxed);
+        }
+    }
+
+    uint32_t depth = pos + 1 - head;
+    if (depth <= kSlots && depth > highWater) highWater = (uint8_t)depth;
+
+    r->pos = pos;
+    r->ms = now;
+    r->fmt = fmt;
+    r->suppressed = site.suppressed;
+    site.suppressed = 0;
+    r->module = static_cast<uint8_t>(m);
+    r->level = static_cast<uint8_t>(l);
+    return r;
+}
+
+void DevDashLog::publish_(Record* r) {
+    r->seq.store(r->pos + 1 - (r->pos & (kSlots - 1)), std::memory_order_release);
+    written.fetch_add(1, std::memory_order_relaxed);
+}
+
+void DevDashLog::Packer::str(const char* s) {
+    if (!s) s = "(null)";
+    if (r.argc >= kMaxArgs || r.used + 1 >= kDataBytes) return;
+    size_t room = kDataBytes - r.used - 1; // after the length byte
+    size_t n = strnlen(s, room);
+    r.type[r.argc++] = Str;
+    r.data[r.used++] = (uint8_t)n;
+    memcpy(r.data + r.used, s, n);
+    r.used += n;
+}
+
+/* -------------------- Drain -------------------- */
+
+uint16_t DevDashLog::drainLocked_() {
+    char line[kLineBytes];
+    uint16_t n = 0;
+
+    uint32_t drops = dropped;
+    if (drops != reportedDrops) {
+        int len = snprintf(line, sizeof(line), "log: %lu records dropped (ring full)\n",
+                           (unsigned long)(drops - reportedDrops));
+        Serial.write((const uint8_t*)line, len);
+        reportedDrops = drops;
+    }
+
+    for (;;) {
+        uint32_t i = head & (kSlots - 1);
+        Record& r = ring[i];
+        if (r.seq.load(std::memory_order_acquire) + i != head + 1) break;
+        format_(r, line, sizeof(line));
+        // Formatted into `line`, so the slot can go back to the producers
+        r.seq.store(head + kSlots - i, std::memory_order_release);
+        ++head;
+        Serial.write((const uint8_t*)line, strlen(line));
+        ++n;
+    }
+    return n;
+}
+
+/** Appends printf output to out[n..len), keeping n within the buffer */
+template <typename T>
+static void emit(char* out, size_t len, size_t& n, const char* spec, T v) {
+    if (n + 1 >= len) return;
+    int w = snprintf(out + n, len - n, spec, v);
+    if (w > 0) n += ((size_t)w < len - n) ? (size_t)w : len - n - 1;
+}
+
+void DevDashLog::format_(const Record& r, char* out, size_t len) {
+    int w = snprintf(out, len, "%6lu.%03lu %c %-7s ", (unsigned long)(r.ms / 1000), (unsigned long)(r.ms % 1000),
+                     kLevelChars[r.level < 5 ? r.level : 0], moduleName(static_cast<Module>(r.module)));
+    size_t n = w <= 0 ? 0 : ((size_t)w < len ? (size_t)w : len - 1);
+
+    // Re-run the format one conversion at a time with the stored argument;
+    // length modifiers in the format are replaced by the stored type's own
+    const char* f = r.fmt ? r.fmt : "";
+    uint8_t arg = 0;
+    size_t off = 0;
+    while (*f && n + 1 < len) {
+        if (*f != '%') { out[n++] = *f++; continue; }
+        if (f[1] == '%') { out[n++] = '%'; f += 2; continue; }
+
+        char spec[20];
+        size_t k = 0;
+        spec[k++] = *f++;
+        while (*f && strchr("-+ #0123456789.", *f) && k < 12) spec[k++] = *f++;
+        while (*f && strchr("hljztL", *f)) ++f;
+        char conv = *f;
+        if (!conv) break;
+        ++f;
+        if (arg >= r.argc) { out[n++] = '?'; continue; }
+
+        switch (r.type[arg++]) {
+        case Int: case Uint: {
+            uint32_t v;
+            memcpy(&v, r.data + off, 4);
+            off += 4;
+            if (strchr("fFeEgG", conv)) {
+                spec[k++] = conv; spec[k] = 0;
+                emit(out, len, n, spec, r.type[arg - 1] == Int ? (double)(int32_t)v : (double)v);
+                break;
+            }
+            if (!strchr("diouxXc", conv)) conv = r.type[arg - 1] == Int ? 'd' : 'u';
+            spec[k++] = conv; spec[k] = 0;
+            emit(out, len, n, spec, (unsigned)v);
+            break;
+        }
+        case Int64: case Uint64: {
+            unsigned long long v;
+            memcpy(&v, r.data + off, 8);
+            off += 8;
+            if (!strchr("diouxX", conv)) conv = r.type[arg - 1] == Int64 ? 'd' : 'u';
+            spec[k++] = 'l'; spec[k++] = 'l'; spec[k++] = conv; spec[k] = 0;
+            emit(out, len, n, spec, v);
+            break;
+        }
+        case Double: {
+            double v;
+            memcpy(&v, r.data + off, 8);
+            off += 8;
+            if (!strchr("fFeEgGaA", conv)) conv = 'f';
+            spec[k++] = conv; spec[k] = 0;
+            emit(out, len, n, spec, v);
+            break;
+        }
+        case Str: {
+            uint8_t sl = r.data[off++];
+            char s[kDataBytes];
+            memcpy(s, r.data + off, sl);
+            s[sl] = 0;
+            off += sl;
+            spec[k++] = 's'; spec[k] = 0;
+            emit(out, len, n, spec, (const char*)s);
+            break;
+        }
+        case Ptr: {
+            const void* v;
+            memcpy(&v, r.data + off, sizeof(v));
+            off += sizeof(v);
+            emit(out, len, n, "%p", v);
+            break;
+        }
+        }
+    }
+
+    // One record, one line: whatever the format ended with
+    while (n && (out[n - 1] == '\n' || out[n - 1] == '\r' || out[n - 1] == ' ')) --n;
+    out[n] = 0;
+    if (r.suppressed) emit(out, len, n, " (+%u suppressed)", (unsigned)r.suppressed);
+    if (n + 1 >= len) n = len - 2;
+    out[n++] = '\n';
+    out[n] = 0;
+}
+
+void DevDashLog::taskMain_(void*) {
+    for (;;) {
+        uint16_t n = 0;
+        if (!draining.exchange(true)) {
+            n = drainLocked_();
+            draining = false;
+        }
+        if (!n) vTaskDelay(pdMS_TO_TICKS(kDrainIdleMs));
+    }
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include <string>
+
+/**
+ * Asynchronous logging.
+ *
+ * A log call copies the format pointer, its arguments (strings by value, as
+ * they may not outlive the call) and a timestamp into one slot of a
+ * lock-free ring and returns; formatting and the serial write happen in a
+ * low-priority task. Each module has its own level, checked before anything
+ * else, and each call site may emit at most rateLimit() records per second;
+ * the rest are counted and reported with that site's next record. When the
+ * ring is full records are dropped and counted, never waited for.
+ *
+ *   DD_LOGI(Wifi, "Scan: %u networks in %lu ms", n, (unsigned long)ms);
+ *
+ * The format must be a string literal (only its pointer is stored).
+ */
+class DevDashLog {
+public:
+    enum class Level : uint8_t { Off, Error, Warn, Info, Debug };
+    enum class Module : uint8_t { Core, Boot, Lvgl, Ui, Wifi, Storage, Work, Sensors, Count };
+
+    static constexpr uint8_t  kSlots       = 64;   // power of two
+    static constexpr uint8_t  kMaxArgs     = 8;
+    static constexpr uint8_t  kDataBytes   = 96;   // packed arguments per record
+    static constexpr uint16_t kDefaultRate = 20;   // records per second per call site
+
+    /** Per call site rate-limit state; one static instance per DD_LOG* use */
+    struct Site {
+        uint32_t windowMs;
+        uint16_t count;
+        uint16_t suppressed;
+    };
+
+    struct Stats {
+        uint32_t written;     // records queued
+        uint32_t dropped;     // ring full
+        uint32_t suppressed;  // over a site's rate limit
+        uint8_t  highWater;   // most slots in use at once
+    };
+
+    static bool enabled(Module m, Level l) {
+        return static_cast<uint8_t>(l) <= levels[static_cast<uint8_t>(m)];
+    }
+    static void setLevel(Module m, Level l) { levels[static_cast<uint8_t>(m)] = static_cast<uint8_t>(l); }
+    static void setLevel(Level l);  // every module
+    static Level level(Module m) { return static_cast<Level>(levels[static_cast<uint8_t>(m)]); }
+
+    static void setRateLimit(uint16_t perSecond) { rateLimit = perSecond; }
+
+    template <typename... Args>
+    static void write(Site& site, Module m, Level l, const char* fmt, const Args&... args) {
+        Record* r = claim_(site, m, l, fmt);
+        if (!r) return;
+        Packer p(*r);
+        pack_(p, args...);
+        publish_(r);
+    }
+
+    /** Start the drain task; the first log call does this too */
+    static void begin();
+    /** Format and write everything queued from the calling task, e.g. before a restart */
+    static void flush();
+
+    static Stats stats();
+    static const char* moduleName(Module m);
+
+private:
+    DevDashLog() = delete;
+
+    enum ArgType : uint8_t { Int, Uint, Int64, Uint64, Double, Str, Ptr };
+
+    struct Record {
+        std::atomic<uint32_t> seq; // minus the slot index; see DevDashLog.cpp
+        uint32_t    pos;
+        uint32_t    ms;
+        const char* fmt;
+        uint16_t    suppressed;  // by this site since its previous record
+        uint8_t     module;
+        uint8_t     level;
+        uint8_t     argc;
+        uint8_t     used;
+        uint8_t     type[kMaxArgs];
+        uint8_t     data[kDataBytes];
+    };
+
+    struct Packer {
+        Record& r;
+        explicit Packer(Record& rec) : r(rec) { r.argc = 0; r.used = 0; }
+        void raw(ArgType t, const void* v, uint8_t n) {
+            if (r.argc >= kMaxArgs || r.used + n > kDataBytes) return;
+            r.type[r.argc++] = t;
+            memcpy(r.data + r.used, v, n);
+            r.used += n;
+        }
+        void str(const char* s);
+    };
+
+    static uint8_t  levels[static_cast<uint8_t>(Module::Count)];
+    static uint16_t rateLimit;
+    static Record   ring[kSlots];
+
+    static Record* claim_(Site& site, Module m, Level l, const char* fmt);
+    static void publish_(Record* r);
+
+    static void pack_(Packer&) {}
+    template <typename T, typename... Rest>
+    static void pack_(Packer& p, const T& v, const Rest&... rest) {
+        put_(p, v);
+        pack_(p, rest...);
+    }
+
+    static void put_(Packer& p, bool v)               { int32_t x = v; p.raw(Int, &x, 4); }
+    static void put_(Packer& p, char v)               { int32_t x = v; p.raw(Int, &x, 4); }
+    static void put_(Packer& p, signed char v)        { int32_t x = v; p.raw(Int, &x, 4); }
+    static void put_(Packer& p, short v)              { int32_t x = v; p.raw(Int, &x, 4); }
+    static void put_(Packer& p, int v)                { int32_t x = v; p.raw(Int, &x, 4); }
+    static void put_(Packer& p, long v)               { int32_t x = v; p.raw(Int, &x, 4); }
+    static void put_(Packer& p, unsigned char v)      { uint32_t x = v; p.raw(Uint, &x, 4); }
+    static void put_(Packer& p, unsigned short v)     { uint32_t x = v; p.raw(Uint, &x, 4); }
+    static void put_(Packer& p, unsigned int v)       { uint32_t x = v; p.raw(Uint, &x, 4); }
+    static void put_(Packer& p, unsigned long v)      { uint32_t x = v; p.raw(Uint, &x, 4); }
+    static void put_(Packer& p, long long v)          { p.raw(Int64, &v, 8); }
+    static void put_(Packer& p, unsigned long long v) { p.raw(Uint64, &v, 8); }
+    static void put_(Packer& p, float v)              { double x = v; p.raw(Double, &x, 8); }
+    static void put_(Packer& p, double v)             { p.raw(Double, &v, 8); }
+    static void put_(Packer& p, const char* v)        { p.str(v); }
+    static void put_(Packer& p, const String& v)      { p.str(v.c_str()); }
+    static void put_(Packer& p, const std::string& v) { p.str(v.c_str()); }
+    static void put_(Packer& p, const void* v)        { p.raw(Ptr, &v, sizeof(v)); }
+
+    static uint16_t drainLocked_();
+    static void format_(const Record& r, char* out, size_t len);
+    static void taskMain_(void* arg);
+};
+
+#define DD_LOG_(mod, lvl, fmt, ...)                                                          \
+    do {                                                                                     \
+        if (DevDashLog::enabled(DevDashLog::Module::mod, DevDashLog::Level::lvl)) {          \
+            static DevDashLog::Site dd_log_site_;                                            \
+            DevDashLog::write(dd_log_site_, DevDashLog::Module::mod, DevDashLog::Level::lvl, \
+                              fmt, ##__VA_ARGS__);                                           \
+        }                                                                                    \
+    } while (0)
+
+#define DD_LOGE(mod, fmt, ...) DD_LOG_(mod, Error, fmt, ##__VA_ARGS__)
+#define DD_LOGW(mod, fmt, ...) DD_LOG_(mod, Warn, fmt, ##__VA_ARGS__)
+#define DD_LOGI(mod, fmt, ...) DD_LOG_(mod, Info, fmt, ##__VA_ARGS__)
+#define DD_LOGD(mod, fmt, ...) DD_LOG_(mod, Debug, fmt, ##__VA_ARGS__)
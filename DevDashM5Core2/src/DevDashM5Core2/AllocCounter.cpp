@@ -0,0 +1,50 @@
+#include "AllocCounter.h"
+
+constexpr uint8_t AllocCounter::kMaxProbes;
+
+#if DEVDASH_HEAP_TRACKING
+static portMUX_TYPE probeLock = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t volatile probeTask[AllocCounter::kMaxProbes];
+static volatile uint32_t probeCount[AllocCounter::kMaxProbes];
+static volatile uint8_t probesAlive = 0;
+
+void AllocCounter::onAlloc_() {
+    // Called on every allocation, so it does nothing until a probe exists
+    if (!probesAlive) return;
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    for (uint8_t i = 0; i < kMaxProbes; ++i) {
+        if (probeTask[i] == self) ++probeCount[i];
+    }
+}
+
+AllocCounter::Probe::Probe() {
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    portENTER_CRITICAL(&probeLock);
+    for (uint8_t i = 0; i < kMaxProbes; ++i) {
+        if (probeTask[i]) continue;
+        probeCount[i] = 0;
+        probeTask[i] = self;
+        ++probesAlive;
+        _slot = (int8_t)i;
+        break;
+    }
+    portEXIT_CRITICAL(&probeLock);
+}
+
+AllocCounter::Probe::~Probe() {
+    if (_slot < 0) return;
+    portENTER_CRITICAL(&probeLock);
+    probeTask[_slot] = nullptr;
+    --probesAlive;
+    portEXIT_CRITICAL(&probeLock);
+}
+
+uint32_t AllocCounter::Probe::count() const {
+    return _slot >= 0 ? probeCount[_slot] : 0;
+}
+#else
+void AllocCounter::onAlloc_() {}
+AllocCounter::Probe::Probe() {}
+AllocCounter::Probe::~Probe() {}
+uint32_t AllocCounter::Probe::count() const { return 0; }
+#endif
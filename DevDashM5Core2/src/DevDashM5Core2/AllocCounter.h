@@ -0,0 +1,42 @@
+#pragma once
+
+#include <Arduino.h>
+#include "../DevDashConfig.h"
+
+/**
+ * Counts the heap allocations (malloc, calloc, realloc, and so new) the
+ * calling task makes while a Probe is alive; allocations by other tasks,
+ * e.g. the Wi-Fi driver's, are not counted.
+ *
+ * Shares HeapTracker's allocator hooks, so counting needs
+ * DEVDASH_HEAP_TRACKING and the link flags listed in HeapTracker.h.
+ * Without them available() is false and every probe counts 0.
+ */
+class AllocCounter {
+public:
+    static constexpr uint8_t kMaxProbes = 4; // alive at once, across all tasks
+
+    static bool available() { return DEVDASH_HEAP_TRACKING != 0; }
+
+    class Probe {
+    public:
+        Probe();
+        ~Probe();
+        Probe(const Probe&) = delete;
+        Probe& operator=(const Probe&) = delete;
+
+        /** Allocations by this task since construction */
+        uint32_t count() const;
+        /** False if all kMaxProbes slots were taken (count() is then 0) */
+        bool counting() const { return _slot >= 0; }
+
+    private:
+        int8_t _slot = -1;
+    };
+
+    /** Called by the allocator hooks (HeapTracker.cpp); nothing else should */
+    static void onAlloc_();
+
+private:
+    AllocCounter() = delete;
+};
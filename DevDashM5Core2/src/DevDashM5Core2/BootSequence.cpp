@@ -0,0 +1,124 @@
+#include "BootSequence.h"
+#include "../DevDashLog.h"
+
+constexpr uint8_t  BootSequence::kMaxStages;
+constexpr uint32_t BootSequence::kWorkerStack;
+
+// Arduino's loop() (and so LVGL) runs on ARDUINO_RUNNING_CORE
+#if CONFIG_FREERTOS_UNICORE
+static const BaseType_t kWorkerCore = 0;
+#else
+static const BaseType_t kWorkerCore = ARDUINO_RUNNING_CORE == 0 ? 1 : 0;
+#endif
+
+uint8_t BootSequence::add(const char* name, Core core, StageFn fn, uint32_t after) {
+    if (_count >= kMaxStages) return _count - 1;
+#if CONFIG_FREERTOS_UNICORE
+    core = Core::Ui; // nowhere to overlap
+#endif
+    Stage& s = _stages[_count];
+    s.name = name;
+    s.core = core;
+    s.fn = fn;
+    s.after = after;
+    s.state = Pending;
+    s.ranOn = 0;
+    s.startUs = s.endUs = s.busyUs = 0;
+    return _count++;
+}
+
+BootSequence::Status BootSequence::step(bool warm) {
+    if (_failed) return Status::Failed;
+    if (done()) return Status::Done;
+    if (!_startUs) _startUs = micros();
+    _warm = warm;
+
+    if (!_workerBusy && nextReady_(Core::Worker) >= 0) startWorker_();
+
+    int id = nextReady_(Core::Ui);
+    if (id < 0) return Status::Waiting;
+    if (runSlice_((uint8_t)id, warm) == Result::Failed) return Status::Failed;
+    return done() ? Status::Done : Status::Working;
+}
+
+void BootSequence::reset() {
+    while (_workerBusy) delay(1);
+    for (uint8_t i = 0; i < _count; ++i) {
+        Stage& s = _stages[i];
+        s.state = Pending;
+        s.startUs = s.endUs = s.busyUs = 0;
+    }
+    _done = 0;
+    _failed = false;
+    _startUs = 0;
+}
+
+void BootSequence::printTimeline(const char* label) const {
+    DD_LOGI(Boot, "Boot timeline (%s):", label);
+    for (uint8_t i = 0; i < _count; ++i) {
+        const Stage& s = _stages[i];
+        DD_LOGI(Boot, "  %-12s core %u %8.1f -> %8.1f ms  busy %7.1f ms", s.name, s.ranOn,
+                s.startUs / 1000.0f, s.endUs / 1000.0f, s.busyUs / 1000.0f);
+    }
+}
+
+/* -------------------- Internals -------------------- */
+
+int BootSequence::nextReady_(Core core) const {
+    uint32_t done = _done;
+    for (uint8_t i = 0; i < _count; ++i) {
+        const Stage& s = _stages[i];
+        if (s.core != core) continue;
+        uint8_t state = s.state;
+        if (state == Running && core == Core::Ui) return i; // sliced; keep going
+        if (state == Pending && (s.after & done) == s.after) return i;
+    }
+    return -1;
+}
+
+BootSequence::Result BootSequence::runSlice_(uint8_t id, bool warm) {
+    Stage& s = _stages[id];
+    uint32_t start = micros();
+    if (s.state == Pending) {
+        s.state = Running;
+        s.startUs = start - _startUs;
+        s.ranOn = (uint8_t)xPortGetCoreID();
+    }
+    Result r = s.fn(_user, id, warm);
+    uint32_t end = micros();
+    s.busyUs += end - start;
+    if (r == Result::Again) return r;
+
+    s.endUs = end - _startUs;
+    if (r == Result::Failed) {
+        DD_LOGE(Boot, "Boot: %s failed", s.name);
+        s.state = Broken;
+        _failed = true;
+    } else {
+        s.state = Finished;
+        _done |= bit(id);
+    }
+    return r;
+}
+
+void BootSequence::startWorker_() {
+    _workerBusy = true;
+    if (xTaskCreatePinnedToCore(workerTask_, "devdash-boot", kWorkerStack, this, 1, nullptr, kWorkerCore) != pdPASS) {
+        // No room for a task: run the worker stages here instead
+        DD_LOGW(Boot, "Boot: worker task failed, running inline");
+        runWorker_();
+    }
+}
+
+void BootSequence::runWorker_() {
+    int id;
+    while (!_failed && (id = nextReady_(Core::Worker)) >= 0) {
+        while (runSlice_((uint8_t)id, _warm) == Result::Again) vTaskDelay(1);
+    }
+    _workerBusy = false;
+}
+
+void BootSequence::workerTask_(void* arg) {
+    static_cast<BootSequence*>(arg)->runWorker_();
+    vTaskDelete(nullptr);
+}
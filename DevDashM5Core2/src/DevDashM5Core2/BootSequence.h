@@ -0,0 +1,86 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+/**
+ * Start-up expressed as stages with dependencies.
+ *
+ * Each stage names the stages it must wait for and the core it runs on.
+ * UI stages run on the caller's core, one slice per step(), in the order
+ * they were added once their dependencies are done. Worker stages (storage,
+ * parsing, radio set-up: nothing that touches LVGL) run on a short-lived
+ * task on the other core as soon as theirs are, so they overlap with the UI
+ * work. Every stage's start, end and busy time is recorded for
+ * printTimeline().
+ */
+class BootSequence {
+public:
+    enum class Core : uint8_t { Ui, Worker };
+    /** What one slice of a stage reports */
+    enum class Result : uint8_t { Done, Again, Failed };
+    /** What step() reports */
+    enum class Status : uint8_t { Working, Waiting, Done, Failed };
+
+    typedef Result (*StageFn)(void* user, uint8_t id, bool warm);
+
+    static constexpr uint8_t  kMaxStages   = 16;
+    static constexpr uint32_t kWorkerStack = 8192;
+
+    explicit BootSequence(void* user) : _user(user) {}
+    ~BootSequence() { reset(); }
+
+    /** Add a stage that waits for every stage whose bit is set in `after`; returns its id */
+    uint8_t add(const char* name, Core core, StageFn fn, uint32_t after = 0);
+    static uint32_t bit(uint8_t id) { return 1u << id; }
+
+    /**
+     * Hand ready worker stages to the other core, then run one slice of the
+     * first ready UI stage. Waiting means only the worker has work left.
+     */
+    Status step(bool warm);
+
+    bool started() const { return _startUs != 0; }
+    bool finished(uint8_t id) const { return _done.load() & bit(id); }
+    bool done() const { return _done.load() == allBits_(); }
+
+    /** Back to the first stage; waits for a running worker to finish first */
+    void reset();
+
+    /** Microseconds since the first step() */
+    uint32_t elapsedUs() const { return started() ? micros() - _startUs : 0; }
+
+    /** One line per stage: core, start and end relative to the first step(), busy time */
+    void printTimeline(const char* label) const;
+
+private:
+    enum State : uint8_t { Pending, Running, Finished, Broken };
+
+    struct Stage {
+        const char* name;
+        Core        core;
+        StageFn     fn;
+        uint32_t    after;
+        std::atomic<uint8_t> state;
+        uint8_t     ranOn;    // core id
+        uint32_t    startUs;  // relative to _startUs
+        uint32_t    endUs;
+        uint32_t    busyUs;   // time inside fn; less than end - start when sliced
+    };
+
+    void*    _user;
+    Stage    _stages[kMaxStages];
+    uint8_t  _count = 0;
+    uint32_t _startUs = 0;
+    std::atomic<uint32_t> _done{0};
+    std::atomic<bool>     _failed{false};
+    std::atomic<bool>     _workerBusy{false};
+    bool     _warm = false;
+
+    uint32_t allBits_() const { return _count >= 32 ? 0xFFFFFFFFu : (1u << _count) - 1; }
+    int  nextReady_(Core core) const;
+    Result runSlice_(uint8_t id, bool warm);
+    void startWorker_();
+    void runWorker_();
+    static void workerTask_(void* arg);
+};
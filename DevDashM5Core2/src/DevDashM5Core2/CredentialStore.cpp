@@ -0,0 +1,309 @@
+#include "CredentialStore.h"
+#include "HeapTracker.h"
+#include <ArduinoJson.h>
+#include <stddef.h>
+#include <string.h>
+#include <vector>
+#include "../DevDashLog.h"
+
+constexpr size_t  CredentialStore::kMaxSsidLen;
+constexpr size_t  CredentialStore::kMaxKeyLen;
+constexpr size_t  CredentialStore::kMaxEntries;
+constexpr uint8_t CredentialStore::kMagic;
+constexpr size_t  CredentialStore::kCompactSlack;
+constexpr size_t  CredentialStore::kMaxRecordLen;
+constexpr size_t  CredentialStore::kIndexSlots;
+
+CredentialStore::CredentialStore(fs::FS& fs, const char* path)
+  : _fs(fs), _path(path), _tmpPath(String(path) + ".tmp") {
+    rebuildIndex_();
+}
+
+bool CredentialStore::load() {
+    HeapTracker::Scope heap(HeapTracker::Tag::Storage);
+    _count = 0;
+    rebuildIndex_();
+    _logRecords = 0;
+    _seq = 0;
+
+    // A compaction that died between remove() and rename() leaves only the
+    // temp file behind; it was fully written before the remove, so adopt it.
+    if (!_fs.exists(_path) && _fs.exists(_tmpPath)) {
+        _fs.rename(_tmpPath, _path);
+    } else if (_fs.exists(_tmpPath)) {
+        _fs.remove(_tmpPath);
+    }
+
+    File f = _fs.open(_path, FILE_READ);
+    if (!f) { _logRecords = 1; return false; }
+
+    struct Pending { RecordType type; uint8_t ssidLen; uint8_t keyLen; char data[kMaxSsidLen + kMaxKeyLen]; };
+    std::vector<Pending> pending;
+    uint8_t buf[kMaxRecordLen];
+    bool cleanTail = true;
+
+    for (;;) {
+        size_t got = f.read(buf, sizeof(RecordHeader));
+        if (got == 0) break;
+        if (got != sizeof(RecordHeader)) { cleanTail = false; break; }
+
+        RecordHeader h;
+        memcpy(&h, buf, sizeof(h));
+        if (h.magic != kMagic || h.ssidLen > kMaxSsidLen || h.keyLen > kMaxKeyLen) { cleanTail = false; break; }
+
+        size_t payload = h.ssidLen + h.keyLen;
+        if (payload && f.read(buf + sizeof(h), payload) != payload) { cleanTail = false; break; }
+
+        uint32_t crc = crc32_(0, buf, offsetof(RecordHeader, crc));
+        crc = crc32_(crc, buf + sizeof(h), payload);
+        if (crc != h.crc) { cleanTail = false; break; }
+
+        _seq = h.seq + 1;
+        ++_logRecords;
+        switch (static_cast<RecordType>(h.type)) {
+            case RecordType::Put:
+            case RecordType::Erase: {
+                Pending p;
+                p.type = static_cast<RecordType>(h.type);
+                p.ssidLen = h.ssidLen;
+                p.keyLen = h.keyLen;
+                memcpy(p.data, buf + sizeof(h), payload);
+                pending.push_back(p);
+                break;
+            }
+            case RecordType::Commit:
+                for (const auto& p : pending) {
+                    if (p.type == RecordType::Put) applyPut_(p.data, p.ssidLen, p.data + p.ssidLen, p.keyLen);
+                    else applyErase_(p.data, p.ssidLen);
+                }
+                pending.clear();
+                break;
+            default:
+                cleanTail = false;
+                break;
+        }
+        if (!cleanTail) break;
+    }
+    f.close();
+    if (_logRecords == 0) _logRecords = 1;
+
+    // Replay stops at the first torn record, so anything appended after it
+    // would be unreachable. Rewrite the log before accepting new records.
+    if (!cleanTail || !pending.empty()) {
+        DD_LOGW(Storage, "CredentialStore: discarding uncommitted tail");
+        compact();
+    } else {
+        maybeCompact_();
+    }
+    return true;
+}
+
+bool CredentialStore::migrateFromJson(const char* jsonPath) {
+    if (!_fs.exists(jsonPath)) return false;
+    File file = _fs.open(jsonPath, FILE_READ);
+    if (!file) return false;
+
+    JsonDocument doc;
+    DeserializationError error = deserializeJson(doc, file);
+    file.close();
+    if (error) {
+        DD_LOGE(Storage, "CredentialStore: failed to parse legacy JSON: %s", error.c_str());
+        return false;
+    }
+
+    for (JsonObject network : doc["networks"].as<JsonArray>()) {
+        const char* ssid = network["ssid"] | "";
+        const char* key  = network["password"] | "";
+        size_t ssidLen = strnlen(ssid, kMaxSsidLen + 1);
+        size_t keyLen  = strnlen(key, kMaxKeyLen + 1);
+        if (!ssidLen || ssidLen > kMaxSsidLen || keyLen > kMaxKeyLen) continue;
+        applyPut_(ssid, ssidLen, key, keyLen);
+    }
+
+    // Only drop the legacy file once the imported set is durable
+    if (!compact()) return false;
+    _fs.remove(jsonPath);
+    DD_LOGI(Storage, "CredentialStore: migrated %u networks from %s", (unsigned)_count, jsonPath);
+    return true;
+}
+
+bool CredentialStore::put(const char* ssid, const char* key) {
+    if (!ssid) return false;
+    if (!key) key = "";
+    size_t ssidLen = strnlen(ssid, kMaxSsidLen + 1);
+    size_t keyLen  = strnlen(key, kMaxKeyLen + 1);
+    if (!ssidLen || ssidLen > kMaxSsidLen || keyLen > kMaxKeyLen) return false;
+
+    int idx = indexOf_(ssid, ssidLen);
+    if (idx >= 0 && _entries[idx].password == key) return true;
+    if (idx < 0 && _count == kMaxEntries) return false;
+
+    if (!appendCommitted_(RecordType::Put, ssid, key)) return false;
+    applyPut_(ssid, ssidLen, key, keyLen);
+    maybeCompact_();
+    return true;
+}
+
+bool CredentialStore::erase(const char* ssid) {
+    if (!ssid) return false;
+    size_t ssidLen = strnlen(ssid, kMaxSsidLen + 1);
+    if (indexOf_(ssid, ssidLen) < 0) return true;
+
+    if (!appendCommitted_(RecordType::Erase, ssid, "")) return false;
+    applyErase_(ssid, ssidLen);
+    maybeCompact_();
+    return true;
+}
+
+const SavedWiFiNetwork* CredentialStore::find(const char* ssid) const {
+    if (!ssid) return nullptr;
+    int idx = indexOf_(ssid, strnlen(ssid, kMaxSsidLen + 1));
+    return idx >= 0 ? &_entries[idx] : nullptr;
+}
+
+bool CredentialStore::compact() {
+    HeapTracker::Scope heap(HeapTracker::Tag::Storage);
+    File f = _fs.open(_tmpPath, FILE_WRITE);
+    if (!f) return false;
+    bool ok = writeAll_(f);
+    f.close();
+    if (!ok) { _fs.remove(_tmpPath); return false; }
+
+    // SPIFFS rename does not replace, so the old log has to go first; load()
+    // covers a crash in between.
+    _fs.remove(_path);
+    if (!_fs.rename(_tmpPath, _path)) return false;
+    _logRecords = _count + 1;
+    return true;
+}
+
+void CredentialStore::clear() {
+    _count = 0;
+    rebuildIndex_();
+    _logRecords = 1;
+    _fs.remove(_path);
+    _fs.remove(_tmpPath);
+}
+
+/* -------------------- Internals -------------------- */
+
+bool CredentialStore::appendCommitted_(RecordType type, const char* ssid, const char* key) {
+    HeapTracker::Scope heap(HeapTracker::Tag::Storage);
+    uint8_t buf[kMaxRecordLen + sizeof(RecordHeader)];
+    size_t n = encode_(buf, _seq++, type, ssid, strlen(ssid), key, strlen(key));
+    n += encode_(buf + n, _seq++, RecordType::Commit, "", 0, "", 0);
+
+    File f = _fs.open(_path, FILE_APPEND);
+    if (!f) return false;
+    bool ok = f.write(buf, n) == n;
+    f.flush();
+    f.close();
+    if (ok) _logRecords += 2;
+    return ok;
+}
+
+bool CredentialStore::writeAll_(File& f) {
+    uint8_t buf[kMaxRecordLen];
+    for (const auto& e : entries()) {
+        size_t n = encode_(buf, _seq++, RecordType::Put,
+                           e.ssid.c_str(), e.ssid.length(), e.password.c_str(), e.password.length());
+        if (f.write(buf, n) != n) return false;
+    }
+    size_t n = encode_(buf, _seq++, RecordType::Commit, "", 0, "", 0);
+    if (f.write(buf, n) != n) return false;
+    f.flush();
+    return true;
+}
+
+void CredentialStore::maybeCompact_() {
+    // Fresh inserts leave one commit record each behind, so only rewrite once
+    // updates and erases have made the log clearly larger than that.
+    if (deadRecords() > _count + kCompactSlack) compact();
+}
+
+size_t CredentialStore::encode_(uint8_t* out, uint32_t seq, RecordType type,
+                                const char* ssid, size_t ssidLen, const char* key, size_t keyLen) {
+    static_assert(sizeof(RecordHeader) == 12, "record header must stay packed");
+    RecordHeader h;
+    h.magic   = kMagic;
+    h.type    = static_cast<uint8_t>(type);
+    h.ssidLen = static_cast<uint8_t>(ssidLen);
+    h.keyLen  = static_cast<uint8_t>(keyLen);
+    h.seq     = seq;
+    h.crc     = 0;
+    memcpy(out, &h, sizeof(h));
+    memcpy(out + sizeof(h), ssid, ssidLen);
+    memcpy(out + sizeof(h) + ssidLen, key, keyLen);
+
+    h.crc = crc32_(0, out, offsetof(RecordHeader, crc));
+    h.crc = crc32_(h.crc, out + sizeof(h), ssidLen + keyLen);
+    memcpy(out + offsetof(RecordHeader, crc), &h.crc, sizeof(h.crc));
+    return sizeof(h) + ssidLen + keyLen;
+}
+
+bool CredentialStore::applyPut_(const char* ssid, size_t ssidLen, const char* key, size_t keyLen) {
+    int idx = indexOf_(ssid, ssidLen);
+    if (idx >= 0) { _entries[idx].password.assign(key, keyLen); return true; }
+    if (_count == kMaxEntries) return false;
+
+    SavedWiFiNetwork& e = _entries[_count];
+    e.ssid.assign(ssid, ssidLen);
+    e.password.assign(key, keyLen);
+    insertIndex_(_count++);
+    return true;
+}
+
+void CredentialStore::applyErase_(const char* ssid, size_t ssidLen) {
+    int idx = indexOf_(ssid, ssidLen);
+    if (idx < 0) return;
+    // Keep insertion order; erases are rare enough that a reindex is fine
+    for (size_t i = idx + 1; i < _count; ++i) _entries[i - 1] = _entries[i];
+    --_count;
+    _entries[_count].password.clear();
+    rebuildIndex_();
+}
+
+int CredentialStore::indexOf_(const char* ssid, size_t len) const {
+    const size_t mask = kIndexSlots - 1;
+    for (size_t i = hash_(ssid, len) & mask;; i = (i + 1) & mask) {
+        int8_t e = _slots[i];
+        if (e < 0) return -1;
+        if (_entries[e].ssid.equals(ssid, len)) return e;
+    }
+}
+
+void CredentialStore::insertIndex_(size_t entry) {
+    const SsidString& s = _entries[entry].ssid;
+    const size_t mask = kIndexSlots - 1;
+    size_t i = hash_(s.c_str(), s.length()) & mask;
+    while (_slots[i] >= 0) i = (i + 1) & mask;
+    _slots[i] = static_cast<int8_t>(entry);
+}
+
+void CredentialStore::rebuildIndex_() {
+    static_assert(kIndexSlots >= 2 * kMaxEntries && (kIndexSlots & (kIndexSlots - 1)) == 0,
+                  "index must stay at most half full");
+    memset(_slots, -1, sizeof(_slots));
+    for (size_t i = 0; i < _count; ++i) insertIndex_(i);
+}
+
+uint32_t CredentialStore::hash_(const char* s, size_t len) {
+    // FNV-1a
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; ++i) { h ^= (uint8_t)s[i]; h *= 16777619u; }
+    return h;
+}
+
+uint32_t CredentialStore::crc32_(uint32_t crc, const uint8_t* data, size_t len) {
+    // Nibble-table CRC-32 (IEEE): small enough to keep in flash, fast enough for ~100 byte records
+    static const uint32_t kTable[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+    };
+    crc = ~crc;
+    for (size_t i = 0; i < len; ++i) {
+        crc = kTable[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
+        crc = kTable[(crc ^ (data[i] >> 4)) & 0x0F] ^ (crc >> 4);
+    }
+    return ~crc;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+#include "FixedString.h"
+#include "Span.h"
+
+typedef FixedString<32> SsidString; // 802.11 limit
+typedef FixedString<64> KeyString;  // WPA2 passphrase or 64 hex digits
+
+struct SavedWiFiNetwork {
+    SsidString ssid;
+    KeyString  password;
+};
+
+/**
+ * Append-only binary store for saved WiFi credentials.
+ *
+ * Every change is appended as a CRC-checked record and only becomes visible
+ * once the commit record that follows it has been written, so a power cut in
+ * the middle of a write loses at most the change in flight. Superseded
+ * records are dropped by compaction, which rewrites the live set into a
+ * temporary file and renames it over the log.
+ *
+ * Entries and their index live in fixed arrays inside the store, so lookups
+ * and updates never allocate; put() of a new SSID fails once kMaxEntries
+ * are saved.
+ */
+class CredentialStore {
+public:
+    static constexpr size_t kMaxSsidLen = SsidString::kCapacity;
+    static constexpr size_t kMaxKeyLen  = KeyString::kCapacity;
+    static constexpr size_t kMaxEntries = 32;
+
+    explicit CredentialStore(fs::FS& fs, const char* path = "/wifi.db");
+
+    /** Replay the log into memory, recovering from an interrupted compaction */
+    bool load();
+
+    /** Import a legacy {"networks":[{ssid,password}]} file and delete it */
+    bool migrateFromJson(const char* jsonPath);
+
+    /** Insert or update an entry; a no-op when the stored key already matches. False when full */
+    bool put(const char* ssid, const char* key);
+
+    /** Remove an entry */
+    bool erase(const char* ssid);
+
+    /** Look up an entry by SSID (nullptr if absent) */
+    const SavedWiFiNetwork* find(const char* ssid) const;
+
+    /** Rewrite the log with only the live entries */
+    bool compact();
+
+    /** Drop all entries and delete the log */
+    void clear();
+
+    /** In insertion order; valid until the next change */
+    Span<const SavedWiFiNetwork> entries() const { return Span<const SavedWiFiNetwork>(_entries, _count); }
+    size_t size() const { return _count; }
+    /** Records in the log that compaction would drop */
+    size_t deadRecords() const { return _logRecords > _count + 1 ? _logRecords - (_count + 1) : 0; }
+
+private:
+    enum class RecordType : uint8_t { Put = 1, Erase = 2, Commit = 3 };
+
+    struct RecordHeader {
+        uint8_t  magic;
+        uint8_t  type;
+        uint8_t  ssidLen;
+        uint8_t  keyLen;
+        uint32_t seq;
+        uint32_t crc;
+    };
+
+    static constexpr uint8_t kMagic = 0xD5;
+    static constexpr size_t  kCompactSlack = 16;
+    static constexpr size_t  kMaxRecordLen = sizeof(RecordHeader) + kMaxSsidLen + kMaxKeyLen;
+    static constexpr size_t  kIndexSlots = 64; // power of two, at least twice kMaxEntries
+
+    fs::FS&     _fs;
+    const char* _path;
+    String      _tmpPath;
+    uint32_t    _seq = 0;
+    size_t      _logRecords = 1;
+
+    SavedWiFiNetwork _entries[kMaxEntries];
+    uint8_t          _count = 0;
+    int8_t           _slots[kIndexSlots]; // open-addressed index into _entries, -1 = empty
+
+    int  indexOf_(const char* ssid, size_t len) const;
+    void rebuildIndex_();
+    void insertIndex_(size_t entry);
+    bool applyPut_(const char* ssid, size_t ssidLen, const char* key, size_t keyLen);
+    void applyErase_(const char* ssid, size_t ssidLen);
+    bool appendCommitted_(RecordType type, const char* ssid, const char* key);
+    bool writeAll_(File& f);
+    void maybeCompact_();
+
+    static size_t encode_(uint8_t* out, uint32_t seq, RecordType type,
+                          const char* ssid, size_t ssidLen, const char* key, size_t keyLen);
+    static uint32_t hash_(const char* s, size_t len);
+    static uint32_t crc32_(uint32_t crc, const uint8_t* data, size_t len);
+};
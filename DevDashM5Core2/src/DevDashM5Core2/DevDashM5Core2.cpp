@@ -7,87 +7,374 @@
 #include "WifiManager.h"
 #include "LVGLRenderer.h"
 #include "ThemeManager.h"
+#include "HeapTracker.h"
+#include "../DevDashLog.h"
+#include "../DevDashConsole.h"
+#if DEVDASH_ENABLE_SENSORS
 #include "SensorDashboard.h"
+#include "NumericReadout.h"
+#endif
+#include <esp_heap_caps.h>
+#include <new>
 
 /* -------------------- Setup and Loop -------------------- */
 
 ThemeManager* DevDashM5Core2::theme    = new ThemeManager();
 LVGLRenderer* DevDashM5Core2::renderer = new LVGLRenderer();
 WifiManager*  DevDashM5Core2::manager  = new WifiManager();
+#if DEVDASH_ENABLE_SENSORS
 SensorDashboard* DevDashM5Core2::sensorDashboard = new SensorDashboard();
+#endif
 
-bool DevDashM5Core2::begin() {
-    // assume M5.begin() has been called in setup
+constexpr const char* DevDashM5Core2::kName;
 
-    if (!renderer->begin()) {
-        Serial.println("LVGLRenderer init failed");
-        return false;
-    }
+#if DEVDASH_ENABLE_WIFI_UI
+/** Bytes currently allocated from the LVGL heap */
+static size_t lvglUsedBytes() {
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+}
 
-    if (!theme->begin()) {
-        Serial.println("ThemeManager init failed");
-        return false;
-    }
-    theme->apply(theme->current());
+/** Heap a lazily built modal took, and what a style lookup costs in it with DEVDASH_STYLE_TIMING */
+static void logModalBuild(const char* name, lv_obj_t* modal, size_t memBefore) {
+    size_t bytes = lvglUsedBytes() - memBefore;
+#if DEVDASH_STYLE_TIMING
+    ThemeManager::LookupStats lookups = ThemeManager::timeLookups(modal);
+    DD_LOGI(Ui, "UI: %s modal %u B LVGL heap; %lu objects, %lu ns per style lookup", name, (unsigned)bytes,
+            (unsigned long)lookups.objects, (unsigned long)lookups.nsPerLookup());
+#else
+    (void)modal;
+    DD_LOGI(Ui, "UI: %s modal %u B LVGL heap", name, (unsigned)bytes);
+#endif
+}
+#endif
+
+struct DevDashM5Core2::ParkedState {
+    ThemeManager::Mode theme;
+    int8_t  screen;
+    uint8_t networks;
+    WiFiNetwork network[WifiManager::kMaxScanResults];
+};
+
+static const char* const kStageNames[] = {
+    "renderer", "theme", "storage", "credentials", "screens", "prebuild", "sensors", "radio", "scan"
+};
+
+typedef HeapTracker::Tag HeapTag;
+/** What each stage's allocations count against, by Stage */
+static const HeapTag kStageTags[] = {
+    HeapTag::Ui, HeapTag::Ui, HeapTag::Storage, HeapTag::Storage, HeapTag::Ui, HeapTag::Ui,
+    HeapTag::Sensors, HeapTag::Wifi, HeapTag::Wifi
+};
+
+DevDashM5Core2::DevDashM5Core2() : boot_(this) {
+    // Recreated if an earlier instance's destroy() released them
+    if (!renderer)        renderer = new LVGLRenderer();
+    if (!theme)           theme = new ThemeManager();
+    if (!manager)         manager = new WifiManager();
+#if DEVDASH_ENABLE_SENSORS
+    if (!sensorDashboard) sensorDashboard = new SensorDashboard();
+#endif
+
+    // LVGL stays on this core; SPIFFS (which may format on first mount),
+    // Wi-Fi bring-up and credential parsing overlap with it on the other
+    typedef BootSequence::Core Core;
+    BootSequence::StageFn run = [](void* user, uint8_t id, bool warm) {
+        return static_cast<DevDashM5Core2*>(user)->runStage_(static_cast<Stage>(id), warm);
+    };
+    auto after = [](Stage s) { return BootSequence::bit((uint8_t)s); };
+    boot_.add(kStageNames[0], Core::Ui,     run);
+    boot_.add(kStageNames[1], Core::Ui,     run, after(Stage::Renderer));
+    boot_.add(kStageNames[2], Core::Worker, run);
+    boot_.add(kStageNames[3], Core::Worker, run, after(Stage::Storage));
+    boot_.add(kStageNames[4], Core::Ui,     run, after(Stage::Theme));
+    boot_.add(kStageNames[5], Core::Ui,     run, after(Stage::Screens));
+    boot_.add(kStageNames[6], Core::Ui,     run);
+    boot_.add(kStageNames[7], Core::Ui,     run, after(Stage::Renderer) | after(Stage::Credentials));
+    boot_.add(kStageNames[8], Core::Ui,     run, after(Stage::Screens) | after(Stage::Radio));
+#if DEVDASH_ENABLE_CONSOLE
+    addCommands_();
+#endif
+}
 
-    // if (!sensorDashboard->begin()) {
-    //     Serial.println("SensorDashboard init failed");
-    //     return false;
-    // }
+DevDashM5Core2::~DevDashM5Core2() {
+#if DEVDASH_ENABLE_CONSOLE
+    DevDashConsole::removeAll(this);
+#endif
+}
+
+bool DevDashM5Core2::prepare() {
+    warm_ = true;
+    return boot_.step(true) == BootSequence::Status::Done;
+}
 
-    if (!manager->begin()) {
-        Serial.println("WifiManager init failed");
-        return false;
+bool DevDashM5Core2::begin() {
+    // assume M5.begin() has been called in setup
+    finishing_ = true;
+    for (;;) {
+        BootSequence::Status st = boot_.step(warm_);
+        if (st == BootSequence::Status::Done) break;
+        if (st == BootSequence::Status::Failed) { finishing_ = false; return false; }
+        if (st == BootSequence::Status::Waiting) delay(1); // only the other core has work left
     }
-    manager->setAutoReconnect(true);
-    manager->loadCredentials();
-
-    // Root layout
-    lv_obj_t* container = theme->createContainer(lv_screen_active());
-    // lv_obj_add_flag(container, LV_OBJ_FLAG_HIDDEN); // start hidden
-    lv_obj_t* header = theme->createHeader(container, "WiFi Networks", &refresh_btn_, &wifi_icon_);
-    (void)header; // silence unused if header isn't referenced further
-    wifi_panel_ = theme->createPanel(container);
+    finishing_ = false;
+
+    // Push the first frame now rather than on the next refresh tick
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(nullptr);
+    boot_.printTimeline(core_ready_ ? "resume" : warm_ ? "warm" : "cold");
+    DD_LOGI(Boot, "Boot: first frame %.1f ms after the first stage started", boot_.elapsedUs() / 1000.0f);
+    core_ready_ = true;
+    return true;
+}
 
-    // Refresh button re-scans and repopulates the list
-    lv_obj_add_event_cb(refresh_btn_, [](lv_event_t* e){
-        if (lv_event_get_code(e) != LV_EVENT_CLICKED) return;
-        auto* self = static_cast<DevDashM5Core2*>(lv_event_get_user_data(e));
-        if (!self || !self->wifi_panel_) return;
-        lv_obj_clean(self->wifi_panel_);
-        self->populateWifiList(self->wifi_panel_);
-    }, LV_EVENT_ALL, this);
+BootSequence::Result DevDashM5Core2::runStage_(Stage stage, bool warm) {
+    typedef BootSequence::Result Result;
+    HeapTracker::Scope heap(kStageTags[(uint8_t)stage]);
+    switch (stage) {
+    case Stage::Renderer:
+        if (!renderer->begin()) {
+            DD_LOGE(Boot, "LVGLRenderer init failed");
+            return Result::Failed;
+        }
+        break;
+    case Stage::Theme:
+        if (!theme->begin(parked_ ? parked_->theme : ThemeManager::Mode::Light)) {
+            DD_LOGE(Boot, "ThemeManager init failed");
+            return Result::Failed;
+        }
+        theme->apply(theme->current());
+        break;
+    case Stage::Storage:
+        // Worker core: nothing here may touch LVGL
+        if (core_ready_) break; // still up from before suspend()
+        if (!manager->begin()) {
+            DD_LOGE(Boot, "WifiManager init failed");
+            return Result::Failed;
+        }
+        break;
+    case Stage::Credentials:
+        if (core_ready_) break;
+        manager->loadCredentials();
+        break;
+    case Stage::Screens:
+        // Only reads scan results, which nothing fills before the Scan stage
+        if (!screens_.count()) addScreens_();
+        screens_.show(parked_ ? unparkState_() : 0);
+        break;
+    case Stage::Prebuild:
+        // Standby builds the other screens too, one per slice, while the budget allows
+        if (warm && prebuilt_ + 1 < (int)screens_.count()) {
+            screens_.prebuild(++prebuilt_);
+            return Result::Again;
+        }
+        break;
+    case Stage::Sensors:
+#if DEVDASH_ENABLE_SENSORS
+        // The IMU shares its I2C bus with the touch panel, so it stays on this core
+        if (core_ready_) break;
+        if (!sensorDashboard->begin()) {
+            DD_LOGE(Boot, "SensorDashboard init failed");
+            return Result::Failed;
+        }
+#endif
+        break;
+    case Stage::Radio:
+        if (!work_.begin()) DD_LOGW(Boot, "WorkExecutor unavailable; Wi-Fi actions will block");
+        if (!core_ready_) manager->setAutoReconnect(true);
+        manager->setNonBlocking(loop_budget_us_ != 0);
+        setPowerProfile(manager->powerProfile()); // also sets the UI cadence
+        break;
+    case Stage::Scan:
+#if DEVDASH_ENABLE_WIFI_UI
+        if (manager_busy_) {
+            // A rescan job owns the manager; its completion refreshes the list
+        } else if (warm) {
+            // Never block the host sketch: sweep in the background and poll
+            // startScan() also claims a sweep the manager started for a reconnect.
+            // Standby polls it slice by slice; once begin() runs, loop() picks
+            // up the results through takeScanUpdate() instead.
+            if (manager->startScan() && !finishing_) {
+                if (!manager->pollScan(20)) return Result::Again;
+                wifi_list_.update(manager->getScannedNetworks(), *manager);
+            }
+        } else if (manager->scanPending()) {
+            // loop() picks up the standby sweep when it completes
+        } else if (manager->getScannedNetworks().empty()) {
+            populateWifiList(wifi_panel_);
+        } else {
+            manager->startScan(); // resumed with parked results; refresh them in the background
+        }
+#endif
+        break;
+    }
+    return Result::Done;
+}
 
-    // Initial population
-    populateWifiList(wifi_panel_);
-    return true;
+void DevDashM5Core2::addScreens_() {
+    // Screens are built on first visit; swipe left/right to move between them.
+    // The first one registered is shown at start-up.
+#if DEVDASH_ENABLE_WIFI_UI
+    screens_.add("Wi-Fi",
+        [](void* user, lv_obj_t* scr){ static_cast<DevDashM5Core2*>(user)->buildWifiScreen_(scr); },
+        [](void* user){ static_cast<DevDashM5Core2*>(user)->releaseWifiScreen_(); }, this);
+#endif
+#if DEVDASH_ENABLE_SENSORS
+    screens_.add("Sensors",
+        [](void*, lv_obj_t* scr){ sensorDashboard->build(scr); },
+        [](void*){ sensorDashboard->release(); }, nullptr);
+#endif
+#if DEVDASH_ENABLE_SYSTEM_SCREEN
+    screens_.add("System",
+        [](void* user, lv_obj_t* scr){
+            auto* self = static_cast<DevDashM5Core2*>(user);
+            self->system_screen_.build(scr, theme, &self->screens_, &self->monitor_);
+        },
+        [](void* user){ static_cast<DevDashM5Core2*>(user)->system_screen_.release(); }, this);
+#endif
 }
 
 void DevDashM5Core2::loop() {
+    uint32_t start = micros();
+    loopOnce_(start);
+    monitor_.noteLoop(micros() - start);
+    monitor_.loop();
+    if (loop_budget_us_) return; // the host sketch paces its own loop
+    uint32_t idle = manager->powerParams().loopIdleMs;
+    if (idle) delay(idle);
+}
+
+void DevDashM5Core2::loopOnce_(uint32_t start) {
     // handle UI tasks
-    renderer->loop();
-    static wl_status_t last_status = WL_IDLE_STATUS;
+    {
+        HeapTracker::Scope heap(HeapTag::Ui);
+        renderer->loop();
+    }
+    // Completions of background work run here, on the LVGL thread
+    work_.drain();
+    // With a budget, whatever is left waits for the next call once it is spent
+    if (overBudget_(start)) return;
+#if DEVDASH_ENABLE_WIFI_UI
     wl_status_t current = WiFi.status();
 
-    if (wifi_icon_ && current != last_status) {
-        lv_color_t color = (current == WL_CONNECTED)
-            ? lv_palette_main(LV_PALETTE_GREEN)
-            : lv_palette_main(LV_PALETTE_GREY);
-        lv_obj_set_style_text_color(wifi_icon_, color, 0);
-        last_status = current;
+    if (wifi_icon_ && current != shown_status_) {
+        if (current == WL_CONNECTED) lv_obj_add_state(wifi_icon_, LV_STATE_CHECKED);
+        else lv_obj_remove_state(wifi_icon_, LV_STATE_CHECKED);
+        shown_status_ = current;
     }
-    manager->loop();
+#endif
+    if (!manager_busy_) {
+        HeapTracker::Scope heap(HeapTag::Wifi);
+        manager->loop();
+        if (manager->takeScanUpdate()) list_dirty_ = true;
+    }
+#if DEVDASH_ENABLE_WIFI_UI
+    if (list_dirty_ && wifi_panel_ && !manager_busy_ && !overBudget_(start)) {
+        HeapTracker::Scope heap(HeapTag::Ui);
+        wifi_list_.update(manager->getScannedNetworks(), *manager);
+        list_dirty_ = false;
+    }
+    uint8_t bars = (current == WL_CONNECTED) ? manager->link().bars() : 0;
+    if (signal_bars_ && bars != shown_bars_) {
+        ThemeManager::setSignalBars(signal_bars_, bars);
+        shown_bars_ = bars;
+    }
+#endif
     theme->loop();
-    // sensorDashboard->loop();
-    delay(5);
+    HeapTracker::loop();
+}
+
+void DevDashM5Core2::setRegion(int16_t x, int16_t y, int16_t w, int16_t h) {
+    LVGLRenderer::setRegion(x, y, w, h);
+}
+
+void DevDashM5Core2::setLoopBudget(uint32_t us) {
+    loop_budget_us_ = us;
+    // Radio work must not wait inside loop() either
+    if (manager) manager->setNonBlocking(us != 0);
+}
+
+void DevDashM5Core2::suspend(bool keepState) {
+    if (!boot_.started()) return; // nothing built yet
+    uint32_t start = micros();
+    size_t internal = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    size_t psram = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+
+    // Waits for a running job; completions still find the UI in place
+    work_.end();
+    // Stops the worker core's stages before anything is torn down
+    bool shown = boot_.finished((uint8_t)Stage::Screens);
+    boot_.reset();
+    if (keepState && shown) parkState_();
+    else manager->clearScanResults();
+
+    // Everything holding pointers into LVGL lets go before lv_deinit() runs
+#if DEVDASH_ENABLE_WIFI_UI
+    password_keyboard_.destroy();
+#endif
+    screens_.destroy();
+    releaseModals_();
+#if DEVDASH_ENABLE_SENSORS
+    sensorDashboard->destroy();
+#endif
+    renderer->destroy();
+#if DEVDASH_ENABLE_SENSORS
+    NumericReadout::releaseSprites();
+#endif
+    theme->destroy();
+    prebuilt_ = 0;
+
+    DD_LOGI(Core, "Suspend: %d B internal, %d B PSRAM returned in %lu us%s",
+            (int)(heap_caps_get_free_size(MALLOC_CAP_INTERNAL) - internal),
+            (int)(heap_caps_get_free_size(MALLOC_CAP_SPIRAM) - psram),
+            (unsigned long)(micros() - start), parked_ ? ", state parked" : "");
 }
 
 void DevDashM5Core2::destroy() {
-    // tear down components
+    // UI first, while the components it references still exist
+    suspend(false);
+    if (parked_) { heap_caps_free(parked_); parked_ = nullptr; }
+    if (manager)  { delete manager; manager = nullptr; }
     if (renderer) { delete renderer; renderer = nullptr; }
     if (theme)    { delete theme; theme = nullptr; }
-    if (manager)  { delete manager; manager = nullptr; }
+#if DEVDASH_ENABLE_SENSORS
     if (sensorDashboard)  { delete sensorDashboard; sensorDashboard = nullptr; }
+#endif
+    core_ready_ = false;
+}
+
+void DevDashM5Core2::parkState_() {
+    if (!parked_) {
+        void* mem = heap_caps_malloc(sizeof(ParkedState), MALLOC_CAP_SPIRAM);
+        if (!mem) return;
+        parked_ = new (mem) ParkedState();
+    }
+    parked_->theme = theme->current();
+    parked_->screen = (int8_t)screens_.active();
+    Span<const WiFiNetwork> nws = manager->getScannedNetworks();
+    parked_->networks = (uint8_t)nws.size();
+    for (uint8_t i = 0; i < parked_->networks; ++i) parked_->network[i] = nws[i];
+    manager->clearScanResults();
+}
+
+int DevDashM5Core2::unparkState_() {
+    manager->restoreScanResults(Span<const WiFiNetwork>(parked_->network, parked_->networks));
+    int screen = parked_->screen == ScreenManager::kNone ? 0 : parked_->screen;
+    heap_caps_free(parked_);
+    parked_ = nullptr;
+    return screen;
+}
+
+void DevDashM5Core2::releaseModals_() {
+    // Top-layer objects; lv_deinit() deletes them
+#if DEVDASH_ENABLE_WIFI_UI
+    password_modal_ = password_textarea_ = ssid_label_ = show_pw_btn_ = nullptr;
+    connect_btn_ = cancel_btn_ = nullptr;
+#endif
+#if DEVDASH_ENABLE_DIAGNOSTICS
+    diag_modal_ = diag_endpoint_ = diag_results_ = diag_profile_ = nullptr;
+#endif
 }
 
 void DevDashM5Core2::updateTheme() {
@@ -99,118 +386,159 @@ void DevDashM5Core2::updateTheme() {
     theme->apply(next);
 }
 
+void DevDashM5Core2::setPowerProfile(PowerProfile p) {
+    manager->setPowerProfile(p);
+    renderer->setRefreshPeriod(manager->powerParams().uiRefreshMs);
+}
+
+#if DEVDASH_ENABLE_WIFI_UI
+/* -------------------- Wi-Fi Screen -------------------- */
+
+void DevDashM5Core2::buildWifiScreen_(lv_obj_t* screen) {
+    lv_obj_t* container = theme->createContainer(screen);
+    lv_obj_t* header = theme->createHeader(container, "WiFi Networks", &refresh_btn_, &wifi_icon_, &signal_bars_);
+    wifi_panel_ = theme->createPanel(container);
+
+#if DEVDASH_ENABLE_DIAGNOSTICS
+    // Diagnostics button sits left of refresh
+    diag_btn_ = theme->createIconButton(header, LV_SYMBOL_SETTINGS);
+    lv_obj_move_to_index(diag_btn_, 1);
+    lv_obj_add_event_cb(diag_btn_, [](lv_event_t* e){
+        auto* self = static_cast<DevDashM5Core2*>(lv_event_get_user_data(e));
+        if (self) self->showDiagnostics();
+    }, LV_EVENT_CLICKED, this);
+#else
+    (void)header;
+#endif
+
+    // Refresh button re-scans and updates the list in place
+    lv_obj_add_event_cb(refresh_btn_, [](lv_event_t* e){
+        auto* self = static_cast<DevDashM5Core2*>(lv_event_get_user_data(e));
+        if (!self || !self->wifi_panel_) return;
+        if (self->loop_budget_us_) self->manager->startScan(); // loop() shows the results
+        else self->scanInBackground_();
+    }, LV_EVENT_CLICKED, this);
+
+    wifi_list_.begin(wifi_panel_, theme, [](void* user, const char* ssid){
+        static_cast<DevDashM5Core2*>(user)->selectNetwork_(ssid);
+    }, this);
+
+    // Force the next loop() to sync the status icons
+    shown_status_ = WL_IDLE_STATUS;
+    shown_bars_ = 0xFF;
+
+    // Last known results; start-up and the refresh button do the scanning.
+    // While a job owns the manager, loop() fills the list once it is done.
+    if (manager_busy_) {
+        list_dirty_ = true;
+    } else {
+        wifi_list_.update(manager->getScannedNetworks(), *manager);
+        list_dirty_ = false;
+    }
+}
+
+void DevDashM5Core2::releaseWifiScreen_() {
+    wifi_list_.destroy();
+    refresh_btn_ = wifi_icon_ = signal_bars_ = wifi_panel_ = nullptr;
+#if DEVDASH_ENABLE_DIAGNOSTICS
+    diag_btn_ = nullptr;
+#endif
+}
+
 /* -------------------- Wi-Fi List -------------------- */
 
 void DevDashM5Core2::populateWifiList(lv_obj_t* panel) {
     if (!panel) return;
+    wifi_list_.update(manager->scanNetworks(20), *manager);
+}
 
-    std::vector<WiFiNetwork> networks = manager->scanNetworks(20);
-    std::vector<SavedWiFiNetwork> saved = manager->getSavedNetworks();
-
-    if (networks.empty()) {
-        lv_obj_t* label = lv_label_create(panel);
-        lv_label_set_text(label, "No networks found.");
+void DevDashM5Core2::selectNetwork_(const char* ssid) {
+    if (manager_busy_) {
+        DD_LOGW(Wifi, "Wi-Fi busy, ignoring: %s", ssid);
         return;
     }
+    const SavedWiFiNetwork* saved = manager->findSaved(ssid);
+    if (!saved) {
+        showPasswordModal(ssid);
+        return;
+    }
+    // Already saved, no need to show modal
+    DD_LOGI(Wifi, "Network already saved: %s", ssid);
+    connect_(ssid, saved->password.c_str());
+}
 
-    for (const auto& network : networks) {
-        // Row container
-        lv_obj_t* row = lv_obj_create(panel);
-        lv_obj_set_width(row, lv_pct(100));
-        lv_obj_set_height(row, LV_SIZE_CONTENT);
-        lv_obj_set_flex_flow(row, LV_FLEX_FLOW_ROW);
-        lv_obj_set_style_pad_row(row, 0, 0);
-        lv_obj_set_style_pad_column(row, 10, 0);
-        lv_obj_set_style_border_width(row, 0, 0);
-        lv_obj_set_style_bg_opa(row, LV_OPA_TRANSP, 0);
-
-        // SSID label (child 0)
-        lv_obj_t* ssid_label = lv_label_create(row);
-        lv_label_set_text(ssid_label, network.ssid.c_str());
-        lv_obj_set_flex_grow(ssid_label, 1);
-
-        // RSSI label (child 1)
-        lv_obj_t* rssi_label = lv_label_create(row);
-        if (!saved.empty()) {
-            for (const auto& saved_net : saved) {
-                if (saved_net.ssid == network.ssid) {
-                    // Highlight saved networks
-                    lv_label_set_text_fmt(rssi_label, "%s %d dBm", LV_SYMBOL_SAVE, network.rssi);
-                    break;
-                } else {
-                    lv_label_set_text_fmt(rssi_label, "%d dBm", network.rssi);
-                }
-            }
-        } else {
-            lv_label_set_text_fmt(rssi_label, "%d dBm", network.rssi);
-        }
-        lv_obj_set_style_text_color(rssi_label, lv_palette_main(LV_PALETTE_BLUE), 0);
-
-        // Click handler: read SSID text from first child; no heap allocations
-        lv_obj_add_event_cb(row,
-            [](lv_event_t* e){
-                if (lv_event_get_code(e) != LV_EVENT_CLICKED) return;
-                auto* self = static_cast<DevDashM5Core2*>(lv_event_get_user_data(e));
-                if (!self) return;
-                lv_obj_t* row = static_cast<lv_obj_t*>(lv_event_get_target(e));
-                lv_obj_t* lbl = lv_obj_get_child(row, 0);
-                if (!lbl) return;
-                const char* ssid_text = lv_label_get_text(lbl);
-                std::vector<SavedWiFiNetwork> saved = self->manager->getSavedNetworks();
-                if (!saved.empty()) {
-                    for (const auto& net : saved) {
-                        if (net.ssid == ssid_text) {
-                            // Already saved, no need to show modal
-                            Serial.println("Network already saved: " + String(ssid_text));
-                            bool connected = self->manager->connect(ssid_text, net.password.c_str());
-                            if (connected) {
-                                Serial.println("Connected to: " + String(ssid_text));
-                            } else {
-                                Serial.println("Failed to connect to: " + String(ssid_text));
-                            }
-                            return;
-                        } else {
-                            self->showPasswordModal(ssid_text ? ssid_text : "");
-                        }
-                    }
-                } else {
-                    self->showPasswordModal(ssid_text ? ssid_text : "");
-                }
-            },
-        LV_EVENT_ALL, this);
+void DevDashM5Core2::connect_(const char* ssid, const char* password) {
+    if (loop_budget_us_) {
+        manager->startConnect(ssid, password); // loop() finishes it
+        return;
+    }
+    if (manager_busy_) {
+        DD_LOGW(Wifi, "Wi-Fi busy, ignoring connect to: %s", ssid);
+        return;
+    }
+    // A join blocks for seconds; the worker waits for it instead of the UI.
+    // Only one job owns the manager, so its credentials have a fixed home.
+    connecting_.ssid = ssid;
+    connecting_.password = password;
+    WorkExecutor::JobId id = work_.submit(
+        [](void* user, const volatile bool&) {
+            auto* self = static_cast<DevDashM5Core2*>(user);
+            HeapTracker::Scope heap(HeapTag::Wifi);
+            return manager->connect(self->connecting_.ssid.c_str(), self->connecting_.password.c_str());
+        },
+        [](void* user, WorkExecutor::Outcome outcome) {
+            auto* self = static_cast<DevDashM5Core2*>(user);
+            DD_LOGI(Wifi, "%s: %s", outcome == WorkExecutor::Outcome::Ok ? "Connected to" : "Failed to connect to",
+                    self->connecting_.ssid.c_str());
+            self->connecting_.password.clear();
+            self->manager_busy_ = false;
+            self->list_dirty_ = true;
+        }, this, WorkExecutor::Priority::High);
+    if (id) {
+        manager_busy_ = true;
+        return;
+    }
+    connecting_.password.clear();
+    if (manager->connect(ssid, password)) {
+        DD_LOGI(Wifi, "Connected to: %s", ssid);
+    } else {
+        DD_LOGW(Wifi, "Failed to connect to: %s", ssid);
     }
 }
 
+void DevDashM5Core2::scanInBackground_() {
+    if (manager_busy_) return; // a connect is running; its results refresh the list
+    WorkExecutor::JobId id = work_.submit(
+        [](void*, const volatile bool&) {
+            HeapTracker::Scope heap(HeapTag::Wifi);
+            manager->scanNetworks(20); // kept by the manager
+            return true;
+        },
+        [](void* user, WorkExecutor::Outcome) {
+            auto* self = static_cast<DevDashM5Core2*>(user);
+            self->manager_busy_ = false;
+            self->list_dirty_ = true;
+        }, this);
+    if (id) manager_busy_ = true;
+    else populateWifiList(wifi_panel_);
+}
+
 /* -------------------- Password Modal (create once, reuse) -------------------- */
 
 void DevDashM5Core2::ensurePasswordUI_() {
     if (password_modal_) return; // already built
 
+    size_t mem_before = lvglUsedBytes();
+
     // Modal on the top layer
-    password_modal_ = lv_obj_create(lv_layer_top());
-    lv_obj_set_size(password_modal_, 320, 240);
-    lv_obj_center(password_modal_);
-    lv_obj_add_flag(password_modal_, LV_OBJ_FLAG_HIDDEN); // start hidden
-    lv_obj_set_style_bg_color(password_modal_, lv_color_hex(0xffffff), 0);
-    lv_obj_set_style_pad_all(password_modal_, 10, 0);
-    lv_obj_set_layout(password_modal_, LV_LAYOUT_FLEX);
-    lv_obj_set_flex_flow(password_modal_, LV_FLEX_FLOW_COLUMN);
-    lv_obj_set_style_flex_main_place(password_modal_, LV_FLEX_ALIGN_CENTER, 0);
-    lv_obj_set_style_flex_cross_place(password_modal_, LV_FLEX_ALIGN_CENTER, 0);
-    lv_obj_set_scrollbar_mode(password_modal_, LV_SCROLLBAR_MODE_OFF);
+    password_modal_ = theme->createModal();
 
     // SSID label
     ssid_label_ = lv_label_create(password_modal_);
+    theme->addStyle(ssid_label_, ThemeManager::Role::ModalTitle);
 
     // Password row container
-    lv_obj_t* pw_row = lv_obj_create(password_modal_);
-    lv_obj_set_width(pw_row, lv_pct(100));
-    lv_obj_set_height(pw_row, LV_SIZE_CONTENT);
-    lv_obj_set_flex_flow(pw_row, LV_FLEX_FLOW_ROW);
-    lv_obj_set_style_pad_column(pw_row, 10, 0);
-    lv_obj_set_style_border_width(pw_row, 0, 0);
-    lv_obj_set_style_bg_opa(pw_row, LV_OPA_TRANSP, 0);
-    lv_obj_set_style_pad_all(pw_row, 0, 0);
+    lv_obj_t* pw_row = theme->createFormRow(password_modal_);
 
     // Textarea
     password_textarea_ = lv_textarea_create(pw_row);
@@ -218,17 +546,10 @@ void DevDashM5Core2::ensurePasswordUI_() {
     lv_textarea_set_placeholder_text(password_textarea_, "Enter password");
     lv_textarea_set_max_length(password_textarea_, 64);
     lv_textarea_set_one_line(password_textarea_, true);
-    lv_obj_set_flex_grow(password_textarea_, 1);
-    lv_obj_set_height(password_textarea_, LV_SIZE_CONTENT);
+    theme->addStyle(password_textarea_, ThemeManager::Role::Fill);
 
     // Show/Hide Password Button
-    show_pw_btn_ = lv_btn_create(pw_row);
-    lv_obj_set_size(show_pw_btn_, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
-    {
-        lv_obj_t* show_pw_label = lv_label_create(show_pw_btn_);
-        lv_label_set_text(show_pw_label, LV_SYMBOL_EYE_OPEN);
-        lv_obj_center(show_pw_label);
-    }
+    show_pw_btn_ = theme->createIconButton(pw_row, LV_SYMBOL_EYE_OPEN);
     // Toggle password visibility (non-capturing lambda)
     lv_obj_add_event_cb(show_pw_btn_, [](lv_event_t* e){
         if (lv_event_get_code(e) != LV_EVENT_CLICKED) return;
@@ -243,10 +564,7 @@ void DevDashM5Core2::ensurePasswordUI_() {
     }, LV_EVENT_ALL, nullptr);
 
     // Keyboard (top layer; hidden by default)
-    password_keyboard_ = lv_keyboard_create(lv_layer_top());
-    lv_obj_set_size(password_keyboard_, 320, 110);
-    lv_obj_align(password_keyboard_, LV_ALIGN_BOTTOM_MID, 0, 0);
-    lv_obj_add_flag(password_keyboard_, LV_OBJ_FLAG_HIDDEN);
+    password_keyboard_.begin(lv_layer_top(), theme);
 
     // Show keyboard on focus, hide on defocus
     lv_obj_add_event_cb(password_textarea_, [](lv_event_t* e){
@@ -254,47 +572,36 @@ void DevDashM5Core2::ensurePasswordUI_() {
         DevDashM5Core2* self = static_cast<DevDashM5Core2*>(lv_event_get_user_data(e));
         if (!self) return;
         if (code == LV_EVENT_FOCUSED) {
-            lv_keyboard_set_textarea(self->password_keyboard_, self->password_textarea_);
-            lv_obj_clear_flag(self->password_keyboard_, LV_OBJ_FLAG_HIDDEN);
-            lv_obj_move_foreground(self->password_keyboard_);
+            self->password_keyboard_.setTextarea(self->password_textarea_);
+            self->password_keyboard_.show();
         } else if (code == LV_EVENT_DEFOCUSED) {
-            lv_keyboard_set_textarea(self->password_keyboard_, nullptr);
-            lv_obj_add_flag(self->password_keyboard_, LV_OBJ_FLAG_HIDDEN);
+            self->password_keyboard_.setTextarea(nullptr);
+            self->password_keyboard_.hide();
         }
     }, LV_EVENT_ALL, this);
 
     // Button row
-    lv_obj_t* btn_row = lv_obj_create(password_modal_);
-    lv_obj_set_width(btn_row, lv_pct(100));
-    lv_obj_set_flex_flow(btn_row, LV_FLEX_FLOW_ROW);
-    lv_obj_set_style_flex_main_place(btn_row, LV_FLEX_ALIGN_CENTER, 0);
-    lv_obj_set_style_pad_column(btn_row, 10, 0);
-    lv_obj_set_style_border_width(btn_row, 0, 0);
-    lv_obj_set_style_bg_opa(btn_row, LV_OPA_TRANSP, 0);
+    lv_obj_t* btn_row = theme->createFormRow(password_modal_);
 
     // Cancel button
-    cancel_btn_ = lv_btn_create(btn_row);
-    lv_label_set_text(lv_label_create(cancel_btn_), "Cancel");
-    lv_obj_add_event_cb(cancel_btn_, [](lv_event_t* e){
-        if (lv_event_get_code(e) != LV_EVENT_CLICKED) return;
+    cancel_btn_ = theme->createButton(btn_row, "Cancel", [](lv_event_t* e){
         DevDashM5Core2* self = static_cast<DevDashM5Core2*>(lv_event_get_user_data(e));
         if (!self) return;
         self->hidePasswordModal();
         if (self->password_textarea_) lv_textarea_set_text(self->password_textarea_, "");
-    }, LV_EVENT_ALL, this);
+    }, this);
 
     // Connect button
-    connect_btn_ = lv_btn_create(btn_row);
-    lv_label_set_text(lv_label_create(connect_btn_), "Connect");
-    lv_obj_add_event_cb(connect_btn_, [](lv_event_t* e){
-        if (lv_event_get_code(e) != LV_EVENT_CLICKED) return;
+    connect_btn_ = theme->createButton(btn_row, "Connect", [](lv_event_t* e){
         DevDashM5Core2* self = static_cast<DevDashM5Core2*>(lv_event_get_user_data(e));
         if (!self) return;
         const char* pw = self->password_textarea_ ? lv_textarea_get_text(self->password_textarea_) : "";
-        bool connected = self->manager->connect(self->current_ssid_.c_str(), pw);
+        self->connect_(self->current_ssid_.c_str(), pw);
         self->hidePasswordModal();
         if (self->password_textarea_) lv_textarea_set_text(self->password_textarea_, "");
-    }, LV_EVENT_ALL, this);
+    }, this);
+
+    logModalBuild("password", password_modal_, mem_before);
 }
 
 void DevDashM5Core2::resetPasswordUI_() {
@@ -318,15 +625,216 @@ void DevDashM5Core2::showPasswordModal(const char* ssid) {
 }
 
 void DevDashM5Core2::hidePasswordModal() {
-    if (password_keyboard_) {
-        lv_keyboard_set_textarea(password_keyboard_, nullptr);
-        lv_obj_add_flag(password_keyboard_, LV_OBJ_FLAG_HIDDEN);
-    }
+    password_keyboard_.setTextarea(nullptr);
+    password_keyboard_.hide();
     if (password_modal_) {
         lv_obj_add_flag(password_modal_, LV_OBJ_FLAG_HIDDEN);
     }
 }
 
+#endif // DEVDASH_ENABLE_WIFI_UI
+
+#if DEVDASH_ENABLE_DIAGNOSTICS
+/* -------------------- Diagnostics Modal (create once, reuse) -------------------- */
+
+void DevDashM5Core2::ensureDiagUI_() {
+    if (diag_modal_) return;
+
+    size_t mem_before = lvglUsedBytes();
+    diag_modal_ = theme->createModal();
+
+    lv_obj_t* title = lv_label_create(diag_modal_);
+    lv_label_set_text(title, "Link diagnostics");
+    theme->addStyle(title, ThemeManager::Role::ModalTitle);
+
+    diag_endpoint_ = lv_label_create(diag_modal_);
+
+    diag_profile_ = lv_dropdown_create(diag_modal_);
+    theme->addStyle(diag_profile_, ThemeManager::Role::FullWidth);
+    lv_dropdown_set_options_static(diag_profile_, "Max performance\nBalanced\nLow power");
+    lv_obj_add_event_cb(diag_profile_, [](lv_event_t* e){
+        auto* self = static_cast<DevDashM5Core2*>(lv_event_get_user_data(e));
+        lv_obj_t* dd = static_cast<lv_obj_t*>(lv_event_get_target(e));
+        if (!self) return;
+        if (self->manager_busy_) {
+            // A job owns the radio; put the selection back
+            DD_LOGW(Wifi, "Wi-Fi busy, power profile not changed");
+            lv_dropdown_set_selected(dd, static_cast<uint32_t>(manager->powerProfile()));
+            return;
+        }
+        self->setPowerProfile(static_cast<PowerProfile>(lv_dropdown_get_selected(dd)));
+    }, LV_EVENT_VALUE_CHANGED, this);
+
+    diag_results_ = lv_label_create(diag_modal_);
+    theme->addStyle(diag_results_, ThemeManager::Role::FullWidth);
+    theme->addStyle(diag_results_, ThemeManager::Role::Fill);
+    lv_label_set_long_mode(diag_results_, LV_LABEL_LONG_WRAP);
+    lv_label_set_text(diag_results_, "");
+
+    lv_obj_t* btn_row = theme->createFormRow(diag_modal_);
+
+    theme->createButton(btn_row, "Close", [](lv_event_t* e){
+        auto* self = static_cast<DevDashM5Core2*>(lv_event_get_user_data(e));
+        if (self) self->hideDiagnostics();
+    }, this);
+
+    theme->createButton(btn_row, "Power", [](lv_event_t* e){
+        auto* self = static_cast<DevDashM5Core2*>(lv_event_get_user_data(e));
+        if (self) self->measurePowerProfiles();
+    }, this);
+
+    theme->createButton(btn_row, "Run", [](lv_event_t* e){
+        auto* self = static_cast<DevDashM5Core2*>(lv_event_get_user_data(e));
+        if (self) self->runDiagnostics();
+    }, this);
+
+    logModalBuild("diagnostics", diag_modal_, mem_before);
+}
+
+void DevDashM5Core2::showDiagnostics() {
+    ensureDiagUI_();
+    const NetBench::Config& cfg = manager->benchConfig();
+    if (cfg.host.length()) {
+        lv_label_set_text_fmt(diag_endpoint_, "Endpoint: %s:%u", cfg.host.c_str(), cfg.port);
+    } else {
+        lv_label_set_text(diag_endpoint_, "Endpoint: not set (WifiManager::setBenchEndpoint)");
+    }
+    lv_dropdown_set_selected(diag_profile_, static_cast<uint32_t>(manager->powerProfile()));
+    lv_obj_clear_flag(diag_modal_, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_move_foreground(diag_modal_);
+}
+
+void DevDashM5Core2::hideDiagnostics() {
+    if (diag_modal_) lv_obj_add_flag(diag_modal_, LV_OBJ_FLAG_HIDDEN);
+}
+
+namespace {
+struct BenchJob {
+    DevDashM5Core2*  self;
+    NetBench::Config cfg;
+    NetBench::Report report;
+};
+}
+
+void DevDashM5Core2::runDiagnostics() {
+    if (!diag_results_ || bench_job_) return;
+    // The run takes seconds; NetBench only needs a copy of the endpoint
+    BenchJob* job = new BenchJob{ this, manager->benchConfig(), NetBench::Report() };
+    bench_job_ = work_.submit(
+        [](void* user, const volatile bool&) {
+            auto* job = static_cast<BenchJob*>(user);
+            HeapTracker::Scope heap(HeapTag::Wifi);
+            job->report = NetBench::run(job->cfg);
+            return job->report.ok;
+        },
+        [](void* user, WorkExecutor::Outcome outcome) {
+            auto* job = static_cast<BenchJob*>(user);
+            DevDashM5Core2* self = job->self;
+            self->bench_job_ = 0;
+            if (self->diag_results_) {
+                char text[320];
+                if (outcome == WorkExecutor::Outcome::Cancelled) strlcpy(text, "Cancelled", sizeof(text));
+                else NetBench::format(job->report, text, sizeof(text));
+                lv_label_set_text(self->diag_results_, text);
+            }
+            delete job;
+        }, job, WorkExecutor::Priority::Low);
+    if (bench_job_) {
+        lv_label_set_text(diag_results_, "Running...");
+        return;
+    }
+    delete job;
+    lv_label_set_text(diag_results_, "Worker busy, try again");
+}
+
+namespace {
+struct PowerJob {
+    DevDashM5Core2* self;
+    PowerProfile    original;
+    char            text[320];
+};
+}
+
+/** Waits ms in short steps; false once the job is cancelled */
+static bool sleepUnlessCancelled(uint32_t ms, const volatile bool& cancel) {
+    for (uint32_t t = 0; t < ms; t += 100) {
+        if (cancel) return false;
+        delay(100);
+    }
+    return !cancel;
+}
+
+void DevDashM5Core2::measurePowerProfiles() {
+    if (!diag_results_ || power_job_) return;
+    if (manager_busy_) {
+        lv_label_set_text(diag_results_, "Wi-Fi busy, try again");
+        return;
+    }
+    PowerJob* job = new PowerJob{ this, manager->powerProfile(), "" };
+    power_job_ = work_.submit(
+        [](void* user, const volatile bool& cancel) {
+            static const PowerProfile kAll[] = {
+                PowerProfile::MaxPerformance, PowerProfile::Balanced, PowerProfile::LowPower
+            };
+            const uint32_t kSettleMs = 3000, kSampleMs = 5000, kSamplePeriodMs = 100;
+            auto* job = static_cast<PowerJob*>(user);
+            HeapTracker::Scope heap(HeapTag::Wifi);
+
+            size_t len = sizeof(job->text);
+            size_t used = snprintf(job->text, len, "Profile          mA    ping p50/p90 ms\n");
+            for (PowerProfile p : kAll) {
+                // Radio settings only: the UI cadence is LVGL's, and the
+                // completion restores it with the original profile
+                manager->setPowerProfile(p);
+                if (!sleepUnlessCancelled(kSettleMs, cancel)) return false;
+
+                // System draw = VBUS in minus charge current; on battery VBUS is 0
+                // and the (negative) battery current is the draw. Wire locks each
+                // transaction, so the AXP reads share the bus with touch.
+                float sum = 0;
+                uint32_t n = 0;
+                for (uint32_t t = 0; t < kSampleMs; t += kSamplePeriodMs, ++n) {
+                    if (cancel) return false;
+                    sum += M5.Axp.GetVBusCurrent() - M5.Axp.GetBatCurrent();
+                    delay(kSamplePeriodMs);
+                }
+                NetBench::Percentiles rtt;
+                NetBench::ping(manager->benchConfig(), 20, rtt);
+
+                const PowerProfileParams& pp = manager->powerParams();
+                DD_LOGI(Wifi, "%s: %.1f mA, ping p50 %.1f ms p90 %.1f ms (lost %u)",
+                        pp.name, sum / n, rtt.p50 / 1000.0f, rtt.p90 / 1000.0f, rtt.lost);
+                if (used < len) {
+                    used += snprintf(job->text + used, len - used, "%-16s %5.1f  %5.1f / %5.1f\n",
+                                     pp.name, sum / n, rtt.p50 / 1000.0f, rtt.p90 / 1000.0f);
+                }
+            }
+            return true;
+        },
+        [](void* user, WorkExecutor::Outcome outcome) {
+            auto* job = static_cast<PowerJob*>(user);
+            DevDashM5Core2* self = job->self;
+            self->power_job_ = 0;
+            self->manager_busy_ = false;
+            self->setPowerProfile(job->original);
+            if (self->diag_results_) {
+                lv_label_set_text(self->diag_results_,
+                                  outcome == WorkExecutor::Outcome::Ok ? job->text : "Cancelled");
+            }
+            delete job;
+        }, job, WorkExecutor::Priority::Low);
+    if (power_job_) {
+        // The sweep switches profiles; nothing else may drive the manager meanwhile
+        manager_busy_ = true;
+        lv_label_set_text(diag_results_, "Measuring profiles (~30 s)...");
+        return;
+    }
+    delete job;
+    lv_label_set_text(diag_results_, "Worker busy, try again");
+}
+#endif // DEVDASH_ENABLE_DIAGNOSTICS
+
+#if DEVDASH_ENABLE_WIFI_UI
 /* -------------------- Legacy-style handlers (optional) -------------------- */
 
 void DevDashM5Core2::wifiRowEventHandler(lv_event_t* e) {
@@ -338,7 +846,137 @@ void DevDashM5Core2::wifiRowEventHandler(lv_event_t* e) {
 void DevDashM5Core2::connectBtnEventHandler(lv_event_t* /*e*/) {
     // Fallback: use persistent textarea and SSID
     const char* pw = password_textarea_ ? lv_textarea_get_text(password_textarea_) : "";
-    manager->connect(current_ssid_.c_str(), pw);
+    connect_(current_ssid_.c_str(), pw);
     hidePasswordModal();
     if (password_textarea_) lv_textarea_set_text(password_textarea_, "");
 }
+#endif
+
+#if DEVDASH_ENABLE_CONSOLE
+/* -------------------- Console commands -------------------- */
+
+typedef DevDashConsole Con;
+
+/** Queue multi-line text one line at a time, so none is cut at the printf limit */
+static void printLines(const char* text) {
+    while (*text) {
+        const char* end = strchr(text, '\n');
+        size_t len = end ? (size_t)(end - text) + 1 : strlen(text);
+        Con::write(text, len);
+        text += len;
+    }
+}
+
+void DevDashM5Core2::addCommands_() {
+    Con::add("perf", "CPU, frame rate, loop latency, background work and flush totals", [](void* user, uint8_t, char**) {
+        auto* self = static_cast<DevDashM5Core2*>(user);
+        const SystemMonitor::Sample& s = self->monitor_.latest();
+        Con::printf("cpu %d%% / %d%%, %.1f frames/s, loop p50 %lu p90 %lu p99 %lu max %lu us (%lu calls in %lu ms)\n",
+                    s.cpuPct[0], s.cpuPct[1], s.fps, (unsigned long)s.loopP50Us, (unsigned long)s.loopP90Us,
+                    (unsigned long)s.loopP99Us, (unsigned long)s.loopMaxUs, (unsigned long)s.loops,
+                    (unsigned long)self->monitor_.period());
+        const WorkExecutor::Stats& w = self->work_.stats();
+        Con::printf("work %lu submitted, %lu rejected, %lu done, %lu cancelled, max wait %lu us, max run %lu us\n",
+                    (unsigned long)w.submitted, (unsigned long)w.rejected, (unsigned long)w.completed,
+                    (unsigned long)w.cancelled, (unsigned long)w.maxWaitUs, (unsigned long)w.maxRunUs);
+        const LVGLRenderer::FlushStats& f = LVGLRenderer::flushStats();
+        Con::printf("flush %lu frames, %lu areas, %lu pixels\n",
+                    (unsigned long)f.frames, (unsigned long)f.areas, (unsigned long)f.pixels);
+    }, this);
+    Con::add("tasks", "stack never used per task, lowest first", [](void* user, uint8_t, char**) {
+        const SystemMonitor::Sample& s = static_cast<DevDashM5Core2*>(user)->monitor_.latest();
+        for (uint8_t i = 0; i < s.taskCount; ++i) {
+            Con::printf("  %-15s %5lu B  core %d\n", s.tasks[i].name, (unsigned long)s.tasks[i].stackFree,
+                        (int)s.tasks[i].core);
+        }
+    }, this);
+    Con::add("heap", "heap per region and subsystem, changes since the last heap", [](void* user, uint8_t, char**) {
+        auto* self = static_cast<DevDashM5Core2*>(user);
+        // The LVGL pool only exists between the renderer stage and suspend()
+        bool lvgl = self->boot_.finished((uint8_t)Stage::Renderer);
+        HeapTracker::Snapshot now;
+        HeapTracker::snapshot(now, lvgl);
+        char text[512];
+        HeapTracker::format(now, self->heap_marked_ ? &self->heap_mark_ : nullptr, text, sizeof(text));
+        printLines(text);
+        if (lvgl) {
+            Con::printf("LVGL      %lu of %lu B free, largest %lu B, %u%% frag\n", (unsigned long)now.lvgl.free,
+                        (unsigned long)now.lvgl.size, (unsigned long)now.lvgl.largest, (unsigned)now.lvgl.fragPct);
+        } else {
+            Con::printf("LVGL      not running\n");
+        }
+        self->heap_mark_ = now;
+        self->heap_marked_ = true;
+    }, this);
+    Con::add("scan", "start a Wi-Fi scan; networks lists the results", [](void* user, uint8_t, char**) {
+        auto* self = static_cast<DevDashM5Core2*>(user);
+        if (!self->wifiIdle_()) Con::printf("scan: Wi-Fi not ready or busy\n");
+        else Con::printf(manager->startScan() ? "scan started\n" : "scan: already running\n");
+    }, this);
+    Con::add("networks", "results of the last scan", [](void* user, uint8_t, char**) {
+        auto* self = static_cast<DevDashM5Core2*>(user);
+        // A rescan job rewrites the list on the other core until it completes
+        if (!self->wifiIdle_()) { Con::printf("networks: Wi-Fi not ready or busy\n"); return; }
+        for (const WiFiNetwork& nw : manager->getScannedNetworks()) {
+            Con::printf("  %4d dBm  ch %2u  %s%s\n", (int)nw.rssi, (unsigned)nw.channel, nw.ssid.c_str(),
+                        manager->findSaved(nw.ssid.c_str()) ? "  (saved)" : "");
+        }
+    }, this);
+    Con::add("connect", "connect \"ssid\" [password]; a saved password is used if none is given", [](void* user, uint8_t argc, char** argv) {
+        auto* self = static_cast<DevDashM5Core2*>(user);
+        if (argc < 2) { Con::printf("connect: ssid missing\n"); return; }
+        if (!self->wifiIdle_()) { Con::printf("connect: Wi-Fi not ready or busy\n"); return; }
+        const char* password = argc > 2 ? argv[2] : nullptr;
+        if (!password) {
+            const SavedWiFiNetwork* saved = manager->findSaved(argv[1]);
+            password = saved ? saved->password.c_str() : "";
+        }
+        // Finished by loop() without blocking it
+        manager->startConnect(argv[1], password);
+        Con::printf("connecting to %s\n", argv[1]);
+    }, this);
+    Con::add("theme", "theme [light|dark]; toggles without an argument", [](void* user, uint8_t argc, char** argv) {
+        auto* self = static_cast<DevDashM5Core2*>(user);
+        if (!self->boot_.finished((uint8_t)Stage::Theme)) { Con::printf("theme: dashboard not open\n"); return; }
+        if (argc < 2) updateTheme();
+        else if (strcmp(argv[1], "light") == 0) theme->apply(ThemeManager::Mode::Light);
+        else if (strcmp(argv[1], "dark") == 0) theme->apply(ThemeManager::Mode::Dark);
+        else { Con::printf("theme: light or dark\n"); return; }
+        Con::printf("theme %s\n", theme->current() == ThemeManager::Mode::Dark ? "dark" : "light");
+    }, this);
+    Con::add("profile", "profile [max|balanced|low]: Wi-Fi power profile and UI cadence", [](void* user, uint8_t argc, char** argv) {
+        static const char* const kProfiles[] = { "max", "balanced", "low" };
+        auto* self = static_cast<DevDashM5Core2*>(user);
+        if (argc > 1) {
+            int p = -1;
+            for (uint8_t i = 0; i < 3; ++i) if (strcmp(argv[1], kProfiles[i]) == 0) p = i;
+            if (p < 0) { Con::printf("profile: max, balanced or low\n"); return; }
+            if (!self->boot_.finished((uint8_t)Stage::Radio)) { Con::printf("profile: dashboard not open\n"); return; }
+            if (self->manager_busy_) { Con::printf("profile: a Wi-Fi job is running\n"); return; }
+            self->setPowerProfile(static_cast<PowerProfile>(p));
+        }
+        Con::printf("profile %s, UI refresh %lu ms\n", kProfiles[(int)manager->powerProfile()],
+                    (unsigned long)manager->powerParams().uiRefreshMs);
+    }, this);
+    Con::add("rate", "rate [refresh|sample|heap] [ms]: display refresh, System screen sampling, heap report", [](void* user, uint8_t argc, char** argv) {
+        auto* self = static_cast<DevDashM5Core2*>(user);
+        if (argc == 3) {
+            uint32_t ms = strtoul(argv[2], nullptr, 10);
+            if (strcmp(argv[1], "refresh") == 0 && ms) {
+                // Until the next power profile change
+                if (!self->boot_.finished((uint8_t)Stage::Renderer)) { Con::printf("rate: dashboard not open\n"); return; }
+                renderer->setRefreshPeriod(ms);
+            } else if (strcmp(argv[1], "sample") == 0) {
+                self->monitor_.setPeriod(ms);
+            } else if (strcmp(argv[1], "heap") == 0) {
+                HeapTracker::setReportInterval(ms); // 0 stops it
+            } else {
+                Con::printf("rate: refresh, sample or heap, then ms\n");
+                return;
+            }
+        }
+        Con::printf("sample %lu ms, heap report %lu ms\n",
+                    (unsigned long)self->monitor_.period(), (unsigned long)HeapTracker::reportInterval());
+    }, this);
+}
+#endif // DEVDASH_ENABLE_CONSOLE
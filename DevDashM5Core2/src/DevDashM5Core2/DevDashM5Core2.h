@@ -1,27 +1,80 @@
 #pragma once
 #include "../IDevice.h"
+#include "../DevDashConfig.h"
 #include "ThemeManager.h"
 #include "LVGLRenderer.h"
 #include "WifiManager.h"
+#include "ScreenManager.h"
+#include "BootSequence.h"
+#include "WorkExecutor.h"
+#include "SystemMonitor.h"
+#include "HeapTracker.h"
+#if DEVDASH_ENABLE_SENSORS
 #include "SensorDashboard.h"
-#include <string>
+#endif
+#if DEVDASH_ENABLE_WIFI_UI
+#include "WifiListView.h"
+#include "SnapshotKeyboard.h"
+#endif
+#if DEVDASH_ENABLE_SYSTEM_SCREEN
+#include "SystemScreen.h"
+#endif
 
 #include <lvgl.h> // use LVGL types directly to avoid forward-decl/typedef conflicts
 
-class DevDashM5Core2 : public IDevice {
+class DevDashM5Core2 final : public IDevice {
 public:
+    /** Name DevDash::begin() accepts for this device */
+    static constexpr const char* kName = "M5Core2";
+
+    DevDashM5Core2();
+    ~DevDashM5Core2() override;
+
+    bool prepare() override;
     bool begin() override;
     void loop() override;
+    void suspend(bool keepState) override;
+    void setRegion(int16_t x, int16_t y, int16_t w, int16_t h) override;
+    void setLoopBudget(uint32_t us) override;
     void destroy() override;
 
     // UI actions
+#if DEVDASH_ENABLE_WIFI_UI
     void showPasswordModal(const char* ssid);
     void hidePasswordModal();
+#endif
+#if DEVDASH_ENABLE_DIAGNOSTICS
+    void showDiagnostics();
+    void hideDiagnostics();
+    void runDiagnostics();
+#endif
+
+    /** Switch WiFi power profile and the matching UI cadence */
+    void setPowerProfile(PowerProfile p);
+
+#if DEVDASH_ENABLE_DIAGNOSTICS
+    /**
+     * Measure current draw and ping latency under each profile (~30 s) on
+     * the worker; the results go to the diagnostics modal and the log.
+     * Refused while another job owns the Wi-Fi manager.
+     */
+    void measurePowerProfiles();
+#endif
+#if DEVDASH_ENABLE_WIFI_UI
     void populateWifiList(lv_obj_t* panel);
+#endif
 
+    /** LVGL heap the cached screens may hold before the least recent are rebuilt on demand */
+    void setScreenMemoryBudget(size_t bytes) { screens_.setMemoryBudget(bytes); }
+    ScreenManager& screens() { return screens_; }
+    /** CPU, frame rate, loop() latency and stack counters; setPeriod() sets the System screen's rate too */
+    SystemMonitor& monitor() { return monitor_; }
+
+#if DEVDASH_ENABLE_WIFI_UI
     // Backward-compatible handlers (not required by the new setup)
     void wifiRowEventHandler(lv_event_t* e);
     void connectBtnEventHandler(lv_event_t* e);
+#endif
 
     static void updateTheme();
 
@@ -30,25 +83,113 @@ private:
     static ThemeManager* theme;
     static LVGLRenderer* renderer;
     static WifiManager*  manager;
+#if DEVDASH_ENABLE_SENSORS
     static SensorDashboard* sensorDashboard;
+#endif
+
+    // Start-up stages, in BootSequence ids; storage and credentials run on
+    // the other core. prepare() runs one slice per call, begin() the rest.
+    enum class Stage : uint8_t {
+        Renderer, Theme, Storage, Credentials, Screens, Prebuild, Sensors, Radio, Scan
+    };
+    BootSequence boot_;
+    bool  warm_           = false; // prepare() ran ahead of begin()
+    bool  finishing_      = false; // begin() is running what prepare() left
+    int   prebuilt_       = 0;     // last screen id built ahead of time
+    bool  core_ready_     = false; // Wi-Fi, credentials and sensors; kept over suspend()
+
+    // Per-loop budget (0 = unbounded); work that does not fit waits a call
+    uint32_t loop_budget_us_ = 0;
+    bool     list_dirty_     = false; // scan results not shown yet
 
-    // Persistent UI elements (created once, reused)
+    // Blocking calls run on the other core; completions come back in loop()
+    WorkExecutor work_;
+    // A job owns the WifiManager until it completes. Everything but
+    // getScannedNetworks() (double-buffered) checks this first, starting
+    // and polling scans included.
+    bool     manager_busy_   = false;
+
+    // Counters behind the System screen, sampled from loop()
+    SystemMonitor monitor_;
+
+#if DEVDASH_ENABLE_CONSOLE
+    // Baseline the console's heap command diffs against
+    HeapTracker::Snapshot heap_mark_;
+    bool heap_marked_ = false;
+#endif
+
+    // Compact UI state parked in PSRAM by suspend(true)
+    struct ParkedState;
+    ParkedState* parked_  = nullptr;
+
+    // Screens (Wi-Fi, Sensors, System as enabled), built on first visit
+    ScreenManager screens_;
+#if DEVDASH_ENABLE_SYSTEM_SCREEN
+    SystemScreen system_screen_;
+#endif
+
+#if DEVDASH_ENABLE_WIFI_UI
+    // Wi-Fi screen elements; null while that screen is evicted
     lv_obj_t* refresh_btn_      = nullptr;
     lv_obj_t* wifi_icon_        = nullptr;
+    lv_obj_t* signal_bars_      = nullptr;
+    uint8_t   shown_bars_       = 0xFF;
+    wl_status_t shown_status_   = WL_IDLE_STATUS;
     lv_obj_t* wifi_panel_       = nullptr;
+    WifiListView wifi_list_;
+
+    // Modals live on the top layer and outlive screen evictions
 
     lv_obj_t* password_modal_   = nullptr; // modal container (hidden/shown)
-    lv_obj_t* password_keyboard_= nullptr; // on-screen keyboard (hidden/shown)
+    SnapshotKeyboard password_keyboard_;   // on-screen keyboard (hidden/shown)
     lv_obj_t* password_textarea_= nullptr; // input field
     lv_obj_t* ssid_label_       = nullptr; // label inside modal
     lv_obj_t* show_pw_btn_      = nullptr; // eye toggle
     lv_obj_t* connect_btn_      = nullptr;
     lv_obj_t* cancel_btn_       = nullptr;
+#endif
+
+#if DEVDASH_ENABLE_DIAGNOSTICS
+    lv_obj_t* diag_btn_         = nullptr; // header button
+    lv_obj_t* diag_modal_       = nullptr;
+    lv_obj_t* diag_endpoint_    = nullptr;
+    lv_obj_t* diag_results_     = nullptr;
+    lv_obj_t* diag_profile_     = nullptr; // power profile dropdown
+    WorkExecutor::JobId bench_job_ = 0;
+    WorkExecutor::JobId power_job_ = 0;  // owns the manager while it runs
+#endif
 
+#if DEVDASH_ENABLE_WIFI_UI
     // State
-    std::string current_ssid_;
+    SsidString current_ssid_;
+    SavedWiFiNetwork connecting_;  // credentials the connect job is using
+#endif
 
     // Helpers
+    BootSequence::Result runStage_(Stage stage, bool warm); // one slice of a start-up stage
+    void addScreens_();
+    void parkState_();
+    int  unparkState_();        // restores parked state, returns the screen to show
+    void releaseModals_();
+    void loopOnce_(uint32_t start);
+#if DEVDASH_ENABLE_CONSOLE
+    void addCommands_();        // perf, heap, Wi-Fi, theme and rate commands on the console
+#endif
+    bool overBudget_(uint32_t start) const {
+        return loop_budget_us_ && micros() - start >= loop_budget_us_;
+    }
+    // Started and not suspended, so loop() polls the manager, and no job owns it
+    bool wifiIdle_() const { return boot_.finished((uint8_t)Stage::Radio) && !manager_busy_; }
+#if DEVDASH_ENABLE_WIFI_UI
+    void connect_(const char* ssid, const char* password);
+    void scanInBackground_();
+    void buildWifiScreen_(lv_obj_t* screen);
+    void releaseWifiScreen_();
     void ensurePasswordUI_();   // lazy-create modal + keyboard once
     void resetPasswordUI_();    // update SSID label, reset TA each time
+    void selectNetwork_(const char* ssid); // row click: connect if saved, else ask for password
+#endif
+#if DEVDASH_ENABLE_DIAGNOSTICS
+    void ensureDiagUI_();       // lazy-create diagnostics modal once
+#endif
 };
\ No newline at end of file
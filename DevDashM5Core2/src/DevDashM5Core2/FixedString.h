@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * NUL-terminated string with inline room for N characters. Copies and
+ * assignments never touch the heap; longer input is truncated, which
+ * assign() reports.
+ */
+template <size_t N>
+class FixedString {
+public:
+    static_assert(N < 256, "the length is kept in a byte");
+    static constexpr size_t kCapacity = N;
+
+    FixedString() { _buf[0] = '\0'; }
+    FixedString(const char* s) { assign(s); }
+
+    /** False if `s` did not fit and was truncated */
+    bool assign(const char* s, size_t len) {
+        bool fits = len <= N;
+        if (!fits) len = N;
+        if (len) memcpy(_buf, s, len);
+        _buf[len] = '\0';
+        _len = (uint8_t)len;
+        return fits;
+    }
+    bool assign(const char* s) { return s ? assign(s, strnlen(s, N + 1)) : assign("", 0); }
+
+    FixedString& operator=(const char* s) { assign(s); return *this; }
+
+    void clear() { _len = 0; _buf[0] = '\0'; }
+
+    const char* c_str() const { return _buf; }
+    size_t length() const { return _len; }
+    bool empty() const { return _len == 0; }
+
+    bool equals(const char* s, size_t len) const { return len == _len && memcmp(_buf, s, len) == 0; }
+
+    bool operator==(const char* s) const { return s && strcmp(_buf, s) == 0; }
+    bool operator!=(const char* s) const { return !(*this == s); }
+    template <size_t M>
+    bool operator==(const FixedString<M>& o) const { return equals(o.c_str(), o.length()); }
+    template <size_t M>
+    bool operator!=(const FixedString<M>& o) const { return !equals(o.c_str(), o.length()); }
+
+private:
+    uint8_t _len = 0;
+    char    _buf[N + 1];
+};
+
+template <size_t N>
+constexpr size_t FixedString<N>::kCapacity;
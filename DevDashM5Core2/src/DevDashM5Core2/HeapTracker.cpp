@@ -0,0 +1,316 @@
+#include "HeapTracker.h"
+#include "AllocCounter.h"
+#include "../DevDashLog.h"
+#include <esp_heap_caps.h>
+#include <lvgl.h>
+
+constexpr uint8_t  HeapTracker::kTags;
+constexpr uint8_t  HeapTracker::kMaxScopes;
+constexpr uint16_t HeapTracker::kTableSlots;
+constexpr uint32_t HeapTracker::kDefaultReportMs;
+
+uint32_t              HeapTracker::reportMs = HeapTracker::kDefaultReportMs;
+uint32_t              HeapTracker::lastReportMs = 0;
+HeapTracker::Snapshot HeapTracker::lastReport;
+bool                  HeapTracker::reported = false;
+
+static const char* const kTagNames[] = { "other", "ui", "wifi", "storage", "sensors", "work" };
+
+const char* HeapTracker::tagName(Tag tag) {
+    uint8_t i = static_cast<uint8_t>(tag);
+    return i < kTags ? kTagNames[i] : "?";
+}
+
+#if DEVDASH_HEAP_TRACKING
+/** One tagged block; size in the low 24 bits, tag in the high 8 */
+struct TrackedBlock {
+    void*    ptr;
+    uint32_t sizeTag;
+};
+
+static portMUX_TYPE trackLock = portMUX_INITIALIZER_UNLOCKED;
+static TrackedBlock* table = nullptr;         // kTableSlots, linear probing
+static volatile uint16_t tableUsed = 0;
+static uint32_t untracked = 0;
+static HeapTracker::TagStats tagStats[HeapTracker::kTags];
+static TaskHandle_t volatile scopeTask[HeapTracker::kMaxScopes];
+static volatile uint8_t scopeTag[HeapTracker::kMaxScopes];
+static volatile uint8_t scopesAlive = 0;
+
+static const uint32_t kSlotMask = HeapTracker::kTableSlots - 1;
+static const uint32_t kMaxUsed = HeapTracker::kTableSlots * 3 / 4; // keeps probes short
+
+static inline uint32_t home(const void* p) {
+    return (((uint32_t)(uintptr_t)p >> 3) * 2654435761u) & kSlotMask;
+}
+
+/** Tag of the calling task's innermost scope; 0 (Other) outside any */
+static inline uint8_t currentTag() {
+    if (!scopesAlive) return 0;
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    for (uint8_t i = 0; i < HeapTracker::kMaxScopes; ++i) {
+        if (scopeTask[i] == self) return scopeTag[i];
+    }
+    return 0;
+}
+
+// Table helpers run under trackLock
+
+static void insertLocked(void* p, size_t size, uint8_t tag) {
+    HeapTracker::TagStats& st = tagStats[tag];
+    ++st.allocs;
+    if (!table || tableUsed >= kMaxUsed) {
+        ++untracked;
+        return;
+    }
+    uint32_t i = home(p);
+    while (table[i].ptr) {
+        if (table[i].ptr == p) {
+            // Freed behind the wrappers' back (heap_caps_free); drop the stale entry
+            tagStats[table[i].sizeTag >> 24].live -= table[i].sizeTag & 0xFFFFFF;
+            --tableUsed;
+            break;
+        }
+        i = (i + 1) & kSlotMask;
+    }
+    if (size > 0xFFFFFF) size = 0xFFFFFF;
+    table[i].ptr = p;
+    table[i].sizeTag = (uint32_t)size | ((uint32_t)tag << 24);
+    ++tableUsed;
+    st.live += size;
+    if (st.live > st.peak) st.peak = st.live;
+}
+
+/** Forget p if tagged; returns its tag, or 0 */
+static uint8_t removeLocked(void* p) {
+    uint32_t i = home(p);
+    while (table[i].ptr != p) {
+        if (!table[i].ptr) return 0;
+        i = (i + 1) & kSlotMask;
+    }
+    uint8_t tag = table[i].sizeTag >> 24;
+    HeapTracker::TagStats& st = tagStats[tag];
+    st.live -= table[i].sizeTag & 0xFFFFFF;
+    ++st.frees;
+    --tableUsed;
+    // Backward-shift deletion: pull later entries of the run into the gap so
+    // lookups never stop early at it
+    for (uint32_t j = i;;) {
+        j = (j + 1) & kSlotMask;
+        if (!table[j].ptr) break;
+        uint32_t k = home(table[j].ptr);
+        bool stays = (i <= j) ? (i < k && k <= j) : (i < k || k <= j);
+        if (stays) continue;
+        table[i] = table[j];
+        i = j;
+    }
+    table[i].ptr = nullptr;
+    return tag;
+}
+
+void HeapTracker::onAlloc_(void* p, size_t size) {
+    if (!p) return;
+    uint8_t tag = currentTag();
+    if (!tag) return;
+    portENTER_CRITICAL(&trackLock);
+    insertLocked(p, size, tag);
+    portEXIT_CRITICAL(&trackLock);
+}
+
+void HeapTracker::onFree_(void* p) {
+    if (!p || !tableUsed) return;
+    portENTER_CRITICAL(&trackLock);
+    removeLocked(p);
+    portEXIT_CRITICAL(&trackLock);
+}
+
+void HeapTracker::onRealloc_(void* from, void* to, size_t size) {
+    uint8_t tag = currentTag();
+    if (!tag && !tableUsed) return;
+    portENTER_CRITICAL(&trackLock);
+    // A resized block keeps the tag it was allocated under
+    uint8_t was = (from && tableUsed) ? removeLocked(from) : 0;
+    if (was) tag = was;
+    if (to && tag) insertLocked(to, size, tag);
+    portEXIT_CRITICAL(&trackLock);
+}
+
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t n, size_t size);
+void* __real_realloc(void* p, size_t size);
+void  __real_free(void* p);
+
+void* __wrap_malloc(size_t size) {
+    AllocCounter::onAlloc_();
+    void* p = __real_malloc(size);
+    HeapTracker::onAlloc_(p, size);
+    return p;
+}
+
+void* __wrap_calloc(size_t n, size_t size) {
+    AllocCounter::onAlloc_();
+    void* p = __real_calloc(n, size);
+    HeapTracker::onAlloc_(p, n * size);
+    return p;
+}
+
+void* __wrap_realloc(void* p, size_t size) {
+    AllocCounter::onAlloc_();
+    void* q = __real_realloc(p, size);
+    // On failure the old block is untouched; realloc(p, 0) frees it
+    if (q || !size) HeapTracker::onRealloc_(p, q, size);
+    return q;
+}
+
+void __wrap_free(void* p) {
+    HeapTracker::onFree_(p);
+    __real_free(p);
+}
+}
+
+HeapTracker::Scope::Scope(Tag tag) {
+    if (!table) {
+        // First use; heap_caps_malloc is not wrapped, so this is not tracked
+        size_t bytes = sizeof(TrackedBlock) * kTableSlots;
+        void* mem = heap_caps_calloc(1, bytes, MALLOC_CAP_SPIRAM);
+        if (!mem) mem = heap_caps_calloc(1, bytes, MALLOC_CAP_INTERNAL);
+        portENTER_CRITICAL(&trackLock);
+        if (!table) { table = static_cast<TrackedBlock*>(mem); mem = nullptr; }
+        portEXIT_CRITICAL(&trackLock);
+        if (mem) heap_caps_free(mem); // another task got there first
+    }
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    int8_t open = -1;
+    portENTER_CRITICAL(&trackLock);
+    for (uint8_t i = 0; i < kMaxScopes; ++i) {
+        if (scopeTask[i] == self) { _slot = (int8_t)i; break; }
+        if (!scopeTask[i] && open < 0) open = (int8_t)i;
+    }
+    if (_slot >= 0) {
+        _prev = static_cast<Tag>(scopeTag[_slot]);
+        scopeTag[_slot] = static_cast<uint8_t>(tag);
+    } else if (open >= 0) {
+        _slot = open;
+        scopeTag[_slot] = static_cast<uint8_t>(tag);
+        scopeTask[_slot] = self;
+        ++scopesAlive;
+    }
+    portEXIT_CRITICAL(&trackLock);
+}
+
+HeapTracker::Scope::~Scope() {
+    if (_slot < 0) return;
+    portENTER_CRITICAL(&trackLock);
+    if (_prev == Tag::Other) {
+        scopeTask[_slot] = nullptr;
+        --scopesAlive;
+    } else {
+        scopeTag[_slot] = static_cast<uint8_t>(_prev);
+    }
+    portEXIT_CRITICAL(&trackLock);
+}
+#else
+HeapTracker::Scope::Scope(Tag) {}
+HeapTracker::Scope::~Scope() {}
+void HeapTracker::onAlloc_(void*, size_t) {}
+void HeapTracker::onFree_(void*) {}
+void HeapTracker::onRealloc_(void*, void*, size_t) {}
+#endif
+
+static void readRegion(HeapTracker::Region& r, uint32_t caps) {
+    multi_heap_info_t info;
+    heap_caps_get_info(&info, caps);
+    r.size = info.total_free_bytes + info.total_allocated_bytes;
+    r.free = info.total_free_bytes;
+    r.minFree = info.minimum_free_bytes;
+    r.largest = info.largest_free_block;
+    r.fragPct = r.free ? (uint8_t)(100 - (uint64_t)r.largest * 100 / r.free) : 0;
+}
+
+void HeapTracker::snapshot(Snapshot& out, bool lvgl) {
+    memset(&out, 0, sizeof(out));
+    out.ms = millis();
+    readRegion(out.internal, MALLOC_CAP_INTERNAL);
+    readRegion(out.psram, MALLOC_CAP_SPIRAM);
+
+    if (lvgl) {
+        lv_mem_monitor_t mon;
+        lv_mem_monitor(&mon);
+        out.lvgl.size = mon.total_size;
+        out.lvgl.free = mon.free_size;
+        out.lvgl.minFree = mon.total_size - mon.max_used;
+        out.lvgl.largest = mon.free_biggest_size;
+        out.lvgl.fragPct = mon.frag_pct;
+    }
+
+#if DEVDASH_HEAP_TRACKING
+    portENTER_CRITICAL(&trackLock);
+    memcpy(out.tags, tagStats, sizeof(out.tags));
+    out.untracked = untracked;
+    portEXIT_CRITICAL(&trackLock);
+#endif
+    // Everything else in use, leaving out the LVGL pool shown on its own
+    uint32_t used = (out.internal.size - out.internal.free) + (out.psram.size - out.psram.free);
+    for (uint8_t i = 1; i < kTags; ++i) used -= min(used, out.tags[i].live);
+    out.tags[0].live = used - min(used, out.lvgl.size);
+}
+
+void HeapTracker::print(const Snapshot& s, const Snapshot* since) {
+    const Snapshot& b = since ? *since : s;
+    if (since) {
+        DD_LOGI(Core, "Heap at %lu s, changes since %lu s:", (unsigned long)(s.ms / 1000),
+                (unsigned long)(since->ms / 1000));
+    } else {
+        DD_LOGI(Core, "Heap at %lu s:", (unsigned long)(s.ms / 1000));
+    }
+    const Region* regions[] = { &s.internal, &s.psram, &s.lvgl };
+    const Region* before[]  = { &b.internal, &b.psram, &b.lvgl };
+    static const char* const kRegionNames[] = { "internal", "psram", "lvgl" };
+    for (uint8_t i = 0; i < 3; ++i) {
+        const Region& r = *regions[i];
+        if (!r.size) continue;
+        DD_LOGI(Core, "  %-8s %u of %u B free (%+d), min %u, largest %u (%+d), %u%% frag", kRegionNames[i],
+                (unsigned)r.free, (unsigned)r.size, (int)(r.free - before[i]->free), (unsigned)r.minFree,
+                (unsigned)r.largest, (int)(r.largest - before[i]->largest), (unsigned)r.fragPct);
+    }
+    DD_LOGI(Core, "  other    %u B live (%+d)%s", (unsigned)s.tags[0].live,
+            (int)(s.tags[0].live - b.tags[0].live), tracking() ? ", untagged" : ", tagging off");
+    if (!tracking()) return;
+    for (uint8_t i = 1; i < kTags; ++i) {
+        const TagStats& t = s.tags[i];
+        const TagStats& o = b.tags[i];
+        DD_LOGI(Core, "  %-8s %u B live (%+d), peak %u, %u blocks, %u allocs (+%u)", kTagNames[i],
+                (unsigned)t.live, (int)(t.live - o.live), (unsigned)t.peak, (unsigned)(t.allocs - t.frees),
+                (unsigned)t.allocs, (unsigned)(t.allocs - o.allocs));
+    }
+    if (s.untracked) DD_LOGW(Core, "  %u tagged allocations untracked (table full)", (unsigned)s.untracked);
+}
+
+size_t HeapTracker::format(const Snapshot& s, const Snapshot* since, char* out, size_t len) {
+    const Snapshot& b = since ? *since : s;
+    size_t n = snprintf(out, len,
+        "Internal  %u KB free, largest %u KB, %u%% frag\n"
+        "PSRAM     %u KB free, largest %u KB, %u%% frag\n",
+        (unsigned)(s.internal.free / 1024), (unsigned)(s.internal.largest / 1024), (unsigned)s.internal.fragPct,
+        (unsigned)(s.psram.free / 1024), (unsigned)(s.psram.largest / 1024), (unsigned)s.psram.fragPct);
+    if (!tracking()) return min(n, len);
+    for (uint8_t i = 1; i < kTags && n < len; ++i) {
+        const TagStats& t = s.tags[i];
+        n += snprintf(out + n, len - n, "  %-8s %u B (%+d), peak %u\n", kTagNames[i],
+                      (unsigned)t.live, (int)(t.live - b.tags[i].live), (unsigned)t.peak);
+    }
+    return min(n, len);
+}
+
+void HeapTracker::loop() {
+    if (!reportMs) return;
+    uint32_t now = millis();
+    if (reported && now - lastReportMs < reportMs) return;
+    Snapshot s;
+    snapshot(s);
+    print(s, reported ? &lastReport : nullptr);
+    lastReport = s;
+    lastReportMs = now;
+    reported = true;
+}
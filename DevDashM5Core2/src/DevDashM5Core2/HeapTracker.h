@@ -0,0 +1,97 @@
+#pragma once
+
+#include <Arduino.h>
+#include "../DevDashConfig.h"
+
+/**
+ * Heap use per subsystem, plus free space and fragmentation per region.
+ *
+ * A Scope tags the allocations its task makes while it is alive; the
+ * tracker keeps each tagged block's size in a fixed table until it is
+ * freed, so every tag has live bytes, peak bytes and allocation counts.
+ * Untagged allocations cost one check and are reported together as Other
+ * (heap in use minus everything tagged and the LVGL pool).
+ *
+ * Region figures (internal RAM, PSRAM and the LVGL pool) are always
+ * available. Tagging wraps the allocator at link time and needs
+ *   -D DEVDASH_HEAP_TRACKING=1 -Wl,--wrap=malloc -Wl,--wrap=calloc -Wl,--wrap=realloc -Wl,--wrap=free
+ * in build_flags; without it tracking() is false and tag figures are 0.
+ *
+ * Snapshots are plain values: keep one and pass it to print() or format()
+ * later to see what changed since.
+ */
+class HeapTracker {
+public:
+    enum class Tag : uint8_t { Other, Ui, Wifi, Storage, Sensors, Work, Count };
+
+    static constexpr uint8_t  kTags            = static_cast<uint8_t>(Tag::Count);
+    static constexpr uint8_t  kMaxScopes       = 8;      // tasks inside a scope at once
+    static constexpr uint16_t kTableSlots      = 1024;   // tagged blocks, power of two
+    static constexpr uint32_t kDefaultReportMs = 10UL * 60 * 1000;
+
+    struct TagStats {
+        uint32_t live;    // bytes
+        uint32_t peak;    // bytes
+        uint32_t allocs;
+        uint32_t frees;
+    };
+
+    struct Region {
+        uint32_t size;
+        uint32_t free;
+        uint32_t minFree;   // low-water mark since boot
+        uint32_t largest;   // largest free block
+        uint8_t  fragPct;   // 100 - largest * 100 / free
+    };
+
+    struct Snapshot {
+        uint32_t ms;
+        TagStats tags[kTags];
+        Region   internal;
+        Region   psram;
+        Region   lvgl;
+        uint32_t untracked; // tagged allocations the full table could not hold
+    };
+
+    /** Tags the calling task's allocations until destroyed; nests */
+    class Scope {
+    public:
+        explicit Scope(Tag tag);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        int8_t _slot = -1;
+        Tag    _prev = Tag::Other;
+    };
+
+    static bool tracking() { return DEVDASH_HEAP_TRACKING != 0; }
+    static const char* tagName(Tag tag);
+
+    /** lvgl false leaves the LVGL region 0, for when lv_init() has not run */
+    static void snapshot(Snapshot& out, bool lvgl = true);
+    /** Log a snapshot, with changes since an earlier one if given */
+    static void print(const Snapshot& s, const Snapshot* since = nullptr);
+    /** Compact multi-line text for on-device display */
+    static size_t format(const Snapshot& s, const Snapshot* since, char* out, size_t len);
+
+    /** Log a report, diffed against the previous one, every interval; 0 stops it */
+    static void setReportInterval(uint32_t ms) { reportMs = ms; }
+    static uint32_t reportInterval() { return reportMs; }
+    /** Call from the main loop; cheap until a report is due */
+    static void loop();
+
+    /** Called by the allocator hooks; nothing else should */
+    static void onAlloc_(void* p, size_t size);
+    static void onFree_(void* p);
+    static void onRealloc_(void* from, void* to, size_t size);
+
+private:
+    HeapTracker() = delete;
+
+    static uint32_t reportMs;
+    static uint32_t lastReportMs;
+    static Snapshot lastReport;
+    static bool     reported;
+};
@@ -3,6 +3,8 @@
 #include <Arduino.h>
 #include "draw/sw/lv_draw_sw.h" // Needed for lv_draw_sw_rgb565_swap
 #include "LVGLRenderer.h"
+#include "lv_mem_pool.h"
+#include "../DevDashLog.h"
 
 // Font (assuming enabled in lv_conf.h)
 // extern lv_font_t lv_font_montserrat_18;
@@ -13,17 +15,35 @@
 #define DRAW_BUF_SIZE (TFT_HOR_RES * 40 * (LV_COLOR_DEPTH / 8)) // Reduced buffer to save RAM
 
 uint32_t* draw_buf;
+static uint32_t first_frame_ms = 0;
+static void* lv_pool = nullptr;
+
+/* LVGL's heap: internal RAM for speed, PSRAM if the host left no room for it */
+extern "C" void* devdash_lv_pool_alloc(size_t size) {
+    if (lv_pool) return lv_pool;
+    lv_pool = heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!lv_pool) {
+        DD_LOGW(Lvgl, "LVGL pool: no %u B internal block, using PSRAM", (unsigned)size);
+        lv_pool = heap_caps_malloc(size, MALLOC_CAP_SPIRAM);
+    }
+    return lv_pool;
+}
 
 /* LVGL logging (optional) */
 #if LV_USE_LOG != 0
 void my_print(lv_log_level_t level, const char *buf)
 {
-    LV_UNUSED(level);
-    Serial.println(buf);
-    Serial.flush();
+    // Queued like any other record, so this no longer blocks the render loop
+    if (level == LV_LOG_LEVEL_ERROR) DD_LOGE(Lvgl, "%s", buf);
+    else if (level == LV_LOG_LEVEL_WARN) DD_LOGW(Lvgl, "%s", buf);
+    else if (level == LV_LOG_LEVEL_USER) DD_LOGI(Lvgl, "%s", buf);
+    else DD_LOGD(Lvgl, "%s", buf);
 }
 #endif
 
+LVGLRenderer::FlushStats LVGLRenderer::flush_stats;
+lv_area_t LVGLRenderer::region = { 0, 0, TFT_HOR_RES - 1, TFT_VER_RES - 1 };
+
 LVGLRenderer::LVGLRenderer() {}
 
 LVGLRenderer::~LVGLRenderer() {
@@ -31,6 +51,12 @@ LVGLRenderer::~LVGLRenderer() {
 }
 
 bool LVGLRenderer::begin() {
+    if (lv_is_initialized()) return true;
+    // lv_init() cannot report a missing pool, so take it first
+    if (!devdash_lv_pool_alloc(LV_MEM_SIZE)) {
+        DD_LOGE(Lvgl, "LVGL pool alloc failed.");
+        return false;
+    }
     lv_init();
     lv_tick_set_cb(LVGLRenderer::tick);
 
@@ -38,13 +64,14 @@ bool LVGLRenderer::begin() {
     lv_log_register_print_cb(my_print);
 #endif
 
-    lv_display_t *disp = lv_display_create(TFT_HOR_RES, TFT_VER_RES);
+    lv_display_t *disp = lv_display_create(lv_area_get_width(&region), lv_area_get_height(&region));
     lv_display_set_flush_cb(disp, LVGLRenderer::display_flush);
 
     draw_buf = (uint32_t*)heap_caps_malloc(DRAW_BUF_SIZE, MALLOC_CAP_SPIRAM);
     if (!draw_buf) {
-        Serial.println("Draw buffer alloc failed.");
-        while (1);
+        DD_LOGE(Lvgl, "Draw buffer alloc failed.");
+        destroy();
+        return false;
     }
     lv_display_set_buffers(disp, draw_buf, nullptr, DRAW_BUF_SIZE, LV_DISPLAY_RENDER_MODE_PARTIAL);
 
@@ -58,8 +85,33 @@ void LVGLRenderer::loop() {
     lv_timer_handler();
 }
 
-void LVGLRenderer::destroy() {
+void LVGLRenderer::setRefreshPeriod(uint32_t ms) {
+    lv_display_t* disp = lv_display_get_default();
+    if (disp) lv_timer_set_period(lv_display_get_refr_timer(disp), ms);
+    for (lv_indev_t* indev = lv_indev_get_next(nullptr); indev; indev = lv_indev_get_next(indev)) {
+        lv_timer_set_period(lv_indev_get_read_timer(indev), ms);
+    }
+}
+
+void LVGLRenderer::setRegion(int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (w <= 0 || h <= 0) {
+        lv_area_set(&region, 0, 0, TFT_HOR_RES - 1, TFT_VER_RES - 1);
+        return;
+    }
+    // Clamp to the panel
+    lv_area_set(&region, LV_MAX(x, 0), LV_MAX(y, 0), LV_MIN(x + w, TFT_HOR_RES) - 1, LV_MIN(y + h, TFT_VER_RES) - 1);
+}
 
+void LVGLRenderer::destroy() {
+    if (!lv_is_initialized()) return;
+    // Deletes the display with every screen and layer, the input devices and
+    // all timers; callers release their own pointers into LVGL beforehand
+    lv_deinit();
+    heap_caps_free(draw_buf);
+    draw_buf = nullptr;
+    heap_caps_free(lv_pool);
+    lv_pool = nullptr;
+    first_frame_ms = 0;
 }
 
 /* Flush callback: push LVGL buffer to screen */
@@ -70,7 +122,17 @@ void LVGLRenderer::display_flush(lv_display_t *disp, const lv_area_t *area, uint
     // Swap color order to match M5Core2's RGB565 expectations
     lv_draw_sw_rgb565_swap(px_map, width * height);
 
-    M5.Lcd.pushImage(area->x1, area->y1, width, height, (uint16_t *)px_map);
+    M5.Lcd.pushImage(region.x1 + area->x1, region.y1 + area->y1, width, height, (uint16_t *)px_map);
+    ++flush_stats.areas;
+    flush_stats.pixels += width * height;
+    if (lv_display_flush_is_last(disp)) {
+        ++flush_stats.frames;
+        flush_stats.lastFrameUs = micros();
+        if (!first_frame_ms) {
+            first_frame_ms = millis();
+            DD_LOGI(Lvgl, "LVGL: first frame at %lu ms", (unsigned long)first_frame_ms);
+        }
+    }
     lv_display_flush_ready(disp);
 }
 
@@ -78,10 +140,11 @@ void LVGLRenderer::display_flush(lv_display_t *disp, const lv_area_t *area, uint
 /* Read M5Core2 touch input */
 void LVGLRenderer::touchpad_read(lv_indev_t *indev, lv_indev_data_t *data) {
     TouchPoint_t tp = M5.Touch.getPressPoint();
-    if (tp.x >= 0 && tp.y >= 0) {
+    lv_point_t p = { tp.x, tp.y };
+    if (tp.x >= 0 && tp.y >= 0 && lv_area_is_point_on(&region, &p, 0)) {
         data->state = LV_INDEV_STATE_PRESSED;
-        data->point.x = tp.x;
-        data->point.y = tp.y;
+        data->point.x = tp.x - region.x1;
+        data->point.y = tp.y - region.y1;
     } else {
         data->state = LV_INDEV_STATE_RELEASED;
     }
@@ -12,7 +12,44 @@ public:
     bool begin();
     void loop();
     void destroy();
+
+    /** Display refresh and touch read period */
+    void setRefreshPeriod(uint32_t ms);
+
+    /**
+     * Render into this part of the panel only (call before begin()); LVGL
+     * sees a display of w x h, and touches outside the region are ignored.
+     * A zero size means the full panel.
+     */
+    static void setRegion(int16_t x, int16_t y, int16_t w, int16_t h);
+
+    /** Totals pushed to the panel since the last reset */
+    struct FlushStats {
+        uint32_t frames = 0;
+        uint32_t areas = 0;
+        uint32_t pixels = 0;
+        uint32_t lastFrameUs = 0; // micros() when the last frame finished
+    };
+    static const FlushStats& flushStats() { return flush_stats; }
+    static void resetFlushStats() { flush_stats = FlushStats(); }
+
+    /**
+     * Holds LVGL's global (recursive) lock for a scope. LVGL renders with a
+     * draw unit per core, so any task other than the one calling loop()
+     * must hold it while using the LVGL API; loop() itself may nest it.
+     */
+    struct Lock {
+        Lock() { lv_lock(); }
+        ~Lock() { lv_unlock(); }
+        Lock(const Lock&) = delete;
+        Lock& operator=(const Lock&) = delete;
+    };
+
     static void display_flush(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map);
     static void touchpad_read(lv_indev_t *indev, lv_indev_data_t *data);
     static uint32_t tick(void);
+
+private:
+    static FlushStats flush_stats;
+    static lv_area_t  region;
 };
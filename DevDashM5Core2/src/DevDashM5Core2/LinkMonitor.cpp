@@ -0,0 +1,70 @@
+#include "LinkMonitor.h"
+
+constexpr size_t   LinkMonitor::kHistory;
+constexpr size_t   LinkMonitor::kLossLog;
+constexpr uint32_t LinkMonitor::kLossWindowMs;
+
+LinkMonitor::LinkMonitor() {
+    reset();
+}
+
+void LinkMonitor::reset() {
+    _head = 0;
+    _count = 0;
+    _ewmaQ4 = 0;
+    _weakStreak = 0;
+}
+
+void LinkMonitor::addSample(uint32_t ms, int8_t rssi) {
+    _samples[_head] = { ms, _losses, rssi };
+    _head = (_head + 1) % kHistory;
+    if (_count < kHistory) ++_count;
+
+    // alpha = 1/4
+    int32_t q4 = (int32_t)rssi * 16;
+    _ewmaQ4 = (_count == 1) ? q4 : _ewmaQ4 + (q4 - _ewmaQ4) / 4;
+
+    if (smoothedRssi() < _weakDbm) {
+        if (_weakStreak < 255) ++_weakStreak;
+    } else {
+        _weakStreak = 0;
+    }
+}
+
+void LinkMonitor::noteLinkLoss() {
+    // One writer (the event task); the entry is in place before the count moves
+    _lossMs[_losses % kLossLog] = millis();
+    _losses = _losses + 1;
+}
+
+int8_t LinkMonitor::smoothedRssi() const {
+    return _count ? (int8_t)(_ewmaQ4 / 16) : 0;
+}
+
+uint8_t LinkMonitor::bars() const {
+    return _count ? barsFor(smoothedRssi()) : 0;
+}
+
+uint8_t LinkMonitor::barsFor(int32_t r) {
+    if (r >= -55) return 4;
+    if (r >= -65) return 3;
+    if (r >= -75) return 2;
+    if (r >= -85) return 1;
+    return 0;
+}
+
+float LinkMonitor::lossRate() const {
+    uint32_t now = millis();
+    uint32_t losses = _losses;
+    size_t kept = losses < kLossLog ? losses : kLossLog;
+    size_t recent = 0;
+    for (size_t i = 0; i < kept; ++i) {
+        if (now - _lossMs[(losses - 1 - i) % kLossLog] <= kLossWindowMs) ++recent;
+    }
+    return (float)recent * 60000.0f / (float)kLossWindowMs;
+}
+
+const LinkMonitor::Sample& LinkMonitor::sample(size_t i) const {
+    size_t oldest = (_head + kHistory - _count) % kHistory;
+    return _samples[(oldest + i) % kHistory];
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * Rolling view of the station link: a short RSSI history, an EWMA of it,
+ * and a log of link-loss events (beacon timeouts, AP-initiated drops).
+ *
+ * A loss always ends the connection, so the loss log outlives reset(),
+ * which a reconnect calls; only the RSSI history starts over.
+ */
+class LinkMonitor {
+public:
+    struct Sample {
+        uint32_t ms;
+        uint32_t losses;  // cumulative link losses when sampled
+        int8_t   rssi;
+    };
+
+    static constexpr size_t   kHistory     = 32;
+    static constexpr size_t   kLossLog     = 16;              // most recent losses kept
+    static constexpr uint32_t kLossWindowMs = 5UL * 60 * 1000; // lossRate() looks this far back
+
+    LinkMonitor();
+
+    /** Start a new RSSI history; the loss log is kept */
+    void reset();
+
+    /** Record one RSSI reading */
+    void addSample(uint32_t ms, int8_t rssi);
+
+    /** Count a link-loss event; safe to call from the WiFi event task */
+    void noteLinkLoss();
+
+    /** Exponentially smoothed RSSI in dBm (0 with no samples) */
+    int8_t smoothedRssi() const;
+
+    /** Signal strength as 0..4 bars, from the smoothed RSSI */
+    uint8_t bars() const;
+
+    /** Bar count for a single RSSI reading */
+    static uint8_t barsFor(int32_t rssi);
+
+    /** Consecutive samples whose smoothed RSSI was below the weak threshold */
+    uint8_t weakStreak() const { return _weakStreak; }
+
+    /** Link losses per minute over the last kLossWindowMs, across reconnects */
+    float lossRate() const;
+
+    uint32_t linkLosses() const { return _losses; }
+
+    size_t count() const { return _count; }
+
+    /** i = 0 is the oldest retained sample */
+    const Sample& sample(size_t i) const;
+
+    void setWeakThreshold(int8_t dbm) { _weakDbm = dbm; }
+    int8_t weakThreshold() const { return _weakDbm; }
+
+private:
+    Sample   _samples[kHistory];
+    size_t   _head = 0;
+    size_t   _count = 0;
+    int32_t  _ewmaQ4 = 0;     // dBm in Q4 fixed point
+    uint8_t  _weakStreak = 0;
+    int8_t   _weakDbm = -75;
+    volatile uint32_t _losses = 0;
+    uint32_t _lossMs[kLossLog] = {};  // millis() of loss n at [n % kLossLog]
+};
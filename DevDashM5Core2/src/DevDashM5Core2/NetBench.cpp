@@ -0,0 +1,217 @@
+#include "../DevDashConfig.h"
+#if DEVDASH_ENABLE_DIAGNOSTICS
+#include "NetBench.h"
+#include <WiFi.h>
+#include <WiFiClient.h>
+#include <WiFiUdp.h>
+#include <algorithm>
+
+static const uint8_t kMagic[4] = { 'D', 'D', 'B', '1' };
+static const size_t  kChunk    = 1460;
+
+static void writeRequest(WiFiClient& c, char cmd, uint32_t len) {
+    uint8_t hdr[12];
+    memcpy(hdr, kMagic, 4);
+    hdr[4] = (uint8_t)cmd;
+    hdr[5] = hdr[6] = hdr[7] = 0;
+    for (int i = 0; i < 4; ++i) hdr[8 + i] = (uint8_t)(len >> (8 * i));
+    c.write(hdr, sizeof(hdr));
+}
+
+NetBench::Report NetBench::run(const Config& cfg) {
+    Report r;
+    if (WiFi.status() != WL_CONNECTED) { r.error = "not connected"; return r; }
+    if (!cfg.host.length()) { r.error = "no endpoint"; return r; }
+
+    IPAddress ip;
+    uint32_t t = micros();
+    if (!WiFi.hostByName(cfg.host.c_str(), ip)) { r.error = "DNS failed"; return r; }
+    r.dnsUs = micros() - t;
+
+    gatewayProbe_(cfg.gatewayProbes, cfg.timeoutMs, r.gatewayRtt);
+    udpPing_(ip, cfg.port, cfg.udpPings, cfg.timeoutMs, r.udpRtt);
+
+    if (!tcpDownload_(ip, cfg, r.downloadKbps)) { r.error = "TCP download failed"; return r; }
+    if (!tcpUpload_(ip, cfg, r.uploadKbps))     { r.error = "TCP upload failed"; return r; }
+
+    r.ok = true;
+    return r;
+}
+
+void NetBench::ping(const Config& cfg, uint16_t count, Percentiles& out) {
+    IPAddress ip;
+    if (cfg.host.length() && WiFi.hostByName(cfg.host.c_str(), ip)) {
+        udpPing_(ip, cfg.port, count, cfg.timeoutMs, out);
+    } else {
+        gatewayProbe_(count, cfg.timeoutMs, out);
+    }
+}
+
+bool NetBench::tcpDownload_(const IPAddress& ip, const Config& cfg, float& kbps) {
+    WiFiClient c;
+    if (!c.connect(ip, cfg.port, cfg.timeoutMs)) return false;
+    c.setNoDelay(true);
+
+    uint8_t buf[kChunk];
+    uint32_t start = micros();
+    writeRequest(c, 'D', cfg.tcpBytes);
+
+    uint32_t got = 0;
+    uint32_t lastData = millis();
+    while (got < cfg.tcpBytes) {
+        int n = c.read(buf, sizeof(buf));
+        if (n > 0) { got += n; lastData = millis(); continue; }
+        if (!c.connected() || millis() - lastData > cfg.timeoutMs) break;
+        delay(1);
+    }
+    uint32_t us = micros() - start;
+    c.stop();
+    if (got < cfg.tcpBytes || !us) return false;
+    kbps = (float)got * 8000.0f / (float)us;
+    return true;
+}
+
+bool NetBench::tcpUpload_(const IPAddress& ip, const Config& cfg, float& kbps) {
+    WiFiClient c;
+    if (!c.connect(ip, cfg.port, cfg.timeoutMs)) return false;
+    c.setNoDelay(true);
+
+    uint8_t buf[kChunk];
+    memset(buf, 0xA5, sizeof(buf));
+    uint32_t start = micros();
+    writeRequest(c, 'U', cfg.tcpBytes);
+
+    uint32_t sent = 0;
+    while (sent < cfg.tcpBytes) {
+        size_t n = std::min<uint32_t>(sizeof(buf), cfg.tcpBytes - sent);
+        size_t w = c.write(buf, n);
+        if (!w) { c.stop(); return false; }
+        sent += w;
+    }
+
+    // Throughput is measured to the server's acknowledgement, not to the local send buffer
+    uint8_t ack[4];
+    size_t have = 0;
+    uint32_t waitStart = millis();
+    while (have < sizeof(ack) && millis() - waitStart < cfg.timeoutMs) {
+        int n = c.read(ack + have, sizeof(ack) - have);
+        if (n > 0) have += n;
+        else delay(1);
+    }
+    uint32_t us = micros() - start;
+    c.stop();
+    if (have < sizeof(ack) || !us) return false;
+
+    uint32_t acked = ack[0] | (ack[1] << 8) | (ack[2] << 16) | ((uint32_t)ack[3] << 24);
+    kbps = (float)acked * 8000.0f / (float)us;
+    return acked == cfg.tcpBytes;
+}
+
+void NetBench::udpPing_(const IPAddress& ip, uint16_t port, uint16_t count, uint32_t timeoutMs, Percentiles& out) {
+    WiFiUDP udp;
+    if (!udp.begin(0)) { out.lost = count; return; }
+
+    std::vector<uint32_t> rtts;
+    rtts.reserve(count);
+    uint16_t lost = 0;
+    // Bound each ping so a lossy link cannot stall the run for count * timeout
+    uint32_t perPingMs = std::min<uint32_t>(timeoutMs, 500);
+
+    for (uint16_t seq = 0; seq < count; ++seq) {
+        uint8_t pkt[8];
+        uint32_t sentUs = micros();
+        memcpy(pkt, &seq, sizeof(seq));
+        memcpy(pkt + 4, &sentUs, sizeof(sentUs));
+        udp.beginPacket(ip, port);
+        udp.write(pkt, sizeof(pkt));
+        udp.endPacket();
+
+        bool answered = false;
+        while (micros() - sentUs < perPingMs * 1000) {
+            if (udp.parsePacket() >= (int)sizeof(pkt)) {
+                uint8_t echo[8];
+                udp.read(echo, sizeof(echo));
+                uint16_t echoSeq;
+                memcpy(&echoSeq, echo, sizeof(echoSeq));
+                if (echoSeq == seq) { rtts.push_back(micros() - sentUs); answered = true; break; }
+            }
+            delay(0);
+        }
+        if (!answered) ++lost;
+    }
+    udp.stop();
+    summarize_(rtts, lost, out);
+}
+
+void NetBench::gatewayProbe_(uint16_t count, uint32_t timeoutMs, Percentiles& out) {
+    // Most home/office gateways run the DNS forwarder, so a cached lookup
+    // against it approximates a round trip to the first hop.
+    IPAddress gw = WiFi.gatewayIP();
+    WiFiUDP udp;
+    if (!udp.begin(0)) { out.lost = count; return; }
+
+    static const uint8_t kQuery[] = {
+        0x00, 0x00, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        5, 'l', 'o', 'c', 'a', 'l', 0x00, 0x00, 0x01, 0x00, 0x01
+    };
+    std::vector<uint32_t> rtts;
+    rtts.reserve(count);
+    uint16_t lost = 0;
+    uint32_t perProbeMs = std::min<uint32_t>(timeoutMs, 500);
+
+    for (uint16_t i = 0; i < count; ++i) {
+        uint8_t q[sizeof(kQuery)];
+        memcpy(q, kQuery, sizeof(q));
+        q[0] = 0xDD;
+        q[1] = (uint8_t)i;
+        uint32_t start = micros();
+        udp.beginPacket(gw, 53);
+        udp.write(q, sizeof(q));
+        udp.endPacket();
+
+        bool answered = false;
+        while (micros() - start < perProbeMs * 1000) {
+            if (udp.parsePacket() >= 2) {
+                uint8_t id[2];
+                udp.read(id, sizeof(id));
+                if (id[0] == 0xDD && id[1] == (uint8_t)i) { rtts.push_back(micros() - start); answered = true; break; }
+            }
+            delay(0);
+        }
+        if (!answered) ++lost;
+    }
+    udp.stop();
+    summarize_(rtts, lost, out);
+}
+
+void NetBench::summarize_(std::vector<uint32_t>& samplesUs, uint16_t lost, Percentiles& out) {
+    out.samples = (uint16_t)samplesUs.size();
+    out.lost = lost;
+    if (samplesUs.empty()) return;
+    std::sort(samplesUs.begin(), samplesUs.end());
+    size_t n = samplesUs.size();
+    out.p50 = samplesUs[(n - 1) * 50 / 100];
+    out.p90 = samplesUs[(n - 1) * 90 / 100];
+    out.p99 = samplesUs[(n - 1) * 99 / 100];
+    out.max = samplesUs[n - 1];
+}
+
+void NetBench::format(const Report& r, char* out, size_t len) {
+    if (!r.ok) {
+        snprintf(out, len, "Benchmark failed: %s", r.error.c_str());
+        return;
+    }
+    snprintf(out, len,
+             "Download: %.0f kbit/s\n"
+             "Upload:   %.0f kbit/s\n"
+             "UDP RTT ms  p50 %.1f  p90 %.1f  p99 %.1f  max %.1f  (lost %u/%u)\n"
+             "Gateway ms  p50 %.1f  p90 %.1f  p99 %.1f  (lost %u/%u)\n"
+             "DNS lookup: %.1f ms",
+             r.downloadKbps, r.uploadKbps,
+             r.udpRtt.p50 / 1000.0f, r.udpRtt.p90 / 1000.0f, r.udpRtt.p99 / 1000.0f, r.udpRtt.max / 1000.0f,
+             r.udpRtt.lost, r.udpRtt.samples + r.udpRtt.lost,
+             r.gatewayRtt.p50 / 1000.0f, r.gatewayRtt.p90 / 1000.0f, r.gatewayRtt.p99 / 1000.0f,
+             r.gatewayRtt.lost, r.gatewayRtt.samples + r.gatewayRtt.lost,
+             r.dnsUs / 1000.0f);
+}
+#endif // DEVDASH_ENABLE_DIAGNOSTICS
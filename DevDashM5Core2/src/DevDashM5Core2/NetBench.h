@@ -0,0 +1,58 @@
+#pragma once
+
+#include <Arduino.h>
+#include <IPAddress.h>
+#include <vector>
+
+/**
+ * Client side of the link benchmark. Talks to tools/netbench_server.py:
+ *
+ *   TCP  request  "DDB1" | cmd ('U' or 'D') | 3 reserved | uint32 LE length
+ *        'D'      server streams `length` bytes and closes
+ *        'U'      client streams `length` bytes, server answers uint32 LE bytes received
+ *   UDP           server echoes every datagram on the same port
+ */
+class NetBench {
+public:
+    struct Config {
+        String   host;
+        uint16_t port          = 5399;
+        uint32_t tcpBytes      = 256 * 1024;
+        uint16_t udpPings      = 50;
+        uint16_t gatewayProbes = 10;
+        uint32_t timeoutMs     = 3000;
+    };
+
+    /** Latency distribution in microseconds */
+    struct Percentiles {
+        uint32_t p50 = 0, p90 = 0, p99 = 0, max = 0;
+        uint16_t samples = 0;
+        uint16_t lost = 0;
+    };
+
+    struct Report {
+        bool        ok = false;
+        String      error;
+        float       uploadKbps   = 0;
+        float       downloadKbps = 0;
+        Percentiles udpRtt;
+        uint32_t    dnsUs = 0;       // resolving the endpoint host
+        Percentiles gatewayRtt;      // DNS queries answered by the gateway
+    };
+
+    /** Run every test against cfg; blocks for a few seconds */
+    static Report run(const Config& cfg);
+
+    /** UDP echo RTT against the endpoint, or gateway RTT if no endpoint is set */
+    static void ping(const Config& cfg, uint16_t count, Percentiles& out);
+
+    /** Print a report in the same layout the diagnostics screen uses */
+    static void format(const Report& r, char* out, size_t len);
+
+private:
+    static bool tcpDownload_(const IPAddress& ip, const Config& cfg, float& kbps);
+    static bool tcpUpload_(const IPAddress& ip, const Config& cfg, float& kbps);
+    static void udpPing_(const IPAddress& ip, uint16_t port, uint16_t count, uint32_t timeoutMs, Percentiles& out);
+    static void gatewayProbe_(uint16_t count, uint32_t timeoutMs, Percentiles& out);
+    static void summarize_(std::vector<uint32_t>& samplesUs, uint16_t lost, Percentiles& out);
+};
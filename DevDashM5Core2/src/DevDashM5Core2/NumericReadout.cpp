@@ -0,0 +1,216 @@
+#include "../DevDashConfig.h"
+#if DEVDASH_ENABLE_SENSORS
+#include "NumericReadout.h"
+#include "../DevDashLog.h"
+
+constexpr uint8_t NumericReadout::kMaxWidth;
+
+static const char kGlyphs[] = "0123456789-. ";
+static const uint8_t kGlyphCount = sizeof(kGlyphs) - 1;
+// lv_draw_label keeps the text pointer until the layer is finished
+static const char* const kGlyphText[kGlyphCount] = {
+    "0", "1", "2", "3", "4", "5", "6", "7", "8", "9", "-", ".", " "
+};
+
+struct NumericReadout::Atlas {
+    const lv_font_t* font;
+    lv_color_t       fg;
+    lv_color_t       bg;
+    int32_t          cellW;  // digits, sign and blank
+    int32_t          dotW;
+    int32_t          cellH;
+    uint8_t*         data;   // one cellW x cellH RGB565 sprite per glyph, stacked
+    lv_image_dsc_t   glyph[kGlyphCount];
+};
+
+static int glyphIndex(char c) {
+    const char* p = strchr(kGlyphs, c);
+    return (p && c) ? (int)(p - kGlyphs) : kGlyphCount - 1;
+}
+
+lv_obj_t* NumericReadout::create(lv_obj_t* parent, const lv_font_t* font, lv_color_t fg, lv_color_t bg,
+                                 uint8_t width, uint8_t decimals) {
+    _atlas = atlasFor_(font, fg, bg);
+    _width = width > kMaxWidth ? kMaxWidth : width;
+    _decimals = decimals;
+    memset(_shown, ' ', _width);
+    _shown[_width] = '\0';
+
+    _obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(_obj);
+    lv_obj_clear_flag(_obj, (lv_obj_flag_t)(LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_CLICKABLE));
+    int32_t w = _atlas ? cellX_(_width) : 0;
+    lv_obj_set_size(_obj, w, _atlas ? _atlas->cellH : 0);
+    lv_obj_add_event_cb(_obj, drawCb_, LV_EVENT_DRAW_MAIN, this);
+    return _obj;
+}
+
+void NumericReadout::set(float value) {
+    char text[24];
+    snprintf(text, sizeof(text), "%*.*f", _width, _decimals, value);
+    show_(text);
+}
+
+void NumericReadout::setInt(int32_t value) {
+    char text[24];
+    snprintf(text, sizeof(text), "%*ld", _width, (long)value);
+    show_(text);
+}
+
+void NumericReadout::clear() {
+    char text[kMaxWidth + 1];
+    memset(text, ' ', _width);
+    text[_width] = '\0';
+    show_(text);
+}
+
+void NumericReadout::show_(const char* text) {
+    if (!_obj || !_atlas) return;
+    char next[kMaxWidth + 1];
+    size_t len = strlen(text);
+    // The point cell is only as wide as '.', so anything else there (too
+    // many digits, nan/inf) shows as dashes
+    uint8_t dotPos = _decimals ? _width - _decimals - 1 : _width;
+    if (len > _width || (_decimals && text[dotPos] != '.')) {
+        // Does not fit: dashes, keeping the decimal point where it belongs
+        memset(next, '-', _width);
+        if (_decimals) next[dotPos] = '.';
+    } else {
+        memcpy(next, text, _width);
+    }
+    next[_width] = '\0';
+
+    uint8_t changed = 0;
+    lv_area_t c;
+    lv_obj_get_coords(_obj, &c);
+    for (uint8_t i = 0; i < _width; ++i) {
+        if (next[i] == _shown[i]) continue;
+        _shown[i] = next[i];
+        lv_area_t a = { c.x1 + cellX_(i), c.y1, c.x1 + cellX_(i + 1) - 1, c.y2 };
+        lv_obj_invalidate_area(_obj, &a);
+        ++changed;
+    }
+    if (changed) {
+        ++_stats.updates;
+        _stats.cellsChanged += changed;
+    }
+}
+
+int32_t NumericReadout::cellX_(uint8_t pos) const {
+    // Only the decimal point cell is narrower; its position never moves
+    uint8_t dotPos = _decimals ? _width - _decimals - 1 : _width;
+    if (pos <= dotPos) return pos * _atlas->cellW;
+    return (pos - 1) * _atlas->cellW + _atlas->dotW;
+}
+
+void NumericReadout::releaseSprites() {
+    for (Atlas* a : atlases_()) {
+        free(a->data);
+        delete a;
+    }
+    std::vector<Atlas*>().swap(atlases_());
+}
+
+std::vector<NumericReadout::Atlas*>& NumericReadout::atlases_() {
+    static std::vector<Atlas*> atlases;
+    return atlases;
+}
+
+const NumericReadout::Atlas* NumericReadout::atlasFor_(const lv_font_t* font, lv_color_t fg, lv_color_t bg) {
+    std::vector<Atlas*>& atlases = atlases_();
+    for (const Atlas* a : atlases) {
+        if (a->font == font && lv_color_eq(a->fg, fg) && lv_color_eq(a->bg, bg)) return a;
+    }
+
+    uint32_t start = micros();
+    Atlas* a = new Atlas();
+    a->font = font;
+    a->fg = fg;
+    a->bg = bg;
+    a->cellW = 0;
+    for (int i = 0; i < kGlyphCount; ++i) {
+        if (kGlyphs[i] == '.') continue;
+        a->cellW = LV_MAX(a->cellW, (int32_t)lv_font_get_glyph_width(font, kGlyphs[i], 0));
+    }
+    a->dotW = lv_font_get_glyph_width(font, '.', 0);
+    a->cellH = lv_font_get_line_height(font);
+
+    uint32_t stride = lv_draw_buf_width_to_stride(a->cellW, LV_COLOR_FORMAT_RGB565);
+    uint32_t spriteSize = stride * a->cellH;
+    a->data = static_cast<uint8_t*>(malloc(spriteSize * kGlyphCount)); // internal RAM: blits read it every frame
+    if (!a->data) {
+        delete a;
+        return nullptr;
+    }
+
+    // Render every glyph once through a temporary canvas over the sprite strip
+    lv_obj_t* canvas = lv_canvas_create(lv_layer_sys());
+    lv_obj_add_flag(canvas, LV_OBJ_FLAG_HIDDEN);
+    lv_canvas_set_buffer(canvas, a->data, a->cellW, a->cellH * kGlyphCount, LV_COLOR_FORMAT_RGB565);
+    lv_canvas_fill_bg(canvas, bg, LV_OPA_COVER);
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+    lv_draw_label_dsc_t label;
+    lv_draw_label_dsc_init(&label);
+    label.font = font;
+    label.color = fg;
+    for (int i = 0; i < kGlyphCount; ++i) {
+        // The point's sprite is only dotW wide: draw it flush left in its own
+        // area, or centring it in a full cell would leave it outside the sprite
+        bool dot = kGlyphs[i] == '.';
+        label.text = kGlyphText[i];
+        label.align = dot ? LV_TEXT_ALIGN_LEFT : LV_TEXT_ALIGN_CENTER;
+        lv_area_t area = { 0, i * a->cellH, (dot ? a->dotW : a->cellW) - 1, (i + 1) * a->cellH - 1 };
+        lv_draw_label(&layer, &label, &area);
+    }
+    lv_canvas_finish_layer(canvas, &layer);
+    lv_obj_delete(canvas);
+
+    for (int i = 0; i < kGlyphCount; ++i) {
+        lv_image_dsc_t& g = a->glyph[i];
+        memset(&g, 0, sizeof(g));
+        g.header.magic = LV_IMAGE_HEADER_MAGIC;
+        g.header.cf = LV_COLOR_FORMAT_RGB565;
+        g.header.w = kGlyphs[i] == '.' ? a->dotW : a->cellW;
+        g.header.h = a->cellH;
+        g.header.stride = stride;
+        g.data_size = spriteSize;
+        g.data = a->data + i * spriteSize;
+    }
+    if (!hasInk_(a, glyphIndex('.'), stride)) DD_LOGW(Ui, "NumericReadout: decimal point sprite is blank");
+    atlases.push_back(a);
+    DD_LOGI(Ui, "NumericReadout: %d glyph sprites (%ldx%ld, %lu B) in %lu us", kGlyphCount,
+            (long)a->cellW, (long)a->cellH, (unsigned long)(spriteSize * kGlyphCount),
+            (unsigned long)(micros() - start));
+    return a;
+}
+
+bool NumericReadout::hasInk_(const Atlas* a, int glyph, uint32_t stride) {
+    uint16_t bg = lv_color_to_u16(a->bg);
+    const uint8_t* rows = a->data + glyph * stride * a->cellH;
+    for (int32_t y = 0; y < a->cellH; ++y) {
+        const uint16_t* px = reinterpret_cast<const uint16_t*>(rows + y * stride);
+        for (int32_t x = 0; x < a->glyph[glyph].header.w; ++x) {
+            if (px[x] != bg) return true;
+        }
+    }
+    return false;
+}
+
+void NumericReadout::drawCb_(lv_event_t* e) {
+    auto* self = static_cast<NumericReadout*>(lv_event_get_user_data(e));
+    if (!self || !self->_atlas) return;
+    lv_layer_t* layer = lv_event_get_layer(e);
+    lv_area_t c;
+    lv_obj_get_coords(self->_obj, &c);
+
+    lv_draw_image_dsc_t img;
+    lv_draw_image_dsc_init(&img);
+    for (uint8_t i = 0; i < self->_width; ++i) {
+        // Cells outside the invalidated area are clipped away by LVGL
+        lv_area_t a = { c.x1 + self->cellX_(i), c.y1, c.x1 + self->cellX_(i + 1) - 1, c.y2 };
+        img.src = &self->_atlas->glyph[glyphIndex(self->_shown[i])];
+        lv_draw_image(layer, &img, &a);
+    }
+}
+#endif // DEVDASH_ENABLE_SENSORS
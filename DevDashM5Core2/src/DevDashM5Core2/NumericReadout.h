@@ -0,0 +1,57 @@
+#pragma once
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include <vector>
+
+/**
+ * Fixed-width numeric display drawn from pre-rendered glyph sprites.
+ *
+ * The digits, sign, decimal point and blank are rendered once per
+ * (font, color, background) into small opaque RGB565 sprites that all
+ * readouts with the same look share. A readout is a single object of
+ * `width` cells; set() formats the value right-aligned and invalidates only
+ * the cells whose character changed, which are then redrawn as plain image
+ * copies, so the cost does not depend on the font.
+ */
+class NumericReadout {
+public:
+    static constexpr uint8_t kMaxWidth = 12;
+
+    struct Stats {
+        uint32_t updates = 0;       // set() calls that changed something
+        uint32_t cellsChanged = 0;  // cells invalidated by those calls
+    };
+
+    /** Create the readout; `bg` must match what is behind it (sprites are opaque) */
+    lv_obj_t* create(lv_obj_t* parent, const lv_font_t* font, lv_color_t fg, lv_color_t bg,
+                     uint8_t width, uint8_t decimals);
+
+    void set(float value);
+    void setInt(int32_t value);
+    /** Show blanks, e.g. while there is no reading */
+    void clear();
+
+    /** Free the shared glyph sprites; only once no readout is left on screen */
+    static void releaseSprites();
+
+    lv_obj_t* obj() const { return _obj; }
+    const Stats& stats() const { return _stats; }
+
+private:
+    struct Atlas;
+
+    lv_obj_t*    _obj = nullptr;
+    const Atlas* _atlas = nullptr;
+    uint8_t      _width = 0;
+    uint8_t      _decimals = 0;
+    char         _shown[kMaxWidth + 1] = {0};
+    Stats        _stats;
+
+    void show_(const char* text);
+    int32_t cellX_(uint8_t pos) const;
+    static std::vector<Atlas*>& atlases_();
+    static const Atlas* atlasFor_(const lv_font_t* font, lv_color_t fg, lv_color_t bg);
+    static bool hasInk_(const Atlas* a, int glyph, uint32_t stride); // any pixel but bg in the sprite
+    static void drawCb_(lv_event_t* e);
+};
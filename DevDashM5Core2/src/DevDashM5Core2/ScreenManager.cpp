@@ -0,0 +1,145 @@
+#include "../DevDashConfig.h"
+#include "ScreenManager.h"
+#include "../DevDashLog.h"
+#if DEVDASH_STYLE_TIMING
+#include "../ThemeManager.h"
+#endif
+
+constexpr size_t ScreenManager::kDefaultBudget;
+constexpr int    ScreenManager::kNone;
+
+int ScreenManager::add(const char* name, BuildCb build, ReleaseCb release, void* user) {
+    Screen s = { name, build, release, user, nullptr, 0, 0 };
+    _screens.push_back(s);
+    return (int)_screens.size() - 1;
+}
+
+bool ScreenManager::show(int id) {
+    if (id < 0 || id >= (int)_screens.size()) return false;
+    uint32_t start = micros();
+    Screen& s = _screens[id];
+    if (!s.obj && !build_(s)) return false;
+
+    s.lastUsed = ++_clock;
+    if (_active != id) {
+        lv_screen_load(s.obj);
+        _active = id;
+    }
+    enforceBudget_();
+    _stats.lastSwitchUs = micros() - start;
+    DD_LOGD(Ui, "Screens: %s in %lu us (%u B cached of %u B budget)", s.name,
+            (unsigned long)_stats.lastSwitchUs, (unsigned)_stats.cachedBytes, (unsigned)_budget);
+    return true;
+}
+
+bool ScreenManager::prebuild(int id) {
+    if (id < 0 || id >= (int)_screens.size()) return false;
+    Screen& s = _screens[id];
+    if (s.obj) return true;
+    if (_stats.cachedBytes >= _budget || !build_(s)) return false;
+    enforceBudget_();
+    return s.obj != nullptr;
+}
+
+void ScreenManager::next() {
+    if (_screens.empty()) return;
+    show(_active == kNone ? 0 : (_active + 1) % (int)_screens.size());
+}
+
+void ScreenManager::prev() {
+    if (_screens.empty()) return;
+    int n = (int)_screens.size();
+    show(_active == kNone ? 0 : (_active + n - 1) % n);
+}
+
+void ScreenManager::evictAll() {
+    for (size_t i = 0; i < _screens.size(); ++i) {
+        if ((int)i != _active && _screens[i].obj) evict_(_screens[i]);
+    }
+}
+
+void ScreenManager::destroy() {
+    // The active screen cannot be deleted while loaded; give LVGL an empty one
+    if (_active != kNone && _screens[_active].obj) lv_screen_load(lv_obj_create(nullptr));
+    _active = kNone;
+    for (auto& s : _screens) {
+        if (s.obj) evict_(s);
+    }
+}
+
+void ScreenManager::setMemoryBudget(size_t bytes) {
+    _budget = bytes;
+    enforceBudget_();
+}
+
+bool ScreenManager::isBuilt(int id) const {
+    return id >= 0 && id < (int)_screens.size() && _screens[id].obj;
+}
+
+const char* ScreenManager::name(int id) const {
+    return (id >= 0 && id < (int)_screens.size()) ? _screens[id].name : "";
+}
+
+/* -------------------- Internals -------------------- */
+
+bool ScreenManager::build_(Screen& s) {
+    size_t before = lvglUsed_();
+    uint32_t start = micros();
+    s.obj = lv_obj_create(nullptr);
+    if (!s.obj) return false;
+    lv_obj_add_event_cb(s.obj, gestureCb_, LV_EVENT_GESTURE, this);
+    s.build(s.user, s.obj);
+    lv_obj_update_layout(s.obj);
+
+    size_t after = lvglUsed_();
+    uint32_t us = micros() - start;
+    s.bytes = after > before ? after - before : 0;
+    _stats.cachedBytes += s.bytes;
+    ++_stats.builds;
+#if DEVDASH_STYLE_TIMING
+    ThemeManager::LookupStats lookups = ThemeManager::timeLookups(s.obj);
+    _stats.lookupNs = lookups.nsPerLookup();
+    DD_LOGI(Ui, "Screens: built %s, %u B LVGL heap in %lu us; %lu objects, %lu ns per style lookup",
+            s.name, (unsigned)s.bytes, (unsigned long)us, (unsigned long)lookups.objects,
+            (unsigned long)_stats.lookupNs);
+#else
+    DD_LOGI(Ui, "Screens: built %s, %u B LVGL heap in %lu us", s.name, (unsigned)s.bytes, (unsigned long)us);
+#endif
+    return true;
+}
+
+void ScreenManager::evict_(Screen& s) {
+    if (s.release) s.release(s.user);
+    lv_obj_delete(s.obj);
+    s.obj = nullptr;
+    _stats.cachedBytes -= s.bytes;
+    s.bytes = 0;
+    ++_stats.evictions;
+    DD_LOGI(Ui, "Screens: evicted %s", s.name);
+}
+
+void ScreenManager::enforceBudget_() {
+    while (_stats.cachedBytes > _budget) {
+        Screen* lru = nullptr;
+        for (size_t i = 0; i < _screens.size(); ++i) {
+            Screen& s = _screens[i];
+            if ((int)i == _active || !s.obj) continue;
+            if (!lru || s.lastUsed < lru->lastUsed) lru = &s;
+        }
+        if (!lru) break; // only the active screen is left
+        evict_(*lru);
+    }
+}
+
+size_t ScreenManager::lvglUsed_() {
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+}
+
+void ScreenManager::gestureCb_(lv_event_t* e) {
+    auto* self = static_cast<ScreenManager*>(lv_event_get_user_data(e));
+    lv_dir_t dir = lv_indev_get_gesture_dir(lv_indev_active());
+    if (dir == LV_DIR_LEFT) self->next();
+    else if (dir == LV_DIR_RIGHT) self->prev();
+}
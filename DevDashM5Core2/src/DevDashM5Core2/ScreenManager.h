@@ -0,0 +1,84 @@
+#pragma once
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include <vector>
+
+/**
+ * Owns the dashboard's top-level screens.
+ *
+ * Screens are registered with a build callback and created on first visit.
+ * Built screens stay cached so returning to one is just lv_screen_load().
+ * The LVGL heap each build consumed is recorded (with DEVDASH_STYLE_TIMING,
+ * also the cost of a style lookup on the new tree), and when the cached total
+ * exceeds the memory budget the least recently shown screens (never the
+ * active one) are released and deleted. Horizontal swipes on any screen move
+ * to the next / previous one.
+ */
+class ScreenManager {
+public:
+    typedef void (*BuildCb)(void* user, lv_obj_t* screen);
+    typedef void (*ReleaseCb)(void* user);
+
+    static constexpr size_t kDefaultBudget = 32 * 1024;
+    static constexpr int    kNone = -1;
+
+    struct Stats {
+        uint16_t builds = 0;
+        uint16_t evictions = 0;
+        uint32_t lastSwitchUs = 0;  // show() including any build
+        size_t   cachedBytes = 0;   // LVGL heap held by built screens
+        uint32_t lookupNs = 0;      // per style lookup on the last screen built (DEVDASH_STYLE_TIMING)
+    };
+
+    /**
+     * Register a screen; `release` runs just before it is deleted so the owner
+     * can drop pointers into it. Returns the screen id.
+     */
+    int add(const char* name, BuildCb build, ReleaseCb release, void* user);
+
+    /** Build (if needed) and load a screen, then evict down to the budget */
+    bool show(int id);
+    /** Build a screen without loading it, if the budget has room; for warm-up */
+    bool prebuild(int id);
+    void next();
+    void prev();
+
+    /** Delete every built screen except the active one */
+    void evictAll();
+
+    /** Delete every built screen, including the active one */
+    void destroy();
+
+    void setMemoryBudget(size_t bytes);
+    size_t memoryBudget() const { return _budget; }
+
+    int active() const { return _active; }
+    bool isBuilt(int id) const;
+    const char* name(int id) const;
+    size_t count() const { return _screens.size(); }
+    const Stats& stats() const { return _stats; }
+
+private:
+    struct Screen {
+        const char* name;
+        BuildCb     build;
+        ReleaseCb   release;
+        void*       user;
+        lv_obj_t*   obj;
+        size_t      bytes;
+        uint32_t    lastUsed;
+    };
+
+    std::vector<Screen> _screens;
+    int      _active = kNone;
+    uint32_t _clock = 0;
+    size_t   _budget = kDefaultBudget;
+    Stats    _stats;
+
+    bool build_(Screen& s);
+    void evict_(Screen& s);
+    void enforceBudget_();
+    static size_t lvglUsed_();
+    static void gestureCb_(lv_event_t* e);
+};
@@ -1,22 +1,28 @@
+#include "../DevDashConfig.h"
+#if DEVDASH_ENABLE_SENSORS
 #include "SensorDashboard.h"
 #include <M5Core2.h>
 #include <lvgl.h>
+#include "NumericReadout.h"
 
 // --- Simple “card” style helpers ---
 static lv_style_t style_card;
 static lv_style_t style_title;
 static lv_style_t style_value;
+static lv_style_t style_row;
+static bool styles_ready = false; // style properties live in the LVGL heap
 
-static lv_obj_t* lbl_accel;
-static lv_obj_t* lbl_gyro;
-static lv_obj_t* lbl_imu_temp;
+// Values are fixed-width sprite readouts; only the captions and units are labels
+static NumericReadout ro_accel[3];
+static NumericReadout ro_gyro[3];
+static NumericReadout ro_imu_temp;
 
-static lv_obj_t* lbl_axp_temp;
-static lv_obj_t* lbl_bat_v;
-static lv_obj_t* lbl_bat_i;
-static lv_obj_t* lbl_bat_p;
+static NumericReadout ro_axp_temp;
+static NumericReadout ro_bat_v;
+static NumericReadout ro_bat_i;
+static NumericReadout ro_bat_p;
 
-static lv_obj_t* lbl_touch;
+static NumericReadout ro_touch[2];
 
 static void make_styles() {
   lv_style_init(&style_card);
@@ -38,6 +44,14 @@ static void make_styles() {
   lv_style_init(&style_value);
   lv_style_set_text_font(&style_value, &lv_font_montserrat_18);
   lv_style_set_text_color(&style_value, lv_color_black());
+
+  lv_style_init(&style_row);
+  lv_style_set_width(&style_row, LV_PCT(100));
+  lv_style_set_height(&style_row, LV_SIZE_CONTENT);
+  lv_style_set_layout(&style_row, LV_LAYOUT_FLEX);
+  lv_style_set_flex_flow(&style_row, LV_FLEX_FLOW_ROW);
+  lv_style_set_flex_cross_place(&style_row, LV_FLEX_ALIGN_CENTER);
+  lv_style_set_pad_column(&style_row, 6);
 }
 
 static lv_obj_t* make_card(lv_obj_t* parent, const char* title) {
@@ -60,6 +74,20 @@ static lv_obj_t* make_value_label(lv_obj_t* parent, const char* initial) {
   return lab;
 }
 
+// A row of "caption  value [value ...] unit"
+static lv_obj_t* make_row(lv_obj_t* parent, const char* caption) {
+  lv_obj_t* row = lv_obj_create(parent);
+  lv_obj_remove_style_all(row);
+  lv_obj_add_style(row, &style_row, 0);
+  make_value_label(row, caption);
+  return row;
+}
+
+static void make_readout(NumericReadout& ro, lv_obj_t* row, uint8_t width, uint8_t decimals) {
+  // Sprites are opaque, so they take the card's background
+  ro.create(row, &lv_font_montserrat_18, lv_color_black(), lv_color_white(), width, decimals);
+}
+
 // --- Timer to pull sensor data and update the labels ---
 static void sensor_timer_cb(lv_timer_t* t) {
   LV_UNUSED(t);
@@ -67,50 +95,52 @@ static void sensor_timer_cb(lv_timer_t* t) {
   // IMU
   float ax = 0, ay = 0, az = 0;
   M5.IMU.getAccelData(&ax, &ay, &az);
-  lv_label_set_text_fmt(lbl_accel, "Accel:  X=%0.2f  Y=%0.2f  Z=%0.2f", ax, ay, az);
+  ro_accel[0].set(ax);
+  ro_accel[1].set(ay);
+  ro_accel[2].set(az);
 
   float gx = 0, gy = 0, gz = 0;
   M5.IMU.getGyroData(&gx, &gy, &gz);
-  lv_label_set_text_fmt(lbl_gyro,  "Gyro:   X=%0.2f  Y=%0.2f  Z=%0.2f", gx, gy, gz);
+  ro_gyro[0].set(gx);
+  ro_gyro[1].set(gy);
+  ro_gyro[2].set(gz);
 
   float temp = 0;
   M5.IMU.getTempData(&temp);
-  lv_label_set_text_fmt(lbl_imu_temp, "IMU Temp: %0.2f °C", temp);
+  ro_imu_temp.set(temp);
 
   // Power & Battery (AXP192)
-  float axpTemp = M5.Axp.GetTempInAXP192();
-  lv_label_set_text_fmt(lbl_axp_temp, "Power Temp: %0.2f °C", axpTemp);
-
-  float batV = M5.Axp.GetBatVoltage();
-  lv_label_set_text_fmt(lbl_bat_v, "Battery Voltage: %0.2f V", batV);
-
-  float batI = M5.Axp.GetBatCurrent();
-  lv_label_set_text_fmt(lbl_bat_i, "Battery Current: %0.2f mA", batI);
-
-  float batP = M5.Axp.GetBatPower();
-  lv_label_set_text_fmt(lbl_bat_p, "Battery Power: %0.2f mW", batP);
+  ro_axp_temp.set(M5.Axp.GetTempInAXP192());
+  ro_bat_v.set(M5.Axp.GetBatVoltage());
+  ro_bat_i.set(M5.Axp.GetBatCurrent());
+  ro_bat_p.set(M5.Axp.GetBatPower());
 
   // Touch
   TouchPoint_t p = M5.Touch.getPressPoint();
-  // If not pressed, M5Core2 typically returns (-1, -1); display “—” nicely
+  // If not pressed, M5Core2 typically returns (-1, -1); show blanks
   if (p.x >= 0 && p.y >= 0) {
-    lv_label_set_text_fmt(lbl_touch, "Touch:  X=%d  Y=%d", p.x, p.y);
+    ro_touch[0].setInt(p.x);
+    ro_touch[1].setInt(p.y);
   } else {
-    lv_label_set_text(lbl_touch, "Touch:  —");
+    ro_touch[0].clear();
+    ro_touch[1].clear();
   }
 }
 
-// --- Public setup you can call from your app ---
-void create_sensor_dashboard_screen() {
-  make_styles();
+// --- Screen content ---
+static void build_sensor_dashboard(lv_obj_t* scr) {
+  if (!styles_ready) {
+    make_styles();
+    styles_ready = true;
+  }
 
-  lv_obj_t* scr = lv_obj_create(NULL);
   lv_obj_set_style_bg_color(scr, lv_palette_lighten(LV_PALETTE_GREY, 5), 0);
   lv_obj_set_style_bg_opa(scr, LV_OPA_100, 0);
   lv_obj_set_flex_flow(scr, LV_FLEX_FLOW_COLUMN);
   lv_obj_set_flex_align(scr, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START);
   lv_obj_set_style_pad_all(scr, 12, 0);
   lv_obj_set_style_pad_row(scr, 12, 0);
+  lv_obj_set_scroll_dir(scr, LV_DIR_VER);
 
   // Header
   lv_obj_t* header = lv_label_create(scr);
@@ -121,78 +151,80 @@ void create_sensor_dashboard_screen() {
   // Card 1: IMU
   {
     lv_obj_t* card = make_card(scr, "IMU");
-    lbl_accel   = make_value_label(card, "Accel:  X=0.00  Y=0.00  Z=0.00");
-    lbl_gyro    = make_value_label(card, "Gyro:   X=0.00  Y=0.00  Z=0.00");
-    lbl_imu_temp= make_value_label(card, "IMU Temp: 0.00 °C");
+    lv_obj_t* row = make_row(card, "Accel");
+    for (auto& ro : ro_accel) make_readout(ro, row, 6, 2);
+    row = make_row(card, "Gyro");
+    for (auto& ro : ro_gyro) make_readout(ro, row, 7, 1);
+    row = make_row(card, "IMU Temp");
+    make_readout(ro_imu_temp, row, 6, 2);
+    make_value_label(row, "°C");
   }
 
   // Card 2: Power & Battery
   {
     lv_obj_t* card = make_card(scr, "Power & Battery");
-    lbl_axp_temp = make_value_label(card, "Power Temp: 0.00 °C");
-    lbl_bat_v    = make_value_label(card, "Battery Voltage: 0.00 V");
-    lbl_bat_i    = make_value_label(card, "Battery Current: 0.00 mA");
-    lbl_bat_p    = make_value_label(card, "Battery Power: 0.00 mW");
+    lv_obj_t* row = make_row(card, "Power Temp");
+    make_readout(ro_axp_temp, row, 6, 2);
+    make_value_label(row, "°C");
+    row = make_row(card, "Battery Voltage");
+    make_readout(ro_bat_v, row, 5, 2);
+    make_value_label(row, "V");
+    row = make_row(card, "Battery Current");
+    make_readout(ro_bat_i, row, 8, 2);
+    make_value_label(row, "mA");
+    row = make_row(card, "Battery Power");
+    make_readout(ro_bat_p, row, 8, 2);
+    make_value_label(row, "mW");
   }
 
   // Card 3: Touch
   {
     lv_obj_t* card = make_card(scr, "Touch");
-    lbl_touch = make_value_label(card, "Touch:  —");
+    lv_obj_t* row = make_row(card, "Touch");
+    make_value_label(row, "X");
+    make_readout(ro_touch[0], row, 4, 0);
+    make_value_label(row, "Y");
+    make_readout(ro_touch[1], row, 4, 0);
   }
-
-  lv_scr_load(scr);
-
-  // Update 10ms like your sketch, but 50–100ms is usually plenty smooth:
-  lv_timer_create(sensor_timer_cb, 100, NULL);
 }
 
 bool SensorDashboard::begin() {
-    // M5.Lcd.setTextSize(2);
-    M5.Lcd.setTextColor(BLACK);
-    M5.Lcd.setCursor(0, 0);
     M5.IMU.Init();
     return true;
 }
 
-void SensorDashboard::loop() {
-    float ax = 0, ay = 0, az = 0;
-    M5.IMU.getAccelData(&ax, &ay, &az);
-    M5.Lcd.setCursor(0, 0);
-    M5.Lcd.printf("Accel: X=%.2f, Y=%.2f, Z=%.2f\n", ax, ay, az);
-
-    float gx = 0, gy = 0, gz = 0;
-    M5.IMU.getGyroData(&gx, &gy, &gz);
-    M5.Lcd.setCursor(0, 20);
-    M5.Lcd.printf("Gyro: X=%.2f, Y=%.2f, Z=%.2f\n", gx, gy, gz);
-
-    float temp = 0;
-    M5.IMU.getTempData(&temp);
-    M5.Lcd.setCursor(0, 40);
-    M5.Lcd.printf("Temp: %.2f C\n", temp);
-
-    float powTemp = M5.Axp.GetTempInAXP192();
-    M5.Lcd.setCursor(0, 120);
-    M5.Lcd.printf("Power Temp: %.2f C\n", powTemp);
-
-    float batVolt = M5.Axp.GetBatVoltage();
-    M5.Lcd.setCursor(0, 60);
-    M5.Lcd.printf("Battery Voltage: %.2f V\n", batVolt);
-
-    float batCurr = M5.Axp.GetBatCurrent();
-    M5.Lcd.setCursor(0, 80);
-    M5.Lcd.printf("Battery Current: %.2f mA\n", batCurr);
-
-    float batPower = M5.Axp.GetBatPower();
-    M5.Lcd.setCursor(0, 100);
-    M5.Lcd.printf("Battery Power: %.2f mW\n", batPower);
-
-    TouchPoint_t coordinate;
-    coordinate = M5.Touch.getPressPoint();
-    M5.Lcd.setCursor(0, 120);
-    M5.Lcd.printf("Touch: X=%d, Y=%d\n", coordinate.x, coordinate.y);
+void SensorDashboard::build(lv_obj_t* screen) {
+    build_sensor_dashboard(screen);
+
+    // Sample only while the screen is shown; 100 ms is plenty smooth
+    _timer = lv_timer_create(sensor_timer_cb, 100, nullptr);
+    lv_timer_pause(_timer);
+    lv_obj_add_event_cb(screen, [](lv_event_t* e){
+        auto* timer = static_cast<lv_timer_t*>(lv_event_get_user_data(e));
+        if (lv_event_get_code(e) == LV_EVENT_SCREEN_LOADED) {
+            lv_timer_resume(timer);
+            lv_timer_ready(timer);
+        } else if (lv_event_get_code(e) == LV_EVENT_SCREEN_UNLOADED) {
+            lv_timer_pause(timer);
+        }
+    }, LV_EVENT_ALL, _timer);
+}
 
-    delay(10);
+void SensorDashboard::release() {
+    if (_timer) {
+        lv_timer_delete(_timer);
+        _timer = nullptr;
+    }
 }
 
-void SensorDashboard::destroy() {}
\ No newline at end of file
+void SensorDashboard::destroy() {
+    release();
+    if (styles_ready) {
+        lv_style_reset(&style_card);
+        lv_style_reset(&style_title);
+        lv_style_reset(&style_value);
+        lv_style_reset(&style_row);
+        styles_ready = false;
+    }
+}
+#endif // DEVDASH_ENABLE_SENSORS
@@ -1,8 +1,21 @@
 #pragma once
 
+#include <lvgl.h>
+
+/**
+ * IMU, power and touch readings as an LVGL screen. The owner creates the
+ * screen object and calls build(); readings are sampled only while that
+ * screen is loaded.
+ */
 class SensorDashboard {
 public:
     bool begin();
-    void loop();
+    void build(lv_obj_t* screen);
+    /** Stop sampling; call before the screen built into is deleted */
+    void release();
+    /** Also drop the shared styles; call while LVGL is still initialized */
     void destroy();
-};
\ No newline at end of file
+
+private:
+    lv_timer_t* _timer = nullptr;
+};
@@ -0,0 +1,188 @@
+#include "../DevDashConfig.h"
+#if DEVDASH_ENABLE_WIFI_UI
+#include "SnapshotKeyboard.h"
+#include <esp_heap_caps.h>
+#include "../DevDashLog.h"
+#include "widgets/buttonmatrix/lv_buttonmatrix_private.h" // button_areas for hit-testing
+
+constexpr uint8_t  SnapshotKeyboard::kModes;
+constexpr uint32_t SnapshotKeyboard::kNoKey;
+
+bool SnapshotKeyboard::begin(lv_obj_t* parent, ThemeManager* theme) {
+    _kb = lv_keyboard_create(parent);
+    theme->addStyle(_kb, ThemeManager::Role::Keyboard);
+    lv_obj_add_flag(_kb, LV_OBJ_FLAG_HIDDEN);
+
+    _overlay = lv_image_create(parent);
+    theme->addStyle(_overlay, ThemeManager::Role::Keyboard);
+    lv_obj_add_flag(_overlay, (lv_obj_flag_t)(LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_CLICKABLE));
+    // Like lv_keyboard: taps must not take focus from the textarea
+    lv_obj_clear_flag(_overlay, LV_OBJ_FLAG_CLICK_FOCUSABLE);
+    lv_obj_add_event_cb(_overlay, eventCb_, LV_EVENT_ALL, this);
+
+    _fallback = !showMode_(lv_keyboard_get_mode(_kb));
+    return true;
+}
+
+void SnapshotKeyboard::destroy() {
+    if (_overlay) lv_obj_delete(_overlay);
+    if (_kb) lv_obj_delete(_kb);
+    _overlay = nullptr;
+    _kb = nullptr;
+    for (auto& c : _cache) {
+        if (c.data) heap_caps_free(c.data);
+        c.data = nullptr;
+    }
+    _shownMode = 0xFF;
+    _pressed = kNoKey;
+}
+
+void SnapshotKeyboard::setTextarea(lv_obj_t* ta) {
+    if (_kb) lv_keyboard_set_textarea(_kb, ta);
+}
+
+void SnapshotKeyboard::show() {
+    lv_obj_t* o = obj();
+    if (!o) return;
+    lv_obj_clear_flag(o, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_move_foreground(o);
+}
+
+void SnapshotKeyboard::hide() {
+    setPressed_(kNoKey);
+    lv_obj_t* o = obj();
+    if (o) lv_obj_add_flag(o, LV_OBJ_FLAG_HIDDEN);
+}
+
+bool SnapshotKeyboard::visible() const {
+    lv_obj_t* o = obj();
+    return o && !lv_obj_has_flag(o, LV_OBJ_FLAG_HIDDEN);
+}
+
+/* -------------------- Internals -------------------- */
+
+bool SnapshotKeyboard::showMode_(uint8_t mode) {
+    if (mode >= kModes) return false;
+    if (mode == _shownMode) return true;
+    if (!_cache[mode].data && !snapshot_(mode)) return false;
+    lv_image_set_src(_overlay, &_cache[mode].buf);
+    _shownMode = mode;
+    return true;
+}
+
+bool SnapshotKeyboard::snapshot_(uint8_t mode) {
+    uint32_t start = micros();
+    Cache& c = _cache[mode];
+
+    // The keyboard has to be laid out and visible to render; nothing is
+    // drawn to the panel before it is hidden again.
+    bool hidden = lv_obj_has_flag(_kb, LV_OBJ_FLAG_HIDDEN);
+    if (hidden) lv_obj_clear_flag(_kb, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_update_layout(_kb);
+
+    int32_t ext = lv_obj_get_ext_draw_size(_kb);
+    uint32_t w = lv_obj_get_width(_kb) + 2 * ext;
+    uint32_t h = lv_obj_get_height(_kb) + 2 * ext;
+    uint32_t stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_RGB565);
+    uint32_t size = stride * h;
+
+    bool ok = false;
+    c.data = static_cast<uint8_t*>(heap_caps_malloc(size, MALLOC_CAP_SPIRAM));
+    if (c.data && lv_draw_buf_init(&c.buf, w, h, LV_COLOR_FORMAT_RGB565, stride, c.data, size) == LV_RESULT_OK) {
+        ok = lv_snapshot_take_to_draw_buf(_kb, LV_COLOR_FORMAT_RGB565, &c.buf) == LV_RESULT_OK;
+    }
+    if (hidden) lv_obj_add_flag(_kb, LV_OBJ_FLAG_HIDDEN);
+
+    if (!ok) {
+        if (c.data) heap_caps_free(c.data);
+        c.data = nullptr;
+        DD_LOGW(Ui, "Keyboard: snapshot failed, using the stock keyboard");
+        return false;
+    }
+    ++_stats.snapshots;
+    _stats.snapshotUs += micros() - start;
+    DD_LOGI(Ui, "Keyboard: mode %u cached (%lux%lu, %lu B PSRAM) in %lu us", mode,
+            (unsigned long)w, (unsigned long)h, (unsigned long)size, (unsigned long)(micros() - start));
+    return true;
+}
+
+bool SnapshotKeyboard::keyArea_(uint32_t id, lv_area_t& out) const {
+    const lv_buttonmatrix_t* btnm = reinterpret_cast<const lv_buttonmatrix_t*>(_kb);
+    if (id >= btnm->btn_cnt) return false;
+
+    // Button areas are relative to the keyboard's origin; the overlay
+    // covers the same box, so place them on the overlay instead
+    lv_area_t ov;
+    lv_obj_get_coords(_overlay, &ov);
+    out = btnm->button_areas[id];
+    lv_area_move(&out, ov.x1, ov.y1);
+    return true;
+}
+
+uint32_t SnapshotKeyboard::keyAt_(const lv_point_t& p) const {
+    const lv_buttonmatrix_t* btnm = reinterpret_cast<const lv_buttonmatrix_t*>(_kb);
+    const lv_buttonmatrix_ctrl_t skip = (lv_buttonmatrix_ctrl_t)(LV_BUTTONMATRIX_CTRL_HIDDEN | LV_BUTTONMATRIX_CTRL_DISABLED);
+    for (uint32_t i = 0; i < btnm->btn_cnt; ++i) {
+        lv_area_t a;
+        if (!keyArea_(i, a)) break;
+        // Widen by a couple of pixels so touches in the gaps still land
+        lv_area_increase(&a, 2, 2);
+        if (lv_area_is_point_on(&a, &p, 0) && !lv_buttonmatrix_has_button_ctrl(_kb, i, skip)) return i;
+    }
+    return kNoKey;
+}
+
+void SnapshotKeyboard::setPressed_(uint32_t id) {
+    if (id == _pressed) return;
+    lv_area_t a;
+    if (_pressed != kNoKey && keyArea_(_pressed, a)) lv_obj_invalidate_area(_overlay, &a);
+    _pressed = id;
+    if (_pressed != kNoKey && keyArea_(_pressed, a)) lv_obj_invalidate_area(_overlay, &a);
+}
+
+void SnapshotKeyboard::commit_(uint32_t id) {
+    // Let the hidden keyboard do what a real press would: insert the text,
+    // handle backspace/OK/close and switch maps
+    lv_buttonmatrix_set_selected_button(_kb, id);
+    lv_obj_send_event(_kb, LV_EVENT_VALUE_CHANGED, nullptr);
+    ++_stats.keys;
+
+    uint8_t mode = lv_keyboard_get_mode(_kb);
+    if (mode != _shownMode && !showMode_(mode)) {
+        // A map that could not be cached: hand over to the stock keyboard
+        bool shown = visible();
+        hide();
+        _fallback = true;
+        if (shown) show();
+    }
+}
+
+void SnapshotKeyboard::eventCb_(lv_event_t* e) {
+    auto* self = static_cast<SnapshotKeyboard*>(lv_event_get_user_data(e));
+    lv_event_code_t code = lv_event_get_code(e);
+
+    if (code == LV_EVENT_DRAW_POST) {
+        lv_area_t a;
+        if (self->_pressed == kNoKey || !self->keyArea_(self->_pressed, a)) return;
+        lv_draw_rect_dsc_t dsc;
+        lv_draw_rect_dsc_init(&dsc);
+        dsc.bg_color = lv_color_black();
+        dsc.bg_opa = LV_OPA_30;
+        dsc.radius = 4;
+        lv_draw_rect(lv_event_get_layer(e), &dsc, &a);
+        return;
+    }
+
+    if (code == LV_EVENT_PRESSED || code == LV_EVENT_PRESSING) {
+        lv_point_t p;
+        lv_indev_get_point(lv_indev_active(), &p);
+        self->setPressed_(self->keyAt_(p));
+    } else if (code == LV_EVENT_RELEASED) {
+        uint32_t id = self->_pressed;
+        self->setPressed_(kNoKey);
+        if (id != kNoKey) self->commit_(id);
+    } else if (code == LV_EVENT_PRESS_LOST) {
+        self->setPressed_(kNoKey);
+    }
+}
+#endif // DEVDASH_ENABLE_WIFI_UI
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include "ThemeManager.h"
+
+/**
+ * On-screen keyboard drawn from a cached snapshot.
+ *
+ * A real lv_keyboard is kept hidden and owns the key map, mode and
+ * textarea handling. Each of its modes is rendered once into an RGB565
+ * buffer in PSRAM and shown through an image object; touches on the image
+ * are hit-tested against the hidden keyboard's button areas, so a key press
+ * only repaints that key's highlight and the textarea. If a snapshot cannot
+ * be taken the hidden keyboard is shown instead.
+ */
+class SnapshotKeyboard {
+public:
+    struct Stats {
+        uint16_t snapshots = 0;     // modes rendered so far
+        uint32_t snapshotUs = 0;    // time spent rendering them
+        uint32_t keys = 0;          // keys committed
+    };
+
+    /** Build the hidden keyboard and its image overlay on `parent` (hidden) */
+    bool begin(lv_obj_t* parent, ThemeManager* theme);
+
+    /** Free the cached buffers and delete both objects */
+    void destroy();
+
+    void setTextarea(lv_obj_t* ta);
+    void show();
+    void hide();
+    bool visible() const;
+
+    /** The object on screen (the overlay, or the keyboard when falling back) */
+    lv_obj_t* obj() const { return _fallback ? _kb : _overlay; }
+    lv_obj_t* keyboard() const { return _kb; }
+    const Stats& stats() const { return _stats; }
+
+private:
+    static constexpr uint8_t kModes = 4; // lower, upper, special, number
+    static constexpr uint32_t kNoKey = 0xFFFF;
+
+    struct Cache {
+        lv_draw_buf_t buf;
+        uint8_t*      data = nullptr;
+    };
+
+    lv_obj_t* _kb = nullptr;
+    lv_obj_t* _overlay = nullptr;
+    Cache     _cache[kModes];
+    uint8_t   _shownMode = 0xFF;
+    uint32_t  _pressed = kNoKey;
+    bool      _fallback = false;
+    Stats     _stats;
+
+    bool showMode_(uint8_t mode);
+    bool snapshot_(uint8_t mode);
+    uint32_t keyAt_(const lv_point_t& p) const;
+    bool keyArea_(uint32_t id, lv_area_t& out) const;
+    void setPressed_(uint32_t id);
+    void commit_(uint32_t id);
+    static void eventCb_(lv_event_t* e);
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <stddef.h>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Non-owning view of a contiguous array. Returned instead of a container
+ * so callers read the owner's storage in place; it stays valid until the
+ * owner next changes that storage.
+ */
+template <typename T>
+class Span {
+public:
+    Span() : _data(nullptr), _size(0) {}
+    Span(T* data, size_t size) : _data(data), _size(size) {}
+
+    /** Span<const T> from Span<T> */
+    template <typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    Span(const Span<U>& o) : _data(o.data()), _size(o.size()) {}
+
+    /** Read-only view of a vector the caller keeps alive */
+    template <typename U, typename A,
+              typename = typename std::enable_if<std::is_convertible<const U*, T*>::value>::type>
+    Span(const std::vector<U, A>& v) : _data(v.data()), _size(v.size()) {}
+
+    T* data() const { return _data; }
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+    T* begin() const { return _data; }
+    T* end() const { return _data + _size; }
+    T& operator[](size_t i) const { return _data[i]; }
+    T& front() const { return _data[0]; }
+
+private:
+    T*     _data;
+    size_t _size;
+};
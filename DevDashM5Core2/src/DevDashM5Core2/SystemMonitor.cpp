@@ -0,0 +1,119 @@
+#include "SystemMonitor.h"
+#include "LVGLRenderer.h"
+#include <esp_heap_caps.h>
+#include <algorithm>
+
+constexpr uint8_t  SystemMonitor::kMaxTasks;
+constexpr uint8_t  SystemMonitor::kBuckets;
+constexpr uint32_t SystemMonitor::kDefaultPeriodMs;
+
+#define DEVDASH_TASK_STATS (configUSE_TRACE_FACILITY && configGENERATE_RUN_TIME_STATS)
+
+SystemMonitor::~SystemMonitor() {
+    heap_caps_free(_status);
+}
+
+void SystemMonitor::loop() {
+    uint32_t now = millis();
+    if (!_windowMs) {
+        // First call: start the window from here
+        _windowMs = now ? now : 1;
+        _frames = LVGLRenderer::flushStats().frames;
+        return;
+    }
+    if (now - _windowMs < _periodMs) return;
+    sample_(now);
+}
+
+void SystemMonitor::sample_(uint32_t now) {
+    Sample& s = _latest;
+    s.ms = now;
+    uint32_t elapsed = now - _windowMs;
+
+    uint32_t frames = LVGLRenderer::flushStats().frames;
+    // A resetFlushStats() mid-window counts from zero
+    uint32_t drawn = frames >= _frames ? frames - _frames : frames;
+    s.fps = elapsed ? drawn * 1000.0f / elapsed : 0;
+    _frames = frames;
+
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < kBuckets; ++i) total += _hist[i];
+    s.loops = total;
+    s.loopP50Us = percentile_(total, 50);
+    s.loopP90Us = percentile_(total, 90);
+    s.loopP99Us = percentile_(total, 99);
+    s.loopMaxUs = _maxUs;
+    memset(_hist, 0, sizeof(_hist));
+    _maxUs = 0;
+
+    readTasks_(s);
+    _windowMs = now;
+}
+
+void SystemMonitor::readTasks_(Sample& s) {
+    s.cpuPct[0] = s.cpuPct[1] = -1;
+    s.taskCount = 0;
+#if DEVDASH_TASK_STATS
+    if (!_status) {
+        _status = heap_caps_malloc(sizeof(TaskStatus_t) * kMaxTasks, MALLOC_CAP_SPIRAM);
+        if (!_status) _status = heap_caps_malloc(sizeof(TaskStatus_t) * kMaxTasks, MALLOC_CAP_INTERNAL);
+    }
+    TaskStatus_t* status = static_cast<TaskStatus_t*>(_status);
+    uint32_t runTime = 0;
+    UBaseType_t n = status ? uxTaskGetSystemState(status, kMaxTasks, &runTime) : 0;
+    if (n) {
+        uint32_t span = runTime - _runTime;
+        for (uint8_t core = 0; core < portNUM_PROCESSORS && core < 2; ++core) {
+            TaskHandle_t idle = xTaskGetIdleTaskHandleForCPU(core);
+            for (UBaseType_t i = 0; i < n; ++i) {
+                if (status[i].xHandle != idle) continue;
+                uint32_t idleTime = status[i].ulRunTimeCounter;
+                // The first window has no baseline
+                if (_runTime && span) {
+                    uint32_t busy = 100 - (uint32_t)((uint64_t)(idleTime - _idleTime[core]) * 100 / span);
+                    s.cpuPct[core] = (int8_t)std::min<uint32_t>(busy, 100);
+                }
+                _idleTime[core] = idleTime;
+            }
+        }
+        _runTime = runTime;
+
+        for (UBaseType_t i = 0; i < n; ++i) {
+            TaskInfo& t = s.tasks[s.taskCount++];
+            strlcpy(t.name, status[i].pcTaskName, sizeof(t.name));
+            t.stackFree = status[i].usStackHighWaterMark; // bytes on ESP-IDF
+#if configTASKLIST_INCLUDE_COREID
+            t.core = status[i].xCoreID < portNUM_PROCESSORS ? (int8_t)status[i].xCoreID : -1;
+#else
+            t.core = -1;
+#endif
+        }
+        std::sort(s.tasks, s.tasks + s.taskCount,
+                  [](const TaskInfo& a, const TaskInfo& b) { return a.stackFree < b.stackFree; });
+        return;
+    }
+#endif
+    // Without the task list, or with more than kMaxTasks tasks: this task only
+    TaskInfo& t = s.tasks[s.taskCount++];
+    strlcpy(t.name, pcTaskGetTaskName(nullptr), sizeof(t.name));
+    t.stackFree = uxTaskGetStackHighWaterMark(nullptr);
+    t.core = (int8_t)xPortGetCoreID();
+}
+
+uint32_t SystemMonitor::percentile_(uint32_t total, uint8_t pct) const {
+    if (!total) return 0;
+    uint32_t want = (uint32_t)(((uint64_t)total * pct + 99) / 100);
+    uint32_t seen = 0;
+    for (uint8_t i = 0; i < kBuckets; ++i) {
+        seen += _hist[i];
+        if (seen >= want) return std::min(bucketTop_(i), _maxUs);
+    }
+    return _maxUs;
+}
+
+uint32_t SystemMonitor::bucketTop_(uint8_t i) {
+    if (i < 16) return i;
+    uint8_t octave = (i - 16) / 4 + 4;
+    uint32_t step = 1UL << (octave - 2);
+    return (4 + (i - 16) % 4) * step + step - 1;
+}
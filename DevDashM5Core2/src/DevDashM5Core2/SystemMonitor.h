@@ -0,0 +1,82 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * Cheap running counters for the System screen: loop() latency goes into a
+ * log-linear histogram (one increment per call), and once per period the
+ * monitor reads per-core CPU load and stack high-water marks from FreeRTOS
+ * and the frame count from LVGLRenderer, then restarts the window.
+ * Everything runs on the loop() task, so nothing is locked.
+ *
+ * CPU load needs FreeRTOS run-time stats and the task list needs its trace
+ * facility (both on in the Arduino-ESP32 core); without them cpuPct is -1
+ * and only the loop task is listed.
+ */
+class SystemMonitor {
+public:
+    SystemMonitor() = default;
+    ~SystemMonitor();
+    SystemMonitor(const SystemMonitor&) = delete;
+    SystemMonitor& operator=(const SystemMonitor&) = delete;
+
+    static constexpr uint8_t  kMaxTasks        = 32;   // more and the task list is skipped
+    static constexpr uint8_t  kBuckets         = 96;   // 0-15 us exact, then 4 per octave
+    static constexpr uint32_t kDefaultPeriodMs = 1000;
+
+    struct TaskInfo {
+        char     name[16];
+        uint32_t stackFree; // bytes never used, lowest first
+        int8_t   core;      // -1 if not pinned
+    };
+
+    struct Sample {
+        uint32_t ms = 0;
+        int8_t   cpuPct[2] = { -1, -1 };
+        float    fps = 0;
+        uint32_t loops = 0;     // loop() calls in the window
+        uint32_t loopP50Us = 0; // upper edge of the percentile's bucket
+        uint32_t loopP90Us = 0;
+        uint32_t loopP99Us = 0;
+        uint32_t loopMaxUs = 0;
+        uint8_t  taskCount = 0;
+        TaskInfo tasks[kMaxTasks];
+    };
+
+    /** Count one loop() call that took us microseconds */
+    void noteLoop(uint32_t us) {
+        ++_hist[bucket_(us)];
+        if (us > _maxUs) _maxUs = us;
+    }
+
+    /** Sample when the period is up; call from loop() */
+    void loop();
+    void setPeriod(uint32_t ms) { _periodMs = ms ? ms : kDefaultPeriodMs; }
+    uint32_t period() const { return _periodMs; }
+
+    /** The last complete window */
+    const Sample& latest() const { return _latest; }
+
+private:
+    uint32_t _hist[kBuckets] = {};
+    uint32_t _maxUs = 0;
+    uint32_t _periodMs = kDefaultPeriodMs;
+    uint32_t _windowMs = 0;       // start of the current window
+    uint32_t _frames = 0;         // LVGLRenderer frame count at that start
+    uint32_t _runTime = 0;        // FreeRTOS run-time counter at that start
+    uint32_t _idleTime[2] = {};   // per core idle task run time at that start
+    void*    _status = nullptr;   // TaskStatus_t[kMaxTasks] scratch, in PSRAM
+    Sample   _latest;
+
+    void sample_(uint32_t now);
+    void readTasks_(Sample& s);
+    uint32_t percentile_(uint32_t total, uint8_t pct) const;
+
+    static uint8_t bucket_(uint32_t us) {
+        if (us < 16) return (uint8_t)us;
+        uint8_t octave = 31 - __builtin_clz(us);              // 4 and up
+        uint8_t i = 16 + (octave - 4) * 4 + ((us >> (octave - 2)) & 3);
+        return i < kBuckets ? i : kBuckets - 1;
+    }
+    static uint32_t bucketTop_(uint8_t i);
+};
@@ -0,0 +1,120 @@
+#include "../DevDashConfig.h"
+#if DEVDASH_ENABLE_SYSTEM_SCREEN
+#include "SystemScreen.h"
+#include "ScreenManager.h"
+#include "HeapTracker.h"
+#include <WiFi.h>
+
+constexpr uint8_t SystemScreen::kShownTasks;
+
+void SystemScreen::build(lv_obj_t* screen, ThemeManager* theme, const ScreenManager* screens,
+                         const SystemMonitor* monitor) {
+    _screens = screens;
+    _monitor = monitor;
+    _periodMs = monitor ? monitor->period() : SystemMonitor::kDefaultPeriodMs;
+    lv_obj_t* container = theme->createContainer(screen);
+    lv_obj_t* header = lv_obj_create(container);
+    theme->addStyle(header, ThemeManager::Role::Header);
+    lv_obj_clear_flag(header, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_t* title = lv_label_create(header);
+    lv_label_set_text(title, "System");
+    theme->addStyle(title, ThemeManager::Role::HeaderTitle);
+
+    lv_obj_t* panel = theme->createPanel(container);
+    _text = lv_label_create(panel);
+    theme->addStyle(_text, ThemeManager::Role::FullWidth);
+    lv_label_set_long_mode(_text, LV_LABEL_LONG_WRAP);
+    refresh_();
+
+    _timer = lv_timer_create([](lv_timer_t* t){
+        static_cast<SystemScreen*>(lv_timer_get_user_data(t))->refresh_();
+    }, _periodMs, this);
+    lv_timer_pause(_timer);
+    lv_obj_add_event_cb(screen, [](lv_event_t* e){
+        auto* self = static_cast<SystemScreen*>(lv_event_get_user_data(e));
+        if (lv_event_get_code(e) == LV_EVENT_SCREEN_LOADED) {
+            self->refresh_();
+            lv_timer_resume(self->_timer);
+        } else if (lv_event_get_code(e) == LV_EVENT_SCREEN_UNLOADED) {
+            lv_timer_pause(self->_timer);
+        }
+    }, LV_EVENT_ALL, this);
+}
+
+void SystemScreen::release() {
+    if (_timer) {
+        lv_timer_delete(_timer);
+        _timer = nullptr;
+    }
+    _text = nullptr;
+}
+
+void SystemScreen::refresh_() {
+    if (!_text) return;
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    char text[1024];
+    size_t n = snprintf(text, sizeof(text),
+        "Uptime    %lu s\n"
+        "Heap      %u free, %u min\n"
+        "LVGL      %u of %u B used, %u%% frag\n",
+        (unsigned long)(millis() / 1000),
+        (unsigned)ESP.getFreeHeap(), (unsigned)ESP.getMinFreeHeap(),
+        (unsigned)(mon.total_size - mon.free_size), (unsigned)mon.total_size, (unsigned)mon.frag_pct);
+    if (_monitor && n < sizeof(text)) {
+        // Follows the monitor's period, which may change at run time
+        if (_timer && _periodMs != _monitor->period()) {
+            _periodMs = _monitor->period();
+            lv_timer_set_period(_timer, _periodMs);
+        }
+        n += formatMonitor_(_monitor->latest(), text + n, sizeof(text) - n);
+    }
+    // Tag figures change against the first refresh after boot
+    HeapTracker::Snapshot heap;
+    HeapTracker::snapshot(heap);
+    if (!_heapBaseSet) { _heapBase = heap; _heapBaseSet = true; }
+    if (n < sizeof(text)) n += HeapTracker::format(heap, &_heapBase, text + n, sizeof(text) - n);
+    if (_screens && n < sizeof(text)) {
+        const ScreenManager::Stats& s = _screens->stats();
+        n += snprintf(text + n, sizeof(text) - n, "Screens   %u B cached of %u B, %u builds, %u evictions\n",
+                      (unsigned)s.cachedBytes, (unsigned)_screens->memoryBudget(), s.builds, s.evictions);
+#if DEVDASH_STYLE_TIMING
+        if (n < sizeof(text)) {
+            n += snprintf(text + n, sizeof(text) - n, "Styles    %lu ns per lookup, last screen built\n",
+                          (unsigned long)s.lookupNs);
+        }
+#endif
+    }
+    if (n < sizeof(text)) {
+        if (WiFi.status() == WL_CONNECTED) {
+            IPAddress ip = WiFi.localIP();
+            snprintf(text + n, sizeof(text) - n, "Wi-Fi     %u.%u.%u.%u, %d dBm",
+                     ip[0], ip[1], ip[2], ip[3], (int)WiFi.RSSI());
+        } else {
+            snprintf(text + n, sizeof(text) - n, "Wi-Fi     not connected");
+        }
+    }
+    lv_label_set_text(_text, text);
+}
+
+size_t SystemScreen::formatMonitor_(const SystemMonitor::Sample& s, char* out, size_t len) {
+    char cpu[2][8];
+    for (uint8_t i = 0; i < 2; ++i) {
+        if (s.cpuPct[i] < 0) strlcpy(cpu[i], "n/a", sizeof(cpu[i]));
+        else snprintf(cpu[i], sizeof(cpu[i]), "%d%%", s.cpuPct[i]);
+    }
+    size_t n = snprintf(out, len,
+        "CPU       core 0 %s, core 1 %s\n"
+        "Frames    %.1f/s\n"
+        "Loop      p50 %lu, p90 %lu, p99 %lu, max %lu us\n"
+        "Stack     lowest free of %u tasks:\n",
+        cpu[0], cpu[1], s.fps,
+        (unsigned long)s.loopP50Us, (unsigned long)s.loopP90Us, (unsigned long)s.loopP99Us,
+        (unsigned long)s.loopMaxUs, (unsigned)s.taskCount);
+    for (uint8_t i = 0; i < s.taskCount && i < kShownTasks && n < len; ++i) {
+        const SystemMonitor::TaskInfo& t = s.tasks[i];
+        n += snprintf(out + n, len - n, "  %-15s %5u B\n", t.name, (unsigned)t.stackFree);
+    }
+    return n < len ? n : len - 1;
+}
+#endif // DEVDASH_ENABLE_SYSTEM_SCREEN
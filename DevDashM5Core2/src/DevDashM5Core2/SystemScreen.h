@@ -0,0 +1,37 @@
+#pragma once
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include "ThemeManager.h"
+#include "HeapTracker.h"
+#include "SystemMonitor.h"
+
+class ScreenManager;
+
+/**
+ * Device status screen: uptime, per-core CPU load, frame rate, loop()
+ * latency percentiles, the tasks closest to running out of stack, heap per
+ * region and per subsystem, LVGL memory and the screen cache. Refreshed at
+ * the monitor's period while it is loaded.
+ */
+class SystemScreen {
+public:
+    static constexpr uint8_t kShownTasks = 6;
+
+    void build(lv_obj_t* screen, ThemeManager* theme, const ScreenManager* screens,
+               const SystemMonitor* monitor);
+    /** Stop refreshing; call before the screen built into is deleted */
+    void release();
+
+private:
+    lv_obj_t*            _text = nullptr;
+    lv_timer_t*          _timer = nullptr;
+    const ScreenManager* _screens = nullptr;
+    const SystemMonitor* _monitor = nullptr;
+    uint32_t             _periodMs = SystemMonitor::kDefaultPeriodMs;
+    HeapTracker::Snapshot _heapBase;
+    bool                 _heapBaseSet = false;
+
+    void refresh_();
+    static size_t formatMonitor_(const SystemMonitor::Sample& s, char* out, size_t len);
+};
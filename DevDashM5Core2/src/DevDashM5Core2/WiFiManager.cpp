@@ -1,9 +1,25 @@
 #include "WifiManager.h"
 #include <SPIFFS.h>
-#include <ArduinoJson.h>
+#include <esp_wifi.h>
+#include "AllocCounter.h"
+#include "../DevDashLog.h"
+
+constexpr uint8_t  WifiManager::kMaxScanResults;
+constexpr uint8_t  WifiManager::kMaxHints;
+constexpr uint32_t WifiManager::kFullSweepDwellMs;
+constexpr uint32_t WifiManager::kRoamCooldownMs;
+constexpr int8_t   WifiManager::kRoamHysteresisDb;
+constexpr float    WifiManager::kRoamLossPerMin;
+
+// Balanced matches the Arduino defaults (min modem sleep, full TX power)
+static const PowerProfileParams kProfiles[] = {
+    { "Max performance", WIFI_PS_NONE,      1,  WIFI_POWER_19_5dBm,  500,  2000, 20,  0 },
+    { "Balanced",        WIFI_PS_MIN_MODEM, 3,  WIFI_POWER_19_5dBm, 1000,  5000, 33,  5 },
+    { "Low power",       WIFI_PS_MAX_MODEM, 10, WIFI_POWER_11dBm,   5000, 15000, 66, 20 },
+};
 
 WifiManager::WifiManager()
-  : _lastError(WiFiError::None), _autoReconnect(false) {}
+  : _lastError(WiFiError::None), _autoReconnect(false), _store(SPIFFS, kStorePath) {}
 
 WifiManager::~WifiManager() {
     destroy();
@@ -16,59 +32,296 @@ bool WifiManager::begin() {
     }
     WiFi.mode(WIFI_STA);
     WiFi.disconnect(true);
+    setPowerProfile(_profile);
+
+    // Our own disconnect() reports ASSOC_LEAVE; anything else is the link dropping
+    if (_linkEventId < 0) {
+        _linkEventId = WiFi.onEvent([this](WiFiEvent_t, WiFiEventInfo_t info) {
+            if (info.wifi_sta_disconnected.reason != WIFI_REASON_ASSOC_LEAVE) _link.noteLinkLoss();
+        }, ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+    }
     return true;
 }
 
-std::vector<WiFiNetwork> WifiManager::scanNetworks(uint8_t maxCount) {
-    std::vector<WiFiNetwork> out;
-    int n = WiFi.scanNetworks();
+Span<const WiFiNetwork> WifiManager::scanNetworks(uint8_t maxCount) {
+    AllocCounter::Probe allocs;
+    uint32_t start = millis();
+    int n = WiFi.scanNetworks(false, false, false, kFullSweepDwellMs);
+    _lastScan.radioOnMs = millis() - start;
+    _lastScan.channels  = 0; // all
+    _lastScan.fullSweep = true;
+    _lastScan.allocs    = 0;
+    _targetedSinceFull  = 0;
+    // Readers on other tasks keep the shown list until the swap
+    uint8_t back = _shown ^ 1;
+    _scannedCount[back] = 0;
+    collectScanResults_(n, _scanned[back], _scannedCount[back]);
+    finishScan_(_scanned[back], _scannedCount[back], maxCount, start, allocs);
+    showScanned_(back);
+    _scanUpdated = true;
+    return getScannedNetworks();
+}
+
+Span<const WiFiNetwork> WifiManager::scanSaved(uint8_t maxCount) {
+    uint8_t channels[14];
+    uint8_t count = 0;
+    for (uint8_t k = 0; k < _hintCount; ++k) {
+        const ApHint& h = _hints[k];
+        if (!_store.find(h.ssid.c_str()) || h.channel == 0 || h.channel > 14) continue;
+        bool seen = false;
+        for (uint8_t i = 0; i < count; ++i) if (channels[i] == h.channel) { seen = true; break; }
+        if (!seen) channels[count++] = h.channel;
+    }
+    if (count == 0 || ++_targetedSinceFull >= _fullSweepEvery) {
+        return scanNetworks(maxCount);
+    }
+
+    AllocCounter::Probe allocs;
+    uint32_t start = millis();
+    _lastScan.radioOnMs = 0;
+    _lastScan.allocs = 0;
+    // Only the saved networks' channels answered; the shown list keeps the last sweep
+    _probedCount = 0;
+    for (uint8_t i = 0; i < count; ++i) {
+        uint32_t t = millis();
+        int n = WiFi.scanNetworks(false, false, false, _scanDwellMs, channels[i]);
+        _lastScan.radioOnMs += millis() - t;
+        collectScanResults_(n, _probed, _probedCount);
+    }
+    _lastScan.channels  = count;
+    _lastScan.fullSweep = false;
+
+    bool anySaved = false;
+    for (const auto& nw : probed_()) if (_store.find(nw.ssid.c_str())) { anySaved = true; break; }
+    if (!anySaved) {
+        // Networks may have moved channel; the sweep refreshes the hints
+        DD_LOGI(Wifi, "Targeted scan found no saved networks, sweeping all channels");
+        return scanNetworks(maxCount);
+    }
+    finishScan_(_probed, _probedCount, maxCount, start, allocs);
+    return probed_();
+}
 
-    // track best RSSI per SSID using linear lookups (n is small)
-    struct Best { int idx; int rssi; };
-    std::vector<String> ssids;
-    std::vector<Best>   bests;
-    ssids.reserve(n); bests.reserve(n);
+Span<const WiFiNetwork> WifiManager::scanFor(const char* ssid, bool anyChannel) {
+    if (!ssid || !ssid[0]) return Span<const WiFiNetwork>();
+    const ApHint* hint = anyChannel ? nullptr : findHint_(ssid);
+    uint8_t channel = hint ? hint->channel : 0;
 
+    AllocCounter::Probe allocs;
+    uint32_t start = millis();
+    // show_hidden so a probe for a hidden SSID still reports its answer
+    int n = WiFi.scanNetworks(false, true, false, _scanDwellMs, channel, ssid);
+    _lastScan.radioOnMs = millis() - start;
+    _lastScan.channels  = channel;
+    _lastScan.fullSweep = (channel == 0);
+    _lastScan.allocs    = 0;
+    _probedCount = 0;
+    collectScanResults_(n, _probed, _probedCount);
+    finishScan_(_probed, _probedCount, 1, start, allocs);
+    return probed_();
+}
+
+bool WifiManager::startScan() {
+    if (!startSweep_()) return false;
+    _publishScan = true; // also when it joins a sweep the manager started
+    return true;
+}
+
+bool WifiManager::startSweep_() {
+    if (_scanPending) return true;
+    _publishScan = false;
+    AllocCounter::Probe allocs;
+    _scanStartMs = millis();
+    int started = WiFi.scanNetworks(true, false, false, kFullSweepDwellMs);
+    _sweepStartAllocs = (uint16_t)allocs.count();
+    if (started == WIFI_SCAN_FAILED) {
+        _lastError = WiFiError::ScanFailed;
+        return false;
+    }
+    _scanPending = true;
+    return true;
+}
+
+bool WifiManager::pollScan(uint8_t maxCount) {
+    if (!_scanPending) return false;
+    AllocCounter::Probe allocs;
+    int n = WiFi.scanComplete();
+    if (n == WIFI_SCAN_RUNNING) return false;
+    _scanPending = false;
+    if (n == WIFI_SCAN_FAILED) {
+        _lastError = WiFiError::ScanFailed;
+        if (!_publishScan) _probedCount = 0;
+        return true;
+    }
+    _lastScan.radioOnMs = millis() - _scanStartMs;
+    _lastScan.channels  = 0;
+    _lastScan.fullSweep = true;
+    _lastScan.allocs    = _sweepStartAllocs; // starting it; the polls in between are not counted
+    _targetedSinceFull  = 0;
+    // Sweeps the manager started for itself (roam, reconnect) leave the shown list alone
+    uint8_t back = _shown ^ 1;
+    WiFiNetwork* list = _publishScan ? _scanned[back] : _probed;
+    uint8_t& count = _publishScan ? _scannedCount[back] : _probedCount;
+    count = 0;
+    collectScanResults_(n, list, count);
+    finishScan_(list, count, maxCount, _scanStartMs, allocs);
+    if (_publishScan) {
+        showScanned_(back);
+        _scanUpdated = true;
+    }
+    return true;
+}
+
+void WifiManager::setScanConfig(uint32_t dwellMs, uint8_t fullSweepEvery) {
+    _scanDwellMs = dwellMs;
+    _fullSweepEvery = fullSweepEvery ? fullSweepEvery : 1;
+}
+
+void WifiManager::collectScanResults_(int n, WiFiNetwork* list, uint8_t& count) {
+    // Keep the strongest BSSID per SSID using linear lookups (n is small).
+    // The records are read in place: WiFi.SSID(i) would build a String.
     for (int i = 0; i < n; ++i) {
-        String ssid = WiFi.SSID(i);
-        if (ssid.length() == 0) continue;
-        int rssi = WiFi.RSSI(i);
+        auto* ap = static_cast<const wifi_ap_record_t*>(WiFi.getScanInfoByIndex(i));
+        if (!ap) continue;
+        const char* ssid = reinterpret_cast<const char*>(ap->ssid);
+        size_t len = strnlen(ssid, sizeof(ap->ssid));
+        if (len == 0) continue;
+
+        WiFiNetwork* nw = nullptr;
+        for (uint8_t k = 0; k < count; ++k) {
+            if (list[k].ssid.equals(ssid, len)) { nw = &list[k]; break; }
+        }
+        if (nw && nw->rssi >= ap->rssi) continue;
+        if (!nw) {
+            if (count == kMaxScanResults) continue;
+            nw = &list[count++];
+            nw->ssid.assign(ssid, len);
+        }
+        nw->rssi = ap->rssi;
+        nw->channel = ap->primary;
+        memcpy(nw->bssid, ap->bssid, sizeof(nw->bssid));
+    }
+    if (n > 0) WiFi.scanDelete();
+}
 
-        int k = -1;
-        for (size_t j = 0; j < ssids.size(); ++j) if (ssids[j] == ssid) { k = (int)j; break; }
-        if (k < 0) { ssids.push_back(ssid); bests.push_back({i, rssi}); }
-        else if (rssi > bests[k].rssi) { bests[k] = {i, rssi}; }
+void WifiManager::finishScan_(WiFiNetwork* list, uint8_t& count, uint8_t maxCount, uint32_t start,
+                              const AllocCounter::Probe& allocs) {
+    for (uint8_t i = 0; i < count; ++i) {
+        const WiFiNetwork& nw = list[i];
+        if (_store.find(nw.ssid.c_str())) rememberHint_(nw.ssid.c_str(), nw.channel, nw.bssid);
     }
+    if (count > maxCount) count = maxCount;
+    _lastScan.allocs += (uint16_t)allocs.count();
+
+    _lastScan.durationMs = millis() - start;
+    DD_LOGI(Wifi, "Scan (%s, %u ch): %lu ms, radio %lu ms, %u networks, %u allocs",
+            _lastScan.fullSweep ? "full" : "targeted", _lastScan.channels,
+            (unsigned long)_lastScan.durationMs, (unsigned long)_lastScan.radioOnMs,
+            (unsigned)count, (unsigned)_lastScan.allocs);
+}
+
+void WifiManager::restoreScanResults(Span<const WiFiNetwork> networks) {
+    uint8_t back = _shown ^ 1;
+    _scannedCount[back] = networks.size() < kMaxScanResults ? (uint8_t)networks.size() : kMaxScanResults;
+    for (uint8_t i = 0; i < _scannedCount[back]; ++i) _scanned[back][i] = networks[i];
+    showScanned_(back);
+}
 
-    for (size_t j = 0; j < ssids.size() && (int)out.size() < maxCount; ++j) {
-        WiFiNetwork nw;
-        nw.ssid = ssids[j];
-        nw.rssi = bests[j].rssi;
-        out.push_back(nw);
+void WifiManager::showScanned_(uint8_t list) {
+    // The entries must be visible to the other core before the index is
+    __sync_synchronize();
+    _shown = list;
+}
+
+void WifiManager::rememberHint_(const char* ssid, uint8_t channel, const uint8_t* bssid) {
+    if (!bssid) return;
+    ApHint* hint = const_cast<ApHint*>(findHint_(ssid));
+    if (!hint) {
+        // One slot per saved network; if they are all taken, reuse the oldest
+        if (_hintCount < kMaxHints) {
+            hint = &_hints[_hintCount++];
+        } else {
+            hint = &_hints[_nextHint];
+            _nextHint = (uint8_t)((_nextHint + 1) % kMaxHints);
+        }
+        hint->ssid = ssid;
     }
-    _scannedNetworks = out; // store for later use
-    return out;
+    hint->channel = channel;
+    memcpy(hint->bssid, bssid, sizeof(hint->bssid));
 }
 
+const WifiManager::ApHint* WifiManager::findHint_(const char* ssid) const {
+    for (uint8_t k = 0; k < _hintCount; ++k) if (_hints[k].ssid == ssid) return &_hints[k];
+    return nullptr;
+}
 
 bool WifiManager::connect(const char* ssid, const char* password, uint32_t timeoutMs) {
-    Serial.printf("Connecting to %s \n", ssid);
-    WiFi.begin(ssid, password);
+    return connect(ssid, password, 0, nullptr, timeoutMs);
+}
+
+bool WifiManager::connect(const char* ssid, const char* password, int32_t channel, const uint8_t* bssid,
+                          uint32_t timeoutMs) {
+    DD_LOGI(Wifi, "Connecting to %s", ssid);
+    AllocCounter::Probe allocs;
+    // WiFi.begin() rebuilds the STA config, so set the listen interval in between
+    WiFi.begin(ssid, password, channel, bssid, false);
+    applyListenInterval_();
+    esp_wifi_connect();
     uint32_t start = millis();
     while (WiFi.status() != WL_CONNECTED) {
         if (millis() - start > timeoutMs) {
             _lastError = WiFiError::Timeout;
+            _connectAllocs = (uint16_t)allocs.count();
             return false;
         }
         delay(100);
     }
-    Serial.println();
-    Serial.print("Connected with IP: ");
-    Serial.println(WiFi.localIP());
-    Serial.println();
+    _connectAllocs = (uint16_t)allocs.count(); // connected_() adds its own
+    connected_(ssid, password);
+    return true;
+}
+
+void WifiManager::startConnect(const char* ssid, const char* password, int32_t channel, const uint8_t* bssid,
+                               uint32_t timeoutMs) {
+    DD_LOGI(Wifi, "Connecting to %s (background)", ssid);
+    AllocCounter::Probe allocs;
+    WiFi.begin(ssid, password, channel, bssid, false);
+    applyListenInterval_();
+    esp_wifi_connect();
+    _connectSsid = ssid;
+    _connectPassword = password;
+    _connectDeadlineMs = millis() + timeoutMs;
+    _connectPending = true;
+    _connectAllocs = (uint16_t)allocs.count();
+}
+
+void WifiManager::pollConnect_() {
+    if (WiFi.status() == WL_CONNECTED) {
+        _connectPending = false;
+        connected_(_connectSsid.c_str(), _connectPassword.c_str());
+    } else if ((int32_t)(millis() - _connectDeadlineMs) >= 0) {
+        _connectPending = false;
+        _lastError = WiFiError::Timeout;
+        DD_LOGW(Wifi, "Connecting to %s timed out", _connectSsid.c_str());
+    } else {
+        return;
+    }
+    _connectPassword.clear();
+}
+
+void WifiManager::connected_(const char* ssid, const char* password) {
+    AllocCounter::Probe allocs;
     _lastError = WiFiError::None;
+    // Only a new or changed password is written, which opens the store file
     saveCredentials(ssid, password);
-    return true;
+    rememberHint_(ssid, (uint8_t)WiFi.channel(), WiFi.BSSID());
+    _link.reset();
+    _nextLinkSampleMs = millis();
+    _connectAllocs += (uint16_t)allocs.count();
+
+    IPAddress ip = WiFi.localIP();
+    DD_LOGI(Wifi, "Connected with IP: %u.%u.%u.%u (%u allocs)", ip[0], ip[1], ip[2], ip[3],
+            (unsigned)_connectAllocs);
 }
 
 void WifiManager::disconnect() {
@@ -79,8 +332,15 @@ bool WifiManager::isConnected() const {
     return (WiFi.status() == WL_CONNECTED);
 }
 
-String WifiManager::currentSSID() const {
-    return WiFi.SSID();
+SsidString WifiManager::currentSSID() const {
+    // From the STA config, as WiFi.SSID() does, without building a String
+    SsidString ssid;
+    wifi_config_t conf;
+    if (esp_wifi_get_config(WIFI_IF_STA, &conf) == ESP_OK) {
+        const char* s = reinterpret_cast<const char*>(conf.sta.ssid);
+        ssid.assign(s, strnlen(s, sizeof(conf.sta.ssid)));
+    }
+    return ssid;
 }
 
 int32_t WifiManager::rssi() const {
@@ -90,73 +350,34 @@ int32_t WifiManager::rssi() const {
 bool WifiManager::saveCredentials(const char* ssid, const char* password) {
     if (!ssid || !ssid[0]) { _lastError = WiFiError::SaveFailed; return false; }
 
-    // Check if this SSID already exists in the saved list
-    for (const auto& n : _savedNetworks) {
-        if (n.ssid == ssid) {
-            // SSID already present — no change required.
-            // Still ensure the file exists/is up-to-date.
-            return writeSavedNetworksToFile_();
-        }
-    }
-
-    // Add new entry (allow empty password for open networks)
-    SavedWiFiNetwork entry{ String(ssid), String(password ? password : "") };
-    _savedNetworks.push_back(entry);
-
-    if (!writeSavedNetworksToFile_()) { _lastError = WiFiError::SaveFailed; return false; }
+    // Appends a record only if the SSID is new or its password changed
+    if (!_store.put(ssid, password)) { _lastError = WiFiError::SaveFailed; return false; }
     _lastError = WiFiError::None;
     return true;
 }
 
-bool WifiManager::writeSavedNetworksToFile_() {
-    // Size: base + per-network overhead
-    const size_t base = 1024;
-    const size_t per  = 128;
-    DynamicJsonDocument doc(base + (_savedNetworks.size() * per));
-
-    JsonObject root = doc.to<JsonObject>();
-    JsonArray arr = root.createNestedArray("networks");
-
-    for (const auto& n : _savedNetworks) {
-        if (!n.ssid.length()) continue; // skip empty
-        JsonObject o = arr.createNestedObject();
-        o["ssid"] = n.ssid;
-        o["password"] = n.password;
-    }
-
-    File f = SPIFFS.open(kJsonPath, FILE_WRITE);
-    if (!f) { return false; }
-    if (serializeJson(doc, f) == 0) { f.close(); return false; }
-    f.close();
+bool WifiManager::forgetCredentials(const char* ssid) {
+    if (!_store.erase(ssid)) { _lastError = WiFiError::SaveFailed; return false; }
+    _lastError = WiFiError::None;
     return true;
 }
 
 bool WifiManager::loadCredentials() {
-    Serial.println("Loading WiFi credentials from SPIFFS...");
+    DD_LOGI(Storage, "Loading WiFi credentials from SPIFFS...");
     if (!_credsLoaded) {
-        File file = SPIFFS.open(kJsonPath, FILE_READ);
-        if (!file) {
-            _lastError = WiFiError::LoadFailed;
-            return false;
+        uint32_t start = micros();
+        bool ok = _store.load();
+        if (SPIFFS.exists(kLegacyJsonPath)) {
+            DD_LOGI(Storage, "Migrating credentials from /wifi.json");
+            ok = _store.migrateFromJson(kLegacyJsonPath) || ok;
         }
-        Serial.println("Loading credentials from /wifi.json");
-        StaticJsonDocument<512> doc;
-        DeserializationError error = deserializeJson(doc, file);
-        if (error) {
-            Serial.print("Failed to parse JSON: ");
-            Serial.println(error.c_str());
+        if (!ok) {
+            _lastError = WiFiError::LoadFailed;
             return false;
         }
-        file.close();
-        JsonArray networks = doc["networks"].as<JsonArray>();
-        for (JsonObject network : networks) {
-            const String ssid = network["ssid"];
-            const String password = network["password"];
-            _savedNetworks.push_back({ssid, password});
-        }
         _lastError = WiFiError::None;
-        
-        Serial.printf("Loaded %d saved networks.\n", _savedNetworks.size());
+
+        DD_LOGI(Storage, "Loaded %u saved networks in %lu us.", (unsigned)_store.size(), (unsigned long)(micros() - start));
         _credsLoaded = true;
         return true;
     }
@@ -171,55 +392,165 @@ void WifiManager::setAutoReconnect(bool enable) {
     _autoReconnect = enable;
 }
 
+const PowerProfileParams& WifiManager::profileParams(PowerProfile p) {
+    return kProfiles[static_cast<int>(p)];
+}
+
+void WifiManager::setPowerProfile(PowerProfile p) {
+    _profile = p;
+    const PowerProfileParams& pp = profileParams(p);
+    WiFi.setSleep(pp.sleep);
+    WiFi.setTxPower(pp.txPower);
+    applyListenInterval_();
+    _nextLinkSampleMs = millis();
+    DD_LOGI(Wifi, "Power profile: %s", pp.name);
+}
+
+void WifiManager::applyListenInterval_() {
+    // Only takes effect from the next association
+    wifi_config_t conf;
+    if (esp_wifi_get_config(WIFI_IF_STA, &conf) != ESP_OK) return;
+    conf.sta.listen_interval = profileParams(_profile).listenInterval;
+    esp_wifi_set_config(WIFI_IF_STA, &conf);
+}
+
+#if DEVDASH_ENABLE_DIAGNOSTICS
+void WifiManager::setBenchEndpoint(const char* host, uint16_t port) {
+    _benchCfg.host = host ? host : "";
+    _benchCfg.port = port;
+}
+
+NetBench::Report WifiManager::runBenchmark() {
+    uint32_t start = millis();
+    NetBench::Report r = NetBench::run(_benchCfg);
+    DD_LOGI(Wifi, "Benchmark against %s:%u finished in %lu ms (%s)", _benchCfg.host, _benchCfg.port,
+            (unsigned long)(millis() - start), r.ok ? "ok" : r.error.c_str());
+    return r;
+}
+#endif
+
+void WifiManager::setRoaming(bool enable, int8_t thresholdDbm, uint8_t holdSamples) {
+    _roaming = enable;
+    _link.setWeakThreshold(thresholdDbm);
+    _roamHoldSamples = holdSamples ? holdSamples : 1;
+}
+
+void WifiManager::sampleLink_() {
+    uint32_t now = millis();
+    if ((int32_t)(now - _nextLinkSampleMs) < 0) return;
+    _nextLinkSampleMs = now + powerParams().linkSampleMs;
+    _link.addSample(now, (int8_t)WiFi.RSSI());
+    if (_roaming) maybeRoam_();
+}
+
+void WifiManager::maybeRoam_() {
+    // A weak signal, or an AP that keeps dropping us even when it looks strong
+    bool weak = _link.weakStreak() >= _roamHoldSamples;
+    if (!weak && _link.lossRate() < kRoamLossPerMin) return;
+    uint32_t now = millis();
+    if ((int32_t)(now - _nextRoamMs) < 0) return;
+    _nextRoamMs = now + kRoamCooldownMs;
+
+    SsidString ssid = currentSSID();
+    if (!_store.find(ssid.c_str())) return;
+
+    if (_nonBlocking) {
+        // Background sweep; scanFinished_() takes it from there
+        _roamPending = startSweep_();
+        return;
+    }
+    // Other APs of the same ESS may sit on any channel
+    Span<const WiFiNetwork> found = scanFor(ssid.c_str(), true);
+    if (!found.empty()) finishRoam_(found.front());
+}
+
+void WifiManager::finishRoam_(const WiFiNetwork& best) {
+    if (!isConnected()) return;
+    SsidString ssid = currentSSID();
+    const SavedWiFiNetwork* saved = _store.find(ssid.c_str());
+    if (!saved || best.ssid != ssid) return;
+
+    uint8_t current[6] = {0};
+    const uint8_t* cur = WiFi.BSSID();
+    if (cur) memcpy(current, cur, sizeof(current));
+    int8_t rssi = _link.smoothedRssi();
+    if (memcmp(best.bssid, current, sizeof(current)) == 0) return;
+    if (best.rssi < rssi + kRoamHysteresisDb) return;
+
+    DD_LOGI(Wifi, "Roaming %s: %d dBm -> %d dBm on channel %u",
+            ssid.c_str(), rssi, (int)best.rssi, best.channel);
+    if (_nonBlocking) {
+        startConnect(saved->ssid.c_str(), saved->password.c_str(), best.channel, best.bssid);
+    } else if (!connect(saved->ssid.c_str(), saved->password.c_str(), best.channel, best.bssid)) {
+        DD_LOGW(Wifi, "Roam failed, auto-reconnect will pick up");
+    }
+}
+
 void WifiManager::loop() {
-    // Serial.println("AutoConnect: " + String(_autoReconnect));
-    // Serial.println("isConnected: " + String(isConnected()));
-    if (_autoReconnect && !isConnected()) {
-        std::vector<WiFiNetwork> matchedNetworks;
-        Serial.println("ScannedNetworks: " + String(_scannedNetworks.size()));
-        Serial.println("SavedNetworks: " + String(_savedNetworks.size()));
-        if (!_scannedNetworks.empty()) {
-            for (const auto& scanned : _scannedNetworks) {
-                for (const auto& saved : _savedNetworks) {
-                    if (scanned.ssid == saved.ssid) {
-                        matchedNetworks.push_back(scanned);
-                    }
-                }
-            }
+    if (_scanPending && pollScan(20)) scanFinished_();
+    if (_connectPending) {
+        pollConnect_();
+        return;
+    }
+    if (isConnected()) {
+        sampleLink_();
+        return;
+    }
+    if (_autoReconnect && _store.size() && (int32_t)(millis() - _nextReconnectMs) >= 0) {
+        _nextReconnectMs = millis() + powerParams().reconnectIntervalMs;
+        if (_nonBlocking) {
+            _reconnectPending = startSweep_();
+            return;
         }
-        // Find strongest network from matchedNetworks
-        WiFiNetwork strongestNetwork;
-        SavedWiFiNetwork strongestSaved;
-        bool hasStrongest = false;
-
-        for (const auto& net : matchedNetworks) {
-            if (!hasStrongest || net.rssi > strongestNetwork.rssi) {
-                strongestNetwork = net;
-                hasStrongest = true;
-            }
+        connectStrongestSaved_(scanSaved(20));
+    }
+}
+
+void WifiManager::scanFinished_() {
+    Span<const WiFiNetwork> found = _publishScan ? getScannedNetworks() : probed_();
+    if (_reconnectPending) {
+        _reconnectPending = false;
+        if (!isConnected() && !_connectPending) connectStrongestSaved_(found);
+    }
+    if (_roamPending) {
+        _roamPending = false;
+        SsidString ssid = currentSSID();
+        for (const auto& nw : found) {
+            if (nw.ssid == ssid) { finishRoam_(nw); break; }
         }
+    }
+}
 
-        // strongestNetwork now holds the network with the highest RSSI (if any matched)
-        if (hasStrongest) {
-            Serial.println("Strongest matched network: " + strongestNetwork.ssid + 
-                        " (RSSI: " + String(strongestNetwork.rssi) + ")");
-            // I need to find this network in saved networks to get the password
-            for (const auto& saved : _savedNetworks) {
-                if (saved.ssid == strongestNetwork.ssid) {
-                    strongestSaved = saved;
-                    break;
-                }
-            }
-            connect(strongestSaved.ssid.c_str(), strongestSaved.password.c_str());
-            Serial.println("Connected to " + strongestSaved.ssid + " successfully.");
+void WifiManager::connectStrongestSaved_(Span<const WiFiNetwork> found) {
+    DD_LOGD(Wifi, "ScannedNetworks: %u, SavedNetworks: %u", (unsigned)found.size(),
+            (unsigned)_store.size());
+    // Find the strongest scanned network we have credentials for
+    const WiFiNetwork* strongest = nullptr;
+    for (const auto& scanned : found) {
+        if (!_store.find(scanned.ssid.c_str())) continue;
+        if (!strongest || scanned.rssi > strongest->rssi) strongest = &scanned;
+    }
+    if (!strongest) {
+        DD_LOGI(Wifi, "No matched networks found.");
+        return;
+    }
 
-        } else {
-            Serial.println("No matched networks found.");
-        }
+    DD_LOGI(Wifi, "Strongest matched network: %s (RSSI: %d)", strongest->ssid.c_str(), (int)strongest->rssi);
+    // Copy: a blocking connect may rescan and replace the stored results
+    WiFiNetwork target = *strongest;
+    SavedWiFiNetwork saved = *_store.find(target.ssid.c_str());
+    if (_nonBlocking) {
+        startConnect(saved.ssid.c_str(), saved.password.c_str(), target.channel, target.bssid);
+    } else if (connect(saved.ssid.c_str(), saved.password.c_str(), target.channel, target.bssid)) {
+        DD_LOGI(Wifi, "Connected to %s successfully.", saved.ssid.c_str());
     }
 }
 
 void WifiManager::destroy() {
+    if (_linkEventId >= 0) {
+        WiFi.removeEvent((wifi_event_id_t)_linkEventId);
+        _linkEventId = -1;
+    }
     disconnect();
     SPIFFS.end();
 }
\ No newline at end of file
@@ -1,9 +1,15 @@
 #pragma once
 
 #include <Arduino.h>
-#include <vector>
 #include <FS.h>
 #include <WiFi.h>
+#include "CredentialStore.h"
+#include "LinkMonitor.h"
+#include "AllocCounter.h"
+#include "../DevDashConfig.h"
+#if DEVDASH_ENABLE_DIAGNOSTICS
+#include "NetBench.h"
+#endif
 
 /**
  * Error codes for WiFi operations
@@ -22,29 +28,126 @@ enum class WiFiError {
  * Representation of a WiFi network
  */
 struct WiFiNetwork {
-    String ssid;
-    int32_t rssi;
+    SsidString ssid;
+    int32_t rssi = 0;
+    uint8_t channel = 0;
+    uint8_t bssid[6] = {0};
 };
 
-struct SavedWiFiNetwork {
-    String ssid;
-    String password;
+/**
+ * Timing of the most recent scan. radioOnMs sums the per-channel scan
+ * calls, durationMs also includes result processing. allocs counts the
+ * heap allocations the calling task made from starting the scan to storing
+ * its results (AllocCounter); the Wi-Fi driver's own tasks are not counted,
+ * nor are the polls while a background sweep runs.
+ */
+struct ScanStats {
+    uint32_t durationMs = 0;
+    uint32_t radioOnMs  = 0;
+    uint16_t allocs     = 0;
+    uint8_t  channels   = 0;
+    bool     fullSweep  = false;
+};
+
+/**
+ * Radio power-save trade-offs. Each profile also sets how often the
+ * manager polls and how fast the UI refreshes.
+ */
+enum class PowerProfile { MaxPerformance, Balanced, LowPower };
+
+struct PowerProfileParams {
+    const char*    name;
+    wifi_ps_type_t sleep;
+    uint8_t        listenInterval;      // beacon intervals between wakeups in modem sleep
+    wifi_power_t   txPower;
+    uint32_t       linkSampleMs;
+    uint32_t       reconnectIntervalMs;
+    uint32_t       uiRefreshMs;         // LVGL display refresh period
+    uint32_t       loopIdleMs;          // idle time at the end of each device loop
 };
 
+/**
+ * Scan results, hints and saved credentials are kept in fixed arrays and
+ * handed out as views, so scanning, connecting and looking up networks do
+ * not allocate once the manager exists.
+ *
+ * Not thread-safe: one task at a time drives the manager. The one exception
+ * is getScannedNetworks(), which another task may read while a full sweep
+ * runs. Sweeps fill the hidden half of a double buffer and swap it in when
+ * they finish, so the shown half never changes under a reader.
+ */
 class WifiManager {
 public:
+    static constexpr uint8_t kMaxScanResults = 20;
+
     WifiManager();
     ~WifiManager();
 
     /** Initialize WiFi subsystem and SPIFFS */
     bool begin();
 
-    /** Scan for available networks (up to maxCount) */
-    std::vector<WiFiNetwork> scanNetworks(uint8_t maxCount = 10);
+    /**
+     * Scan all channels for available networks (up to maxCount, at most
+     * kMaxScanResults). Full sweeps replace getScannedNetworks(), the list
+     * the UI shows; the scan functions return a view of their results,
+     * valid until the next scan.
+     */
+    Span<const WiFiNetwork> scanNetworks(uint8_t maxCount = 10);
+
+    /**
+     * Scan only the channels saved networks were last seen on. Falls back to
+     * a full sweep when no channel is known, when none of the saved networks
+     * answered, or every fullSweepEvery targeted scans. A targeted scan
+     * returns its own results and leaves getScannedNetworks() as it was.
+     */
+    Span<const WiFiNetwork> scanSaved(uint8_t maxCount = 10);
+
+    /** Probe for a single SSID, on its last known channel unless anyChannel; the shown list is kept */
+    Span<const WiFiNetwork> scanFor(const char* ssid, bool anyChannel = false);
+
+    /** Start a full sweep in the background; results arrive through pollScan() */
+    bool startScan();
+
+    /**
+     * True once the background sweep has finished (or failed); the results
+     * are then in getScannedNetworks(). False while it runs or when none was started.
+     */
+    bool pollScan(uint8_t maxCount = 10);
+    bool scanPending() const { return _scanPending; }
+
+    /** True once after a full sweep (foreground or background) replaced getScannedNetworks() */
+    bool takeScanUpdate() { bool u = _scanUpdated; _scanUpdated = false; return u; }
+
+    /** Per-channel dwell for targeted scans, and how often to force a full sweep */
+    void setScanConfig(uint32_t dwellMs, uint8_t fullSweepEvery);
+
+    const ScanStats& lastScanStats() const { return _lastScan; }
 
     /** Connect to the given SSID/password, blocking up to timeoutMs */
     bool connect(const char* ssid, const char* password, uint32_t timeoutMs = 10000);
 
+    /** Connect to a known access point, skipping the association scan */
+    bool connect(const char* ssid, const char* password, int32_t channel, const uint8_t* bssid,
+                 uint32_t timeoutMs = 10000);
+
+    /**
+     * Start connecting and return at once; loop() finishes the job (saving
+     * the credentials on success). Check connecting() / isConnected().
+     */
+    void startConnect(const char* ssid, const char* password, int32_t channel = 0, const uint8_t* bssid = nullptr,
+                      uint32_t timeoutMs = 10000);
+    bool connecting() const { return _connectPending; }
+
+    /** Heap allocations by the calling task in the last connect, WiFi.begin() to saving (AllocCounter) */
+    uint16_t lastConnectAllocs() const { return _connectAllocs; }
+
+    /**
+     * Non-blocking mode: loop() never waits on the radio. Auto-reconnect and
+     * roaming then scan in the background and connect via startConnect().
+     */
+    void setNonBlocking(bool enable) { _nonBlocking = enable; }
+    bool nonBlocking() const { return _nonBlocking; }
+
     /** Disconnect from the current network */
     void disconnect();
 
@@ -52,20 +155,48 @@ public:
     bool isConnected() const;
 
     /** Get the current SSID (empty if none) */
-    String currentSSID() const;
+    SsidString currentSSID() const;
 
     /** Get current RSSI (0 if not connected) */
     int32_t rssi() const;
 
+    /** RSSI history and link-loss counters, sampled from loop() while connected */
+    const LinkMonitor& link() const { return _link; }
+
+    /**
+     * Roam to a stronger BSSID of the current SSID once the smoothed RSSI
+     * has stayed below thresholdDbm for holdSamples samples, or once the link
+ * has been lost repeatedly within LinkMonitor::kLossWindowMs.
+     */
+    void setRoaming(bool enable, int8_t thresholdDbm = -75, uint8_t holdSamples = 5);
+
     /** Save credentials to SPIFFS */
     bool saveCredentials(const char* ssid, const char* password);
 
-    /** Load credentials from SPIFFS */
+    /** Load credentials from SPIFFS, migrating a legacy /wifi.json if present */
     bool loadCredentials();
 
+    /** Forget saved credentials for an SSID */
+    bool forgetCredentials(const char* ssid);
+
     /** Get last error code */
     WiFiError lastError() const;
 
+    /** Apply modem sleep, listen interval and TX power for a profile */
+    void setPowerProfile(PowerProfile p);
+    PowerProfile powerProfile() const { return _profile; }
+    const PowerProfileParams& powerParams() const { return profileParams(_profile); }
+    static const PowerProfileParams& profileParams(PowerProfile p);
+
+#if DEVDASH_ENABLE_DIAGNOSTICS
+    /** Host and port of the netbench server used by runBenchmark() */
+    void setBenchEndpoint(const char* host, uint16_t port = 5399);
+    const NetBench::Config& benchConfig() const { return _benchCfg; }
+
+    /** Run throughput, UDP latency and gateway/DNS probes; blocks for a few seconds */
+    NetBench::Report runBenchmark();
+#endif
+
     /** Enable or disable automatic reconnect */
     void setAutoReconnect(bool enable);
 
@@ -75,16 +206,101 @@ public:
     /** Clean up resources */
     void destroy();
 
-    const std::vector<WiFiNetwork>& getScannedNetworks() const { return _scannedNetworks; }
+    /** Last full sweep; the view stays valid until the sweep after next */
+    Span<const WiFiNetwork> getScannedNetworks() const {
+        uint8_t i = _shown;
+        return Span<const WiFiNetwork>(_scanned[i], _scannedCount[i]);
+    }
+
+    /** Drop the last scan results */
+    void clearScanResults() { _scannedCount[_shown] = 0; }
+
+    /** Put back results kept elsewhere, e.g. across a UI suspend */
+    void restoreScanResults(Span<const WiFiNetwork> networks);
+
+    Span<const SavedWiFiNetwork> getSavedNetworks() const { return _store.entries(); }
 
-    const std::vector<SavedWiFiNetwork>& getSavedNetworks() const { return _savedNetworks; }
+    /** Saved credentials for an SSID (nullptr if not saved) */
+    const SavedWiFiNetwork* findSaved(const char* ssid) const { return _store.find(ssid); }
 
 private:
+    // Last channel/BSSID a saved network was seen on
+    struct ApHint {
+        SsidString ssid;
+        uint8_t    channel;
+        uint8_t    bssid[6];
+    };
+
+    static constexpr uint8_t kMaxHints = CredentialStore::kMaxEntries;
+
     WiFiError _lastError;
     bool      _autoReconnect;
-    std::vector<SavedWiFiNetwork> _savedNetworks;
-    std::vector<WiFiNetwork> _scannedNetworks;
+    CredentialStore _store;
+    WiFiNetwork _scanned[2][kMaxScanResults]; // full sweeps; [_shown] is the list the UI shows
+    uint8_t     _scannedCount[2] = {};
+    volatile uint8_t _shown = 0;
+    WiFiNetwork _probed[kMaxScanResults];    // targeted, roam and reconnect scans
+    uint8_t     _probedCount = 0;
+    ApHint      _hints[kMaxHints];
+    uint8_t     _hintCount = 0;
+    uint8_t     _nextHint = 0;   // replaced next once all hint slots are taken
     bool _credsLoaded = false;
-    bool writeSavedNetworksToFile_();
-    static constexpr const char* kJsonPath = "/wifi.json";
+
+    ScanStats _lastScan;
+    uint32_t  _scanDwellMs = 100;
+    bool      _scanPending = false;
+    bool      _scanUpdated = false;
+    bool      _publishScan = false;  // the running background sweep replaces the shown list
+    uint32_t  _scanStartMs = 0;
+    uint16_t  _sweepStartAllocs = 0; // made while starting the background sweep
+
+    // Non-blocking mode: work waiting on a background scan or association
+    bool      _nonBlocking = false;
+    bool      _reconnectPending = false;
+    bool      _roamPending = false;
+    bool      _connectPending = false;
+    uint32_t  _connectDeadlineMs = 0;
+    SsidString _connectSsid;
+    KeyString  _connectPassword;
+    uint16_t  _connectAllocs = 0;
+    uint8_t   _fullSweepEvery = 10;
+    uint8_t   _targetedSinceFull = 0;
+    uint32_t  _nextReconnectMs = 0;
+    PowerProfile _profile = PowerProfile::Balanced;
+
+#if DEVDASH_ENABLE_DIAGNOSTICS
+    NetBench::Config _benchCfg;
+#endif
+
+    LinkMonitor _link;
+    int         _linkEventId = -1;
+    uint32_t    _nextLinkSampleMs = 0;
+    bool        _roaming = true;
+    uint8_t     _roamHoldSamples = 5;
+    uint32_t    _nextRoamMs = 0;
+
+    void applyListenInterval_();
+    void sampleLink_();
+    void maybeRoam_();
+    void finishRoam_(const WiFiNetwork& best);
+    void connectStrongestSaved_(Span<const WiFiNetwork> found);
+    void scanFinished_();
+    void pollConnect_();
+    void connected_(const char* ssid, const char* password);
+
+    bool startSweep_();
+    void showScanned_(uint8_t list);
+    Span<const WiFiNetwork> probed_() const { return Span<const WiFiNetwork>(_probed, _probedCount); }
+    void collectScanResults_(int n, WiFiNetwork* list, uint8_t& count);
+    void finishScan_(WiFiNetwork* list, uint8_t& count, uint8_t maxCount, uint32_t start,
+                     const AllocCounter::Probe& allocs);
+    void rememberHint_(const char* ssid, uint8_t channel, const uint8_t* bssid);
+    const ApHint* findHint_(const char* ssid) const;
+
+    static constexpr uint32_t kFullSweepDwellMs   = 300; // WiFi.scanNetworks() default
+    static constexpr uint32_t kRoamCooldownMs      = 30000;
+    static constexpr int8_t   kRoamHysteresisDb    = 8;
+    static constexpr float    kRoamLossPerMin      = 0.6f;  // 3 losses in LinkMonitor's window
+    static constexpr const char* kStorePath = "/wifi.db";
+    static constexpr const char* kLegacyJsonPath = "/wifi.json";
 };
\ No newline at end of file
@@ -0,0 +1,208 @@
+#include "../DevDashConfig.h"
+#if DEVDASH_ENABLE_WIFI_UI
+#include "WifiListView.h"
+#include "LinkMonitor.h"
+#include "AllocCounter.h"
+#include "../DevDashLog.h"
+
+void WifiListView::begin(lv_obj_t* panel, ThemeManager* theme, SelectCb onSelect, void* user) {
+    _panel = panel;
+    _theme = theme;
+    _onSelect = onSelect;
+    _user = user;
+    _rows.reserve(WifiManager::kMaxScanResults);
+    _slot.reserve(WifiManager::kMaxScanResults);
+    lv_obj_add_event_cb(_panel, clickCb_, LV_EVENT_CLICKED, this);
+}
+
+void WifiListView::update(Span<const WiFiNetwork> networks, const WifiManager& manager) {
+    if (!_panel) return;
+    uint32_t start = micros();
+    AllocCounter::Probe allocs;
+    Stats st;
+
+    for (auto& r : _rows) r.live = false;
+
+    // Pass 1: networks that already have a row keep it
+    std::vector<int16_t>& slot = _slot;
+    slot.assign(networks.size(), -1);
+    for (size_t n = 0; n < networks.size(); ++n) {
+        for (size_t i = 0; i < _rows.size(); ++i) {
+            if (!_rows[i].live && _rows[i].ssid == networks[n].ssid) {
+                _rows[i].live = true;
+                slot[n] = (int16_t)i;
+                break;
+            }
+        }
+    }
+
+    // Pass 2: new networks take a free row from the pool, or a new one
+    for (size_t n = 0; n < networks.size(); ++n) {
+        if (slot[n] >= 0) continue;
+        size_t before = _rows.size();
+        Row& row = acquireRow_();
+        if (_rows.size() != before) ++st.created;
+        row.live = true;
+        row.ssid = networks[n].ssid;
+        row.rssi = INT32_MIN; // force text update
+        slot[n] = (int16_t)(&row - &_rows[0]);
+    }
+
+    for (size_t n = 0; n < networks.size(); ++n) {
+        Row& row = _rows[slot[n]];
+        const WiFiNetwork& nw = networks[n];
+        bool saved = manager.findSaved(nw.ssid.c_str()) != nullptr;
+        if (row.rssi != nw.rssi || row.saved != saved) {
+            row.rssi = nw.rssi;
+            row.saved = saved;
+            setRssiText_(row);
+            ++st.updated;
+        }
+        if (lv_obj_has_flag(row.obj, LV_OBJ_FLAG_HIDDEN)) lv_obj_clear_flag(row.obj, LV_OBJ_FLAG_HIDDEN);
+    }
+
+    // Park rows that are no longer in the results
+    for (auto& r : _rows) {
+        if (r.live) continue;
+        if (!lv_obj_has_flag(r.obj, LV_OBJ_FLAG_HIDDEN)) lv_obj_add_flag(r.obj, LV_OBJ_FLAG_HIDDEN);
+        ++st.pooled;
+    }
+
+    // Only touch rows whose position actually changed
+    for (size_t i = 0; i < slot.size(); ++i) {
+        lv_obj_t* obj = _rows[slot[i]].obj;
+        if (lv_obj_get_index(obj) != (int32_t)i) {
+            lv_obj_move_to_index(obj, (int32_t)i);
+            ++st.moved;
+        }
+    }
+
+    if (networks.empty() && !_empty) {
+        _empty = lv_label_create(_panel);
+        lv_label_set_text(_empty, "No networks found.");
+    }
+    if (_empty) {
+        if (networks.empty()) lv_obj_clear_flag(_empty, LV_OBJ_FLAG_HIDDEN);
+        else lv_obj_add_flag(_empty, LV_OBJ_FLAG_HIDDEN);
+    }
+
+    st.rows = (uint16_t)networks.size();
+    st.allocs = (uint16_t)allocs.count();
+    st.updateUs = micros() - start;
+    _stats = st;
+    DD_LOGD(Ui, "WiFi list: %u rows, %u created, %u updated, %u moved, %u pooled, %u allocs in %lu us",
+            st.rows, st.created, st.updated, st.moved, st.pooled, st.allocs, (unsigned long)st.updateUs);
+}
+
+void WifiListView::destroy() {
+    if (_panel) lv_obj_remove_event_cb_with_user_data(_panel, clickCb_, this);
+    std::vector<Row>().swap(_rows);
+    std::vector<int16_t>().swap(_slot);
+    _panel = nullptr;
+    _empty = nullptr;
+    _theme = nullptr;
+}
+
+WifiListView::Row& WifiListView::acquireRow_() {
+    for (auto& r : _rows) {
+        if (!r.live) return r;
+    }
+
+    Row r;
+    r.obj = lv_obj_create(_panel);
+    lv_obj_remove_style_all(r.obj);
+    _theme->addStyle(r.obj, ThemeManager::Role::WifiRow);
+    _theme->addStyle(r.obj, ThemeManager::Role::WifiRowPressed);
+    lv_obj_clear_flag(r.obj, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_flag(r.obj, LV_OBJ_FLAG_EVENT_BUBBLE);
+    // Rows are never erased from _rows, so the index stays valid
+    lv_obj_set_user_data(r.obj, reinterpret_cast<void*>(static_cast<uintptr_t>(_rows.size())));
+    lv_obj_add_event_cb(r.obj, drawCb_, LV_EVENT_DRAW_MAIN, this);
+
+    r.rssi = INT32_MIN;
+    r.saved = false;
+    r.live = false;
+    r.rssiText[0] = '\0';
+    _rows.push_back(r);
+    return _rows.back();
+}
+
+void WifiListView::setRssiText_(Row& row) {
+    if (row.saved) snprintf(row.rssiText, sizeof(row.rssiText), "%s %d dBm", LV_SYMBOL_SAVE, (int)row.rssi);
+    else snprintf(row.rssiText, sizeof(row.rssiText), "%d dBm", (int)row.rssi);
+    lv_obj_invalidate(row.obj);
+}
+
+void WifiListView::drawCb_(lv_event_t* e) {
+    static const int32_t kPad = 6, kBarW = 3, kBarGap = 2, kBarMaxH = 14;
+    static const int32_t kBarsW = 4 * kBarW + 3 * kBarGap;
+
+    auto* self = static_cast<WifiListView*>(lv_event_get_user_data(e));
+    lv_obj_t* obj = static_cast<lv_obj_t*>(lv_event_get_current_target(e));
+    size_t idx = static_cast<size_t>(reinterpret_cast<uintptr_t>(lv_obj_get_user_data(obj)));
+    if (!self || idx >= self->_rows.size()) return;
+    const Row& row = self->_rows[idx];
+    lv_layer_t* layer = lv_event_get_layer(e);
+
+    lv_area_t c;
+    lv_obj_get_coords(obj, &c);
+    const lv_font_t* font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+    int32_t lineH = lv_font_get_line_height(font);
+    int32_t rowH = lv_area_get_height(&c);
+    int32_t textY = c.y1 + (rowH - lineH) / 2;
+
+    // Signal bars, right-aligned
+    uint8_t level = LinkMonitor::barsFor(row.rssi);
+    lv_draw_rect_dsc_t bar;
+    lv_draw_rect_dsc_init(&bar);
+    int32_t barsX = c.x2 - kPad - kBarsW + 1;
+    int32_t baseY = c.y1 + (rowH + kBarMaxH) / 2 - 1;
+    for (int i = 0; i < 4; ++i) {
+        bar.bg_color = i < level ? lv_palette_main(LV_PALETTE_BLUE) : lv_palette_lighten(LV_PALETTE_GREY, 2);
+        lv_area_t a;
+        a.x1 = barsX + i * (kBarW + kBarGap);
+        a.x2 = a.x1 + kBarW - 1;
+        a.y2 = baseY;
+        a.y1 = baseY - (i + 1) * kBarMaxH / 4 + 1;
+        lv_draw_rect(layer, &bar, &a);
+    }
+
+    // RSSI text (with saved marker), right-aligned before the bars
+    lv_draw_label_dsc_t label;
+    lv_draw_label_dsc_init(&label);
+    label.font = font;
+    label.color = lv_palette_main(LV_PALETTE_BLUE);
+    label.align = LV_TEXT_ALIGN_RIGHT;
+    label.text = row.rssiText;
+    int32_t rssiW = lv_text_get_width(row.rssiText, strlen(row.rssiText), font, 0);
+    lv_area_t ra;
+    ra.x2 = barsX - kPad - 1;
+    ra.x1 = ra.x2 - rssiW + 1;
+    ra.y1 = textY;
+    ra.y2 = textY + lineH - 1;
+    lv_draw_label(layer, &label, &ra);
+
+    // SSID fills what is left; one line high so long names are clipped, not wrapped
+    label.color = lv_obj_get_style_text_color(obj, LV_PART_MAIN);
+    label.align = LV_TEXT_ALIGN_LEFT;
+    label.text = row.ssid.c_str();
+    lv_area_t sa;
+    sa.x1 = c.x1 + kPad;
+    sa.x2 = ra.x1 - kPad - 1;
+    sa.y1 = textY;
+    sa.y2 = textY + lineH - 1;
+    if (sa.x2 > sa.x1) lv_draw_label(layer, &label, &sa);
+}
+
+void WifiListView::clickCb_(lv_event_t* e) {
+    auto* self = static_cast<WifiListView*>(lv_event_get_user_data(e));
+    lv_obj_t* target = static_cast<lv_obj_t*>(lv_event_get_target(e));
+    if (!self || !self->_onSelect || target == self->_panel) return;
+    for (const auto& r : self->_rows) {
+        if (r.obj == target && r.live) {
+            self->_onSelect(self->_user, r.ssid.c_str());
+            return;
+        }
+    }
+}
+#endif // DEVDASH_ENABLE_WIFI_UI
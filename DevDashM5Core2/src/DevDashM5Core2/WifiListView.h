@@ -0,0 +1,68 @@
+#pragma once
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include <vector>
+#include "WifiManager.h"
+#include "ThemeManager.h"
+
+/**
+ * Scan-result list that keeps its rows between refreshes. Each row is a
+ * single fixed-height object that draws its SSID, saved marker, RSSI text
+ * and signal bars in its own draw callback, so no per-row layout runs.
+ *
+ * New results are matched to existing rows by SSID: matched rows are only
+ * redrawn when their RSSI or saved state changed, rows are moved only when
+ * their position changed, and rows for networks that disappeared are hidden
+ * and reused later. Clicks on any row reach a single CLICKED handler on the
+ * panel. Rows and the matching scratch are kept between updates, so an
+ * update that needs no more rows than before does not allocate.
+ */
+class WifiListView {
+public:
+    typedef void (*SelectCb)(void* user, const char* ssid);
+
+    struct Stats {
+        uint16_t rows = 0;        // visible after the last update
+        uint16_t created = 0;     // rows built in the last update
+        uint16_t updated = 0;     // rows whose text changed
+        uint16_t moved = 0;       // rows that changed position
+        uint16_t pooled = 0;      // hidden rows kept for reuse
+        uint16_t allocs = 0;      // heap allocations in the last update (AllocCounter)
+        uint32_t updateUs = 0;
+    };
+
+    void begin(lv_obj_t* panel, ThemeManager* theme, SelectCb onSelect, void* user);
+
+    /** Diff `networks` (display order) against the current rows */
+    void update(Span<const WiFiNetwork> networks, const WifiManager& manager);
+
+    /** Forget the rows; the caller owns and deletes the panel */
+    void destroy();
+
+    const Stats& stats() const { return _stats; }
+
+private:
+    struct Row {
+        lv_obj_t*  obj;
+        SsidString ssid;
+        int32_t   rssi;
+        bool      saved;
+        bool      live;
+        char      rssiText[24];
+    };
+
+    lv_obj_t*        _panel = nullptr;
+    lv_obj_t*        _empty = nullptr;
+    ThemeManager*    _theme = nullptr;
+    SelectCb         _onSelect = nullptr;
+    void*            _user = nullptr;
+    std::vector<Row> _rows;
+    std::vector<int16_t> _slot; // row shown at each list position, during update()
+    Stats            _stats;
+
+    Row& acquireRow_();
+    static void setRssiText_(Row& row);
+    static void clickCb_(lv_event_t* e);
+    static void drawCb_(lv_event_t* e);
+};
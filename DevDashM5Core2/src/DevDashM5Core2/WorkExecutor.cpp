@@ -0,0 +1,195 @@
+#include "WorkExecutor.h"
+#include "HeapTracker.h"
+#include "../DevDashLog.h"
+
+constexpr uint8_t  WorkExecutor::kCapacity;
+constexpr uint32_t WorkExecutor::kDefaultStack;
+
+// Arduino's loop() (and so LVGL) runs on ARDUINO_RUNNING_CORE
+#if CONFIG_FREERTOS_UNICORE
+static const BaseType_t kWorkerCore = 0;
+#else
+static const BaseType_t kWorkerCore = ARDUINO_RUNNING_CORE == 0 ? 1 : 0;
+#endif
+
+bool WorkExecutor::begin(uint32_t stackBytes, UBaseType_t priority) {
+    if (_task) return true;
+    _stopping = _stopped = false;
+    if (xTaskCreatePinnedToCore(taskMain_, "devdash-work", stackBytes, this, priority, &_task, kWorkerCore) != pdPASS) {
+        DD_LOGE(Work, "WorkExecutor: task create failed");
+        _task = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void WorkExecutor::end() {
+    if (!_task) return;
+    cancelAll();
+    _stopping = true;
+    xTaskNotifyGive(_task);
+    while (!_stopped) delay(1); // the running job finishes first
+    _task = nullptr;
+    drain();
+}
+
+WorkExecutor::JobId WorkExecutor::submit(WorkFn work, DoneFn done, void* user, Priority priority) {
+    JobId id = 0;
+    portENTER_CRITICAL(&_lock);
+    if (_task && !_stopping) {
+        for (auto& s : _slots) {
+            if (s.state != Free) continue;
+            s.state = Queued;
+            s.priority = priority;
+            s.cancel = false;
+            s.outcome = Outcome::Ok;
+            if (!_nextId) _nextId = 1; // 0 means not queued
+            s.id = id = _nextId++;
+            s.order = _order++;
+            s.queuedUs = micros();
+            s.work = work;
+            s.done = done;
+            s.user = user;
+            ++_stats.submitted;
+            break;
+        }
+    }
+    if (!id) ++_stats.rejected;
+    portEXIT_CRITICAL(&_lock);
+    if (id) xTaskNotifyGive(_task);
+    return id;
+}
+
+bool WorkExecutor::cancel(JobId id) {
+    bool found = false;
+    portENTER_CRITICAL(&_lock);
+    for (auto& s : _slots) {
+        if (!id || s.id != id) continue;
+        if (s.state == Queued) {
+            s.state = Finished;
+            s.outcome = Outcome::Cancelled;
+            s.order = _order++;
+            found = true;
+        } else if (s.state == Running) {
+            s.cancel = true;
+            found = true;
+        }
+        break;
+    }
+    portEXIT_CRITICAL(&_lock);
+    return found;
+}
+
+void WorkExecutor::cancelAll() {
+    portENTER_CRITICAL(&_lock);
+    for (auto& s : _slots) {
+        if (s.state == Queued) {
+            s.state = Finished;
+            s.outcome = Outcome::Cancelled;
+            s.order = _order++;
+        } else if (s.state == Running) {
+            s.cancel = true;
+        }
+    }
+    portEXIT_CRITICAL(&_lock);
+}
+
+uint8_t WorkExecutor::drain(uint8_t max) {
+    uint8_t delivered = 0;
+    while (delivered < max) {
+        // Oldest finished job first; its slot is freed before the callback so
+        // the callback may submit follow-up work
+        Slot* next = nullptr;
+        portENTER_CRITICAL(&_lock);
+        for (auto& s : _slots) {
+            if (s.state == Finished && (!next || (int32_t)(s.order - next->order) < 0)) next = &s;
+        }
+        DoneFn done = nullptr;
+        void* user = nullptr;
+        Outcome outcome = Outcome::Ok;
+        if (next) {
+            done = next->done;
+            user = next->user;
+            outcome = next->outcome;
+            if (outcome == Outcome::Cancelled) ++_stats.cancelled;
+            else ++_stats.completed;
+            next->state = Free;
+        }
+        portEXIT_CRITICAL(&_lock);
+        if (!next) break;
+        if (done) done(user, outcome);
+        ++delivered;
+    }
+    return delivered;
+}
+
+uint8_t WorkExecutor::pending() const {
+    uint8_t n = 0;
+    portENTER_CRITICAL(&_lock);
+    for (const auto& s : _slots) {
+        if (s.state == Queued || s.state == Running) ++n;
+    }
+    portEXIT_CRITICAL(&_lock);
+    return n;
+}
+
+void WorkExecutor::resetStats() {
+    portENTER_CRITICAL(&_lock);
+    _stats = Stats();
+    portEXIT_CRITICAL(&_lock);
+}
+
+/* -------------------- Worker -------------------- */
+
+WorkExecutor::Slot* WorkExecutor::nextQueued_() {
+    Slot* best = nullptr;
+    for (auto& s : _slots) {
+        if (s.state != Queued) continue;
+        if (!best || s.priority < best->priority ||
+            (s.priority == best->priority && (int32_t)(s.order - best->order) < 0)) {
+            best = &s;
+        }
+    }
+    return best;
+}
+
+void WorkExecutor::run_() {
+    for (;;) {
+        portENTER_CRITICAL(&_lock);
+        Slot* s = nextQueued_();
+        uint32_t start = micros();
+        if (s) {
+            s->state = Running;
+            _stats.lastWaitUs = start - s->queuedUs;
+            if (_stats.lastWaitUs > _stats.maxWaitUs) _stats.maxWaitUs = _stats.lastWaitUs;
+        }
+        portEXIT_CRITICAL(&_lock);
+        if (!s) return;
+
+        bool ok;
+        {
+            // Jobs that tag their own allocations override this
+            HeapTracker::Scope heap(HeapTracker::Tag::Work);
+            ok = s->work ? s->work(s->user, s->cancel) : true;
+        }
+        uint32_t runUs = micros() - start;
+
+        portENTER_CRITICAL(&_lock);
+        s->outcome = s->cancel ? Outcome::Cancelled : ok ? Outcome::Ok : Outcome::Failed;
+        s->order = _order++;
+        s->state = Finished;
+        _stats.lastRunUs = runUs;
+        if (runUs > _stats.maxRunUs) _stats.maxRunUs = runUs;
+        portEXIT_CRITICAL(&_lock);
+    }
+}
+
+void WorkExecutor::taskMain_(void* arg) {
+    auto* self = static_cast<WorkExecutor*>(arg);
+    while (!self->_stopping) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        self->run_();
+    }
+    self->_stopped = true;
+    vTaskDelete(nullptr);
+}
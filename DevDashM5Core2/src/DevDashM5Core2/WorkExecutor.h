@@ -0,0 +1,97 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * Runs blocking work (flash I/O, scans, connects, benchmarks) on a task
+ * pinned to the core LVGL does not use, and hands the results back to it.
+ *
+ * The queue is a fixed array of kCapacity slots; a slot stays taken until
+ * the job's completion has been delivered, so submit() fails rather than
+ * allocating when it is full. Queued jobs start highest priority first,
+ * oldest first within a priority. Completions are delivered by drain(),
+ * which the LVGL thread calls, so UI code needs no locking. (Posting them
+ * with lv_async_call() instead would take the LVGL lock and allocate from
+ * the LVGL heap on the worker for every job.) Jobs must not use LVGL.
+ */
+class WorkExecutor {
+public:
+    enum class Priority : uint8_t { High, Normal, Low };
+    enum class Outcome : uint8_t { Ok, Failed, Cancelled };
+
+    typedef uint32_t JobId; // 0 = not queued
+
+    /** Runs on the worker; long work should poll `cancel`. Returns false on failure */
+    typedef bool (*WorkFn)(void* user, const volatile bool& cancel);
+    /** Runs on the LVGL thread from drain(), exactly once per queued job */
+    typedef void (*DoneFn)(void* user, Outcome outcome);
+
+    static constexpr uint8_t  kCapacity     = 16;
+    static constexpr uint32_t kDefaultStack = 8192;
+
+    struct Stats {
+        uint32_t submitted = 0;
+        uint32_t rejected = 0;    // queue full or not started
+        uint32_t completed = 0;   // delivered Ok or Failed
+        uint32_t cancelled = 0;
+        uint32_t lastWaitUs = 0;  // submit() to start of work
+        uint32_t maxWaitUs = 0;
+        uint32_t lastRunUs = 0;
+        uint32_t maxRunUs = 0;
+    };
+
+    WorkExecutor() { _lock = portMUX_INITIALIZER_UNLOCKED; }
+    ~WorkExecutor() { end(); }
+
+    /** Start the worker task on the non-UI core */
+    bool begin(uint32_t stackBytes = kDefaultStack, UBaseType_t priority = 1);
+    /** Cancel what is queued, wait for the running job, deliver the completions and stop */
+    void end();
+    bool running() const { return _task != nullptr; }
+
+    JobId submit(WorkFn work, DoneFn done, void* user, Priority priority = Priority::Normal);
+
+    /**
+     * A queued job is dropped; a running one sees `cancel` set. Either way it
+     * completes as Cancelled. False if the id is unknown or already finished.
+     */
+    bool cancel(JobId id);
+    void cancelAll();
+
+    /** Deliver up to `max` completions, in the order the jobs finished; LVGL thread only */
+    uint8_t drain(uint8_t max = kCapacity);
+
+    /** Jobs queued or running */
+    uint8_t pending() const;
+    const Stats& stats() const { return _stats; }
+    void resetStats();
+
+private:
+    enum State : uint8_t { Free, Queued, Running, Finished };
+
+    struct Slot {
+        State    state = Free;
+        Priority priority = Priority::Normal;
+        volatile bool cancel = false;
+        Outcome  outcome = Outcome::Ok;
+        JobId    id = 0;
+        uint32_t order = 0;      // submit order, then finish order
+        uint32_t queuedUs = 0;
+        WorkFn   work = nullptr;
+        DoneFn   done = nullptr;
+        void*    user = nullptr;
+    };
+
+    Slot         _slots[kCapacity];
+    mutable portMUX_TYPE _lock;
+    TaskHandle_t _task = nullptr;
+    volatile bool _stopping = false;
+    volatile bool _stopped = false;
+    JobId        _nextId = 1;
+    uint32_t     _order = 0;
+    Stats        _stats;
+
+    Slot* nextQueued_();
+    void run_();
+    static void taskMain_(void* arg);
+};
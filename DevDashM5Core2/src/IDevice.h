@@ -1,9 +1,26 @@
 #pragma once
+#include <stdint.h>
 
 class IDevice {
 public:
     virtual ~IDevice() {}
+    /**
+     * Warm standby: do one short slice of start-up work ahead of the gesture.
+     * Returns true once only showing the UI is left for begin().
+     */
+    virtual bool prepare() { return true; }
+    /** Finish start-up (whatever prepare() has not done) and show the first frame */
     virtual bool begin() = 0;
     virtual void loop() = 0;
+    /**
+     * Hand the UI's memory (LVGL heap, draw buffers, screens) back to the
+     * host sketch; begin() rebuilds it. keepState parks a compact copy of
+     * what was on screen so the resumed UI looks as it was left.
+     */
+    virtual void suspend(bool keepState) { (void)keepState; }
+    /** Draw into this part of the panel only; takes effect at the next begin() */
+    virtual void setRegion(int16_t x, int16_t y, int16_t w, int16_t h) { (void)x; (void)y; (void)w; (void)h; }
+    /** Keep each loop() call to roughly this many microseconds; 0 means unbounded */
+    virtual void setLoopBudget(uint32_t us) { (void)us; }
     virtual void destroy() = 0;
 };
\ No newline at end of file
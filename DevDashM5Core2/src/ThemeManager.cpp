@@ -1,74 +1,318 @@
 #include "ThemeManager.h"
+#include <Arduino.h>
 #include <lvgl.h>
-
-// Color definitions
-static lv_color_t LIGHT_BG   = lv_color_white();
-static lv_color_t DARK_BG    = lv_color_hex(0x222222);
-static lv_color_t LIGHT_TEXT = lv_color_black();
-static lv_color_t DARK_TEXT  = lv_color_white();
-static lv_color_t BUTTON_BG  = lv_color_hex(0x00AA00);
-
+#include "DevDashLog.h"
+
+// rebindTree() writes lv_obj_t::styles directly; check the layout before moving LVGL
+#if LVGL_VERSION_MAJOR != 9 || LVGL_VERSION_MINOR != 3
+#error "ThemeManager rebinds styles through LVGL 9.3 internals; review rebindTree() for this LVGL version"
+#endif
+#include "core/lv_obj_private.h"        // lv_obj_t::styles, rebound in place on a switch
+#include "core/lv_obj_style_private.h"
+#include "display/lv_display_private.h" // every screen, not only the active one
+
+// Color definitions (constexpr so they can seed the constant style tables)
+static constexpr lv_color_t LIGHT_SCREEN  = LV_COLOR_MAKE(0xcc, 0xcc, 0xcc);
+static constexpr lv_color_t DARK_SCREEN   = LV_COLOR_MAKE(0x11, 0x11, 0x11);
+static constexpr lv_color_t LIGHT_BG      = LV_COLOR_MAKE(0xff, 0xff, 0xff);
+static constexpr lv_color_t DARK_BG       = LV_COLOR_MAKE(0x22, 0x22, 0x22);
+static constexpr lv_color_t LIGHT_HEADER  = LV_COLOR_MAKE(0x33, 0x33, 0x33);
+static constexpr lv_color_t DARK_HEADER   = LV_COLOR_MAKE(0x00, 0x00, 0x00);
+static constexpr lv_color_t LIGHT_TEXT    = LV_COLOR_MAKE(0x00, 0x00, 0x00);
+static constexpr lv_color_t DARK_TEXT     = LV_COLOR_MAKE(0xff, 0xff, 0xff);
+static constexpr lv_color_t HEADER_TEXT   = LV_COLOR_MAKE(0xff, 0xff, 0xff);
+static constexpr lv_color_t BUTTON_BG     = LV_COLOR_MAKE(0x00, 0xaa, 0x00);
+static constexpr lv_color_t ICON_OFF      = LV_COLOR_MAKE(0x9e, 0x9e, 0x9e); // LV_PALETTE_GREY
+static constexpr lv_color_t ICON_ON       = LV_COLOR_MAKE(0x4c, 0xaf, 0x50); // LV_PALETTE_GREEN
+static constexpr lv_color_t ROW_PRESSED   = LV_COLOR_MAKE(0x21, 0x96, 0xf3); // LV_PALETTE_BLUE
+
+static const int32_t kHeaderHeight = 40;
+static const int32_t kIconButtonSize = 32;
+static const int32_t kWifiRowHeight = 32;
+static const int32_t kBarW = 3, kBarGap = 2, kBarMaxH = 16;
+
+/* -------------------- Constant style tables -------------------- */
+
+#define PAD_ALL(v)  LV_STYLE_CONST_PAD_TOP(v), LV_STYLE_CONST_PAD_BOTTOM(v), \
+                    LV_STYLE_CONST_PAD_LEFT(v), LV_STYLE_CONST_PAD_RIGHT(v)
+#define FLEX(flow)  LV_STYLE_CONST_LAYOUT(LV_LAYOUT_FLEX), LV_STYLE_CONST_FLEX_FLOW(flow)
+#define FLEX_CENTERED LV_STYLE_CONST_FLEX_MAIN_PLACE(LV_FLEX_ALIGN_CENTER), \
+                    LV_STYLE_CONST_FLEX_CROSS_PLACE(LV_FLEX_ALIGN_CENTER), \
+                    LV_STYLE_CONST_FLEX_TRACK_PLACE(LV_FLEX_ALIGN_CENTER)
+
+// Roles that look the same in both modes
+static const lv_style_const_prop_t header_title_props[] = {
+    LV_STYLE_CONST_TEXT_FONT(&lv_font_montserrat_18),
+    LV_STYLE_CONST_FLEX_GROW(1), // Take all available space
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(header_title_style, header_title_props);
+
+static const lv_style_const_prop_t header_icon_props[] = {
+    LV_STYLE_CONST_TEXT_FONT(&lv_font_montserrat_18),
+    LV_STYLE_CONST_TEXT_COLOR(ICON_OFF),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(header_icon_style, header_icon_props);
+
+static const lv_style_const_prop_t header_icon_on_props[] = {
+    LV_STYLE_CONST_TEXT_COLOR(ICON_ON),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(header_icon_on_style, header_icon_on_props);
+
+// Square button whose only child, the symbol, is centered by the layout
+static const lv_style_const_prop_t icon_button_props[] = {
+    LV_STYLE_CONST_WIDTH(kIconButtonSize), LV_STYLE_CONST_HEIGHT(kIconButtonSize),
+    PAD_ALL(0),
+    LV_STYLE_CONST_LAYOUT(LV_LAYOUT_FLEX), FLEX_CENTERED,
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(icon_button_style, icon_button_props);
+
+static const lv_style_const_prop_t signal_bars_props[] = {
+    LV_STYLE_CONST_WIDTH(4 * kBarW + 3 * kBarGap), LV_STYLE_CONST_HEIGHT(kBarMaxH),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(signal_bars_style, signal_bars_props);
+
+// Wi-Fi rows draw their own content; the style only sizes them
+static const lv_style_const_prop_t wifi_row_props[] = {
+    LV_STYLE_CONST_WIDTH(LV_PCT(100)), LV_STYLE_CONST_HEIGHT(kWifiRowHeight),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(wifi_row_style, wifi_row_props);
+
+static const lv_style_const_prop_t wifi_row_pressed_props[] = {
+    LV_STYLE_CONST_BG_OPA(LV_OPA_20),
+    LV_STYLE_CONST_BG_COLOR(ROW_PRESSED),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(wifi_row_pressed_style, wifi_row_pressed_props);
+
+static const lv_style_const_prop_t modal_title_props[] = {
+    LV_STYLE_CONST_TEXT_FONT(&lv_font_montserrat_18),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(modal_title_style, modal_title_props);
+
+static const lv_style_const_prop_t form_row_props[] = {
+    LV_STYLE_CONST_WIDTH(LV_PCT(100)), LV_STYLE_CONST_HEIGHT(LV_SIZE_CONTENT),
+    PAD_ALL(0), LV_STYLE_CONST_PAD_COLUMN(10),
+    LV_STYLE_CONST_BORDER_WIDTH(0),
+    LV_STYLE_CONST_BG_OPA(LV_OPA_TRANSP),
+    FLEX(LV_FLEX_FLOW_ROW),
+    LV_STYLE_CONST_FLEX_MAIN_PLACE(LV_FLEX_ALIGN_CENTER),
+    LV_STYLE_CONST_FLEX_CROSS_PLACE(LV_FLEX_ALIGN_CENTER),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(form_row_style, form_row_props);
+
+static const lv_style_const_prop_t fill_props[] = {
+    LV_STYLE_CONST_FLEX_GROW(1),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(fill_style, fill_props);
+
+static const lv_style_const_prop_t full_width_props[] = {
+    LV_STYLE_CONST_WIDTH(LV_PCT(100)),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(full_width_style, full_width_props);
+
+static const lv_style_const_prop_t keyboard_props[] = {
+    LV_STYLE_CONST_WIDTH(LV_PCT(100)), LV_STYLE_CONST_HEIGHT(110),
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_BOTTOM_MID),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(keyboard_style, keyboard_props);
+
+// Roles whose colors follow the mode; expanded once per mode below
+#define THEME_MODE_STYLES(M, SCREEN, BG, HEADER, TEXT)                                   \
+    static const lv_style_const_prop_t M##_container_props[] = {                        \
+        LV_STYLE_CONST_WIDTH(LV_PCT(100)), LV_STYLE_CONST_HEIGHT(LV_PCT(100)),          \
+        PAD_ALL(0), LV_STYLE_CONST_BORDER_WIDTH(0),                                     \
+        LV_STYLE_CONST_BG_COLOR(SCREEN), LV_STYLE_CONST_TEXT_COLOR(TEXT),               \
+        FLEX(LV_FLEX_FLOW_COLUMN),                                                      \
+        LV_STYLE_CONST_FLEX_MAIN_PLACE(LV_FLEX_ALIGN_START),                            \
+        LV_STYLE_CONST_FLEX_CROSS_PLACE(LV_FLEX_ALIGN_CENTER),                          \
+        LV_STYLE_CONST_FLEX_TRACK_PLACE(LV_FLEX_ALIGN_CENTER),                          \
+        LV_STYLE_CONST_PROPS_END                                                        \
+    };                                                                                  \
+    LV_STYLE_CONST_INIT(M##_container_style, M##_container_props);                      \
+    static const lv_style_const_prop_t M##_header_props[] = {                           \
+        LV_STYLE_CONST_WIDTH(LV_PCT(100)), LV_STYLE_CONST_HEIGHT(kHeaderHeight),        \
+        LV_STYLE_CONST_BG_COLOR(HEADER), LV_STYLE_CONST_TEXT_COLOR(HEADER_TEXT),        \
+        LV_STYLE_CONST_PAD_LEFT(10), LV_STYLE_CONST_PAD_RIGHT(10),                      \
+        LV_STYLE_CONST_PAD_TOP(4), LV_STYLE_CONST_PAD_BOTTOM(4),                        \
+        FLEX(LV_FLEX_FLOW_ROW),                                                         \
+        LV_STYLE_CONST_FLEX_MAIN_PLACE(LV_FLEX_ALIGN_START),                            \
+        LV_STYLE_CONST_FLEX_CROSS_PLACE(LV_FLEX_ALIGN_CENTER),                          \
+        LV_STYLE_CONST_FLEX_TRACK_PLACE(LV_FLEX_ALIGN_CENTER),                          \
+        LV_STYLE_CONST_PROPS_END                                                        \
+    };                                                                                  \
+    LV_STYLE_CONST_INIT(M##_header_style, M##_header_props);                            \
+    static const lv_style_const_prop_t M##_panel_props[] = {                            \
+        LV_STYLE_CONST_WIDTH(LV_PCT(100)), LV_STYLE_CONST_FLEX_GROW(1),                 \
+        LV_STYLE_CONST_MARGIN_LEFT(10), LV_STYLE_CONST_MARGIN_RIGHT(10),                \
+        LV_STYLE_CONST_MARGIN_BOTTOM(10),                                               \
+        LV_STYLE_CONST_BG_COLOR(BG), PAD_ALL(10),                                       \
+        FLEX(LV_FLEX_FLOW_COLUMN),                                                      \
+        LV_STYLE_CONST_PROPS_END                                                        \
+    };                                                                                  \
+    LV_STYLE_CONST_INIT(M##_panel_style, M##_panel_props);                              \
+    static const lv_style_const_prop_t M##_button_props[] = {                           \
+        LV_STYLE_CONST_BG_COLOR(BUTTON_BG), LV_STYLE_CONST_RADIUS(8),                   \
+        LV_STYLE_CONST_TEXT_COLOR(TEXT), PAD_ALL(8),                                    \
+        LV_STYLE_CONST_LAYOUT(LV_LAYOUT_FLEX), FLEX_CENTERED,                           \
+        LV_STYLE_CONST_PROPS_END                                                        \
+    };                                                                                  \
+    LV_STYLE_CONST_INIT(M##_button_style, M##_button_props);                            \
+    static const lv_style_const_prop_t M##_list_props[] = {                             \
+        LV_STYLE_CONST_WIDTH(LV_PCT(100)), LV_STYLE_CONST_HEIGHT(LV_PCT(100)),          \
+        LV_STYLE_CONST_BG_COLOR(BG),                                                    \
+        LV_STYLE_CONST_PAD_ROW(4), LV_STYLE_CONST_PAD_COLUMN(4),                        \
+        FLEX(LV_FLEX_FLOW_COLUMN),                                                      \
+        LV_STYLE_CONST_PROPS_END                                                        \
+    };                                                                                  \
+    LV_STYLE_CONST_INIT(M##_list_style, M##_list_props);                                \
+    static const lv_style_const_prop_t M##_list_item_props[] = {                        \
+        LV_STYLE_CONST_WIDTH(LV_PCT(100)), LV_STYLE_CONST_HEIGHT(LV_SIZE_CONTENT),      \
+        LV_STYLE_CONST_BG_COLOR(BG),                                                    \
+        LV_STYLE_CONST_BORDER_SIDE(LV_BORDER_SIDE_BOTTOM),                              \
+        LV_STYLE_CONST_BORDER_WIDTH(1), LV_STYLE_CONST_BORDER_COLOR(TEXT),              \
+        PAD_ALL(10), LV_STYLE_CONST_TEXT_COLOR(TEXT),                                   \
+        FLEX(LV_FLEX_FLOW_ROW),                                                         \
+        LV_STYLE_CONST_PROPS_END                                                        \
+    };                                                                                  \
+    LV_STYLE_CONST_INIT(M##_list_item_style, M##_list_item_props);                      \
+    static const lv_style_const_prop_t M##_modal_props[] = {                            \
+        LV_STYLE_CONST_WIDTH(LV_PCT(100)), LV_STYLE_CONST_HEIGHT(LV_PCT(100)),          \
+        LV_STYLE_CONST_ALIGN(LV_ALIGN_CENTER),                                          \
+        LV_STYLE_CONST_BG_COLOR(BG), LV_STYLE_CONST_TEXT_COLOR(TEXT),                   \
+        PAD_ALL(10), FLEX(LV_FLEX_FLOW_COLUMN),                                         \
+        LV_STYLE_CONST_PROPS_END                                                        \
+    };                                                                                  \
+    LV_STYLE_CONST_INIT(M##_modal_style, M##_modal_props);                              \
+    static const lv_style_t* const M##_table[] = {                                      \
+        &M##_container_style, &M##_header_style, &header_title_style,                   \
+        &header_icon_style, &header_icon_on_style, &icon_button_style,                  \
+        &signal_bars_style, &M##_panel_style, &M##_button_style,                        \
+        &M##_list_style, &M##_list_item_style, &wifi_row_style,                         \
+        &wifi_row_pressed_style, &M##_modal_style, &modal_title_style,                  \
+        &form_row_style, &fill_style, &full_width_style, &keyboard_style,               \
+    };                                                                                  \
+    static_assert(sizeof(M##_table) / sizeof(M##_table[0]) ==                           \
+                  static_cast<size_t>(ThemeManager::Role::Count), "one style per role")
+
+THEME_MODE_STYLES(light, LIGHT_SCREEN, LIGHT_BG, LIGHT_HEADER, LIGHT_TEXT);
+THEME_MODE_STYLES(dark, DARK_SCREEN, DARK_BG, DARK_HEADER, DARK_TEXT);
 
 ThemeManager::ThemeManager() {}
 
 ThemeManager::~ThemeManager() {}
 
 bool ThemeManager::begin(Mode m) {
-    // Initialize styles
-    lv_style_init(&headerStyle);
-    lv_style_init(&buttonStyle);
-    lv_style_init(&listStyle);
-    lv_style_init(&listItemStyle);
-    lv_style_init(&containerStyle);
-    lv_style_init(&panelStyle);
-
     if (m == Mode::Light || m == Mode::Dark) {
         mode = m;
     } else {
         mode = Mode::Light; // Default to light mode
     }
+    table = (mode == Mode::Light) ? light_table : dark_table;
 
-    return true; // Assume styles initialized successfully
+    return true; // Styles are constant, nothing to initialize
 }
 
 void ThemeManager::destroy() {
-    lv_style_reset(&headerStyle);
-    lv_style_reset(&buttonStyle);
-    lv_style_reset(&listStyle);
-    lv_style_reset(&listItemStyle);
-    lv_style_reset(&containerStyle);
-    lv_style_reset(&panelStyle);
+    table = nullptr;
 }
 
+constexpr uint32_t ThemeManager::kSwitchBudgetUs;
+
 void ThemeManager::apply(Mode m) {
+    const lv_style_t* const* next = (m == Mode::Light) ? light_table : dark_table;
     mode = m;
-    // Background and text colors based on mode
-    lv_color_t bg   = (mode == Mode::Light) ? LIGHT_BG : DARK_BG;
-    lv_color_t text = (mode == Mode::Light) ? LIGHT_TEXT : DARK_TEXT;
-
-    // Header style
-    lv_style_set_bg_color(&headerStyle, bg);
-    lv_style_set_pad_all(&headerStyle, 10);
-    lv_style_set_text_color(&headerStyle, text);
-
-    // Button style
-    lv_style_set_bg_color(&buttonStyle, BUTTON_BG);
-    lv_style_set_radius(&buttonStyle, 8);
-    lv_style_set_text_color(&buttonStyle, text);
-    lv_style_set_pad_all(&buttonStyle, 8);
-
-    // List container style
-    lv_style_set_bg_color(&listStyle, bg);
-    lv_style_set_pad_row(&listStyle, 4);
-    lv_style_set_pad_column(&listStyle, 4);
-
-    // List item style
-    lv_style_set_bg_color(&listItemStyle, bg);
-    lv_style_set_border_side(&listItemStyle, LV_BORDER_SIDE_BOTTOM);
-    lv_style_set_border_width(&listItemStyle, 1);
-    lv_style_set_border_color(&listItemStyle, text);
-    lv_style_set_pad_all(&listItemStyle, 10);
-    lv_style_set_text_color(&listItemStyle, text);
+    if (next == table) return;
+    const lv_style_t* const* prev = table;
+    table = next;
+    // Before begin() or after destroy() nothing is bound to rebind
+    if (!prev) return;
+
+    uint32_t start = micros();
+    switchStats = SwitchStats();
+
+    // Point every themed style reference at the new table without letting
+    // LVGL refresh anything yet; lv_obj_replace_style() would recompute the
+    // object (and its children) once per replaced style.
+    lv_display_t* disp = lv_display_get_default();
+    if (disp) {
+        for (uint32_t i = 0; i < disp->screen_cnt; ++i) rebindTree(disp->screens[i], prev, next);
+        rebindTree(disp->top_layer, prev, next);
+    }
+    switchStats.rebindUs = micros() - start;
+
+    // One notification refreshes every object on every screen (the top
+    // layer is not a screen, so it is refreshed with it); one invalidation
+    // repaints the screen as a single area.
+    if (switchStats.rebound) {
+        lv_obj_report_style_change(nullptr);
+        if (disp) lv_obj_refresh_style(disp->top_layer, LV_PART_ANY, LV_STYLE_PROP_ANY);
+        lv_obj_invalidate(lv_screen_active());
+    }
+    switchStats.totalUs = micros() - start;
+
+    DD_LOGI(Ui, "Theme: %s, %u objects, %u styles rebound in %lu us (%lu us rebinding)",
+            mode == Mode::Light ? "light" : "dark", switchStats.objects, switchStats.rebound,
+            (unsigned long)switchStats.totalUs, (unsigned long)switchStats.rebindUs);
+    if (switchStats.totalUs > kSwitchBudgetUs) {
+        DD_LOGW(Ui, "Theme: switch over frame budget (%lu us)", (unsigned long)kSwitchBudgetUs);
+    }
+}
+
+void ThemeManager::rebindTree(lv_obj_t* root, const lv_style_t* const* from, const lv_style_t* const* to) {
+    if (!root) return;
+    ++switchStats.objects;
+    for (uint32_t i = 0; i < root->style_cnt; ++i) {
+        lv_obj_style_t& entry = root->styles[i];
+        if (entry.is_local || entry.is_trans) continue;
+        for (int r = 0; r < static_cast<int>(Role::Count); ++r) {
+            if (entry.style != from[r]) continue;
+            // Roles shared by both tables keep their style
+            if (from[r] != to[r]) {
+                entry.style = to[r];
+                ++switchStats.rebound;
+            }
+            break;
+        }
+    }
+    uint32_t n = lv_obj_get_child_count(root);
+    for (uint32_t i = 0; i < n; ++i) rebindTree(lv_obj_get_child(root, i), from, to);
+}
+
+ThemeManager::LookupStats ThemeManager::timeLookups(lv_obj_t* root) {
+    LookupStats stats;
+    if (!root) return stats;
+    uint32_t start = micros();
+    static volatile uint32_t sink; // keeps the reads from being optimised away
+    sink = lookupTree(root, stats);
+    stats.us = micros() - start;
+    return stats;
+}
+
+uint32_t ThemeManager::lookupTree(lv_obj_t* obj, LookupStats& stats) {
+    ++stats.objects;
+    stats.lookups += 8;
+    uint32_t acc = lv_color_to_u32(lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+    acc += lv_obj_get_style_bg_opa(obj, LV_PART_MAIN);
+    acc += lv_color_to_u32(lv_obj_get_style_text_color(obj, LV_PART_MAIN));
+    acc += (uint32_t)(uintptr_t)lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+    acc += lv_obj_get_style_pad_top(obj, LV_PART_MAIN);
+    acc += lv_obj_get_style_pad_left(obj, LV_PART_MAIN);
+    acc += lv_obj_get_style_radius(obj, LV_PART_MAIN);
+    acc += lv_obj_get_style_border_width(obj, LV_PART_MAIN);
+    uint32_t n = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < n; ++i) acc += lookupTree(lv_obj_get_child(obj, i), stats);
+    return acc;
 }
 
 void ThemeManager::loop() {
@@ -79,115 +323,150 @@ ThemeManager::Mode ThemeManager::current() const {
     return mode;
 }
 
-lv_obj_t* ThemeManager::createHeader(lv_obj_t* parent, const char* title, lv_obj_t** out_refresh_btn, lv_obj_t** out_wifi_icon) {
-    // lv_obj_t* cont = lv_obj_create(parent);
-    // lv_obj_add_style(cont, &headerStyle, 0);
-    // lv_obj_set_size(cont, LV_PCT(100), 40);
-    // lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_ROW);
-    // lv_obj_set_flex_align(cont, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+const lv_style_t* ThemeManager::style(Role role) const {
+    return table[static_cast<int>(role)];
+}
 
-    // lv_obj_t* lbl = lv_label_create(cont);
-    // lv_label_set_text(lbl, title);
-    // return cont;
+void ThemeManager::addStyle(lv_obj_t* obj, Role role) {
+    lv_obj_add_style(obj, table[static_cast<int>(role)], selectorFor(role));
+}
 
+lv_style_selector_t ThemeManager::selectorFor(Role role) {
+    if (role == Role::WifiRowPressed) return LV_STATE_PRESSED;
+    if (role == Role::HeaderIconOn) return LV_STATE_CHECKED;
+    return 0;
+}
+
+lv_obj_t* ThemeManager::createHeader(lv_obj_t* parent, const char* title, lv_obj_t** out_refresh_btn, lv_obj_t** out_wifi_icon,
+                                     lv_obj_t** out_signal_bars) {
     lv_obj_t *header = lv_obj_create(parent);
-    lv_obj_add_style(header, &headerStyle, 0);
-    lv_obj_set_size(header, lv_pct(100), 40);
-    lv_obj_set_style_bg_color(header, lv_color_hex(0x333333), 0);
-    // lv_obj_set_style_pad_all(header, 10, 0);
-    lv_obj_set_style_pad_hor(header, 10, 0);
+    addStyle(header, Role::Header);
     lv_obj_clear_flag(header, LV_OBJ_FLAG_SCROLLABLE);
-    lv_obj_set_flex_flow(header, LV_FLEX_FLOW_ROW);
-    lv_obj_set_flex_align(header, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
 
     // Label
     lv_obj_t *label = lv_label_create(header);
     lv_label_set_text(label, title);
-    lv_obj_set_style_text_color(label, lv_color_white(), 0);
-    lv_obj_set_style_text_font(label, &lv_font_montserrat_18, 0);
-    lv_obj_set_flex_grow(label, 1);  // Take all available space
+    addStyle(label, Role::HeaderTitle);
 
     // Refresh Button
-    lv_obj_t *refresh_btn = lv_btn_create(header);
-    lv_obj_set_size(refresh_btn, 32, 32);
-    lv_obj_t *refresh_icon = lv_label_create(refresh_btn);
-    lv_label_set_text(refresh_icon, LV_SYMBOL_REFRESH);
-    lv_obj_center(refresh_icon);
-
+    lv_obj_t *refresh_btn = createIconButton(header, LV_SYMBOL_REFRESH);
     if (out_refresh_btn) *out_refresh_btn = refresh_btn;
 
+    // Grey until the caller marks it LV_STATE_CHECKED (connected)
     lv_obj_t* wifi_icon = lv_label_create(header);
     lv_label_set_text(wifi_icon, LV_SYMBOL_WIFI);
-    lv_obj_set_style_text_color(wifi_icon, lv_palette_main(LV_PALETTE_GREY), 0);
-    lv_obj_set_style_text_font(wifi_icon, &lv_font_montserrat_18, 0);
-    lv_obj_center(wifi_icon);
+    addStyle(wifi_icon, Role::HeaderIcon);
+    addStyle(wifi_icon, Role::HeaderIconOn);
 
     if (out_wifi_icon) *out_wifi_icon = wifi_icon;
 
+    lv_obj_t* bars = createSignalBars(header);
+    if (out_signal_bars) *out_signal_bars = bars;
+
     return header;
 }
 
-lv_obj_t* ThemeManager::createContainer(lv_obj_t *parent) {
-    int32_t w = lv_obj_get_width(parent);
-    int32_t h = lv_obj_get_height(parent);
+lv_obj_t* ThemeManager::createIconButton(lv_obj_t* parent, const char* symbol) {
+    lv_obj_t* btn = lv_btn_create(parent);
+    addStyle(btn, Role::IconButton);
+    lv_label_set_text(lv_label_create(btn), symbol);
+    return btn;
+}
+
+lv_obj_t* ThemeManager::createSignalBars(lv_obj_t* parent) {
+    // One object drawing all four bars; the lit count lives in user_data
+    lv_obj_t* bars = lv_obj_create(parent);
+    lv_obj_remove_style_all(bars);
+    addStyle(bars, Role::SignalBars);
+    lv_obj_clear_flag(bars, (lv_obj_flag_t)(LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_CLICKABLE));
+    lv_obj_add_event_cb(bars, drawSignalBars, LV_EVENT_DRAW_MAIN, nullptr);
+    return bars;
+}
+
+void ThemeManager::setSignalBars(lv_obj_t* bars, uint8_t level) {
+    if (!bars) return;
+    if (level > 4) level = 4;
+    if (reinterpret_cast<uintptr_t>(lv_obj_get_user_data(bars)) == level) return;
+    lv_obj_set_user_data(bars, reinterpret_cast<void*>(static_cast<uintptr_t>(level)));
+    lv_obj_invalidate(bars);
+}
+
+void ThemeManager::drawSignalBars(lv_event_t* e) {
+    lv_obj_t* obj = static_cast<lv_obj_t*>(lv_event_get_current_target(e));
+    uintptr_t level = reinterpret_cast<uintptr_t>(lv_obj_get_user_data(obj));
+    lv_area_t c;
+    lv_obj_get_coords(obj, &c);
+
+    // Bars take the inherited text color, dimmed when unlit
+    lv_draw_rect_dsc_t bar;
+    lv_draw_rect_dsc_init(&bar);
+    bar.bg_color = lv_obj_get_style_text_color(obj, LV_PART_MAIN);
+    for (uintptr_t i = 0; i < 4; ++i) {
+        bar.bg_opa = i < level ? LV_OPA_COVER : LV_OPA_30;
+        lv_area_t a;
+        a.x1 = c.x1 + i * (kBarW + kBarGap);
+        a.x2 = a.x1 + kBarW - 1;
+        a.y2 = c.y2;
+        a.y1 = c.y2 - (i + 1) * kBarMaxH / 4 + 1;
+        lv_draw_rect(lv_event_get_layer(e), &bar, &a);
+    }
+}
 
+lv_obj_t* ThemeManager::createContainer(lv_obj_t *parent) {
     lv_obj_t *container = lv_obj_create(parent);
-    lv_obj_set_size(container, w, h);
-    lv_obj_align(container, LV_ALIGN_TOP_LEFT, 0, 0);
+    addStyle(container, Role::Container);
     lv_obj_clear_flag(container, LV_OBJ_FLAG_SCROLLABLE);
-    lv_obj_set_style_pad_all(container, 0, 0);
-    lv_obj_set_style_border_width(container, 0, 0);
     lv_obj_set_scrollbar_mode(container, LV_SCROLLBAR_MODE_OFF);
-    lv_obj_set_style_bg_color(container, lv_color_hex(0xcccccc), 0);
-    lv_obj_set_flex_flow(container, LV_FLEX_FLOW_COLUMN);
-    lv_obj_set_flex_align(container, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
     return container;
 }
 
 lv_obj_t* ThemeManager::createPanel(lv_obj_t *parent) {
     lv_obj_t *panel = lv_obj_create(parent);
-    lv_obj_set_size(panel, lv_pct(100), (lv_pct(100) - 20));
-    lv_obj_center(panel);
-    // lv_obj_set_style_margin_all(panel, 10, 0);
-    lv_obj_set_style_margin_hor(panel, 10, 0);
-    lv_obj_set_style_bg_color(panel, lv_color_white(), 0);
+    addStyle(panel, Role::Panel);
     lv_obj_set_scroll_dir(panel, LV_DIR_VER);
     lv_obj_set_scrollbar_mode(panel, LV_SCROLLBAR_MODE_AUTO);
-    lv_obj_set_flex_flow(panel, LV_FLEX_FLOW_COLUMN);
-    lv_obj_set_style_pad_all(panel, 10, 0);
     return panel;
 }
 
+lv_obj_t* ThemeManager::createModal() {
+    lv_obj_t* modal = lv_obj_create(lv_layer_top());
+    addStyle(modal, Role::Modal);
+    lv_obj_add_flag(modal, LV_OBJ_FLAG_HIDDEN); // start hidden
+    lv_obj_set_scrollbar_mode(modal, LV_SCROLLBAR_MODE_OFF);
+    return modal;
+}
+
+lv_obj_t* ThemeManager::createFormRow(lv_obj_t* parent) {
+    lv_obj_t* row = lv_obj_create(parent);
+    addStyle(row, Role::FormRow);
+    lv_obj_clear_flag(row, LV_OBJ_FLAG_SCROLLABLE);
+    return row;
+}
+
 lv_obj_t* ThemeManager::createButton(lv_obj_t* parent, const char* text, lv_event_cb_t event_cb, void* user_data) {
     lv_obj_t* btn = lv_btn_create(parent);
-    lv_obj_add_style(btn, &buttonStyle, 0);
+    addStyle(btn, Role::Button);
     lv_obj_add_event_cb(btn, event_cb, LV_EVENT_CLICKED, user_data);
 
-    lv_obj_t* lbl = lv_label_create(btn);
-    lv_label_set_text(lbl, text);
-    lv_obj_center(lbl);
+    lv_label_set_text(lv_label_create(btn), text);
     return btn;
 }
 
 lv_obj_t* ThemeManager::createList(lv_obj_t* parent) {
     lv_obj_t* list = lv_obj_create(parent);
-    lv_obj_add_style(list, &listStyle, 0);
-    lv_obj_set_size(list, LV_PCT(100), LV_PCT(100));
+    addStyle(list, Role::List);
     lv_obj_set_scroll_dir(list, LV_DIR_VER);
     lv_obj_set_scrollbar_mode(list, LV_SCROLLBAR_MODE_AUTO);
-    lv_obj_set_flex_flow(list, LV_FLEX_FLOW_COLUMN);
     return list;
 }
 
 lv_obj_t* ThemeManager::addListItem(lv_obj_t* list, const char* text, lv_event_cb_t event_cb, void* user_data) {
     lv_obj_t* row = lv_obj_create(list);
-    lv_obj_add_style(row, &listItemStyle, 0);
-    lv_obj_set_size(row, LV_PCT(100), LV_SIZE_CONTENT);
-    lv_obj_set_flex_flow(row, LV_FLEX_FLOW_ROW);
+    addStyle(row, Role::ListItem);
     lv_obj_add_event_cb(row, event_cb, LV_EVENT_CLICKED, user_data);
 
     lv_obj_t* lbl = lv_label_create(row);
     lv_label_set_text(lbl, text);
-    lv_obj_set_flex_grow(lbl, 1);
+    addStyle(lbl, Role::Fill);
     return row;
-}
\ No newline at end of file
+}
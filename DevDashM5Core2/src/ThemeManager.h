@@ -6,24 +6,105 @@ class ThemeManager {
 public:
     enum class Mode { Light, Dark };
 
+    /**
+     * Shared style for each kind of element the dashboard builds. Objects
+     * get their look, size and layout from these instead of local styles.
+     * The *Pressed / *On roles carry their state selector. Styles are
+     * constant tables in flash, one per mode.
+     */
+    enum class Role : uint8_t {
+        Container,      // root column filling the screen
+        Header,         // title bar row
+        HeaderTitle,
+        HeaderIcon,     // status glyph, grey
+        HeaderIconOn,   // LV_STATE_CHECKED: status glyph, green
+        IconButton,     // 32x32 header button
+        SignalBars,
+        Panel,          // scrollable content column
+        Button,
+        List,
+        ListItem,
+        WifiRow,
+        WifiRowPressed, // LV_STATE_PRESSED
+        Modal,          // full-screen dialog on the top layer
+        ModalTitle,
+        FormRow,        // transparent row of controls
+        Fill,           // takes the remaining space in a flex parent
+        FullWidth,
+        Keyboard,
+        Count
+    };
+
+    struct SwitchStats {
+        uint16_t objects = 0;   // objects visited
+        uint16_t rebound = 0;   // style references moved to the new table
+        uint32_t rebindUs = 0;  // walking and rebinding
+        uint32_t totalUs = 0;   // including the style-change notification
+    };
+
+    struct LookupStats {
+        uint32_t objects = 0;
+        uint32_t lookups = 0;   // lv_obj_get_style_*() calls
+        uint32_t us = 0;
+        uint32_t nsPerLookup() const { return lookups ? (uint32_t)((uint64_t)us * 1000 / lookups) : 0; }
+    };
+
+    /** A switch should finish inside one frame at the default 30 fps */
+    static constexpr uint32_t kSwitchBudgetUs = 33000;
+
     ThemeManager();
     ~ThemeManager();
 
     /** Apply light or dark mode styles */
     bool begin(Mode mode = Mode::Light);
     void destroy();
+
+    /**
+     * Bind the mode's style table and move every themed object over to it in
+     * one pass, then notify LVGL once and invalidate the screen once.
+     */
     void apply(Mode m);
+    const SwitchStats& lastSwitch() const { return switchStats; }
     void loop();
     Mode current() const;
 
+    /** Shared style for a role */
+    const lv_style_t* style(Role role) const;
+
+    /** Add a role's style to an object, with the role's state selector */
+    void addStyle(lv_obj_t* obj, Role role);
+
+    /**
+     * Time resolving the properties every draw reads (colors, font, padding,
+     * radius, border) on each object under root: the cascade walk that
+     * shared role styles keep short. Use it on a freshly built tree.
+     */
+    static LookupStats timeLookups(lv_obj_t* root);
+
     /** Create a standard header bar with title text */
-    lv_obj_t* createHeader(lv_obj_t* parent, const char* title, lv_obj_t** out_refresh_btn, lv_obj_t** out_wifi_icon);
+    lv_obj_t* createHeader(lv_obj_t* parent, const char* title, lv_obj_t** out_refresh_btn, lv_obj_t** out_wifi_icon,
+                           lv_obj_t** out_signal_bars = nullptr);
+
+    /** Create a 32x32 header button showing a symbol */
+    lv_obj_t* createIconButton(lv_obj_t* parent, const char* symbol);
+
+    /** Create a four-bar signal strength indicator */
+    lv_obj_t* createSignalBars(lv_obj_t* parent);
+
+    /** Light the first `level` bars (0..4) of a createSignalBars() indicator */
+    static void setSignalBars(lv_obj_t* bars, uint8_t level);
 
     /** Create a standard header bar with title text */
     lv_obj_t* createContainer(lv_obj_t* parent);
 
     lv_obj_t* createPanel(lv_obj_t* parent);
 
+    /** Create a hidden full-screen dialog on the top layer */
+    lv_obj_t* createModal();
+
+    /** Create a transparent row for a modal's controls */
+    lv_obj_t* createFormRow(lv_obj_t* parent);
+
     /** Create a styled button with text and event callback */
     lv_obj_t* createButton(lv_obj_t* parent, const char* text, lv_event_cb_t event_cb, void* user_data);
 
@@ -35,10 +116,12 @@ public:
 
 private:
     Mode mode;
-    lv_style_t headerStyle;
-    lv_style_t containerStyle;
-    lv_style_t panelStyle;
-    lv_style_t buttonStyle;
-    lv_style_t listStyle;
-    lv_style_t listItemStyle;
-};
\ No newline at end of file
+    const lv_style_t* const* table = nullptr; // indexed by Role
+    SwitchStats switchStats;
+
+    void rebindTree(lv_obj_t* root, const lv_style_t* const* from, const lv_style_t* const* to);
+
+    static lv_style_selector_t selectorFor(Role role);
+    static uint32_t lookupTree(lv_obj_t* obj, LookupStats& stats);
+    static void drawSignalBars(lv_event_t* e);
+};
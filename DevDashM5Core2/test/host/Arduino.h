@@ -0,0 +1,134 @@
+#pragma once
+
+/**
+ * Just enough of Arduino-ESP32 for the native env to build the modules that
+ * do not touch LVGL, the display or the radio (see platformio.ini). Time,
+ * Serial and FreeRTOS are simulated in process; tests drive them through
+ * the host:: helpers (host::advanceMs() is in freertos_host.h).
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "freertos_host.h"
+
+using std::max;
+using std::min;
+
+inline uint32_t millis() { return (uint32_t)(host::nowUs() / 1000); }
+inline uint32_t micros() { return (uint32_t)host::nowUs(); }
+inline void delay(uint32_t ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+
+inline size_t host_strlcpy(char* dst, const char* src, size_t size) {
+    size_t len = strlen(src);
+    if (size) {
+        size_t n = len < size - 1 ? len : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = 0;
+    }
+    return len;
+}
+#define strlcpy host_strlcpy
+
+class String {
+public:
+    String(const char* s = "") : _s(s ? s : "") {}
+    String(const std::string& s) : _s(s) {}
+    const char* c_str() const { return _s.c_str(); }
+    size_t length() const { return _s.size(); }
+    String operator+(const char* s) const { return String(_s + s); }
+    bool operator==(const String& o) const { return _s == o._s; }
+
+private:
+    std::string _s;
+};
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(const uint8_t* buf, size_t len) = 0;
+    size_t write(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+    size_t print(const char* s) { return write(s); }
+    size_t println(const char* s = "") { return write(s) + write("\n"); }
+    size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        char buf[512];
+        va_list args;
+        va_start(args, fmt);
+        int n = vsnprintf(buf, sizeof(buf), fmt, args);
+        va_end(args);
+        if (n < 0) return 0;
+        return write((const uint8_t*)buf, std::min((size_t)n, sizeof(buf) - 1));
+    }
+    virtual void flush() {}
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+};
+
+/**
+ * Serial: input is whatever the test fed in, output is collected (and
+ * echoed to stdout when echo is on). availableForWrite() reports the room
+ * set by the test, which write() does not enforce.
+ */
+class HardwareSerial : public Stream {
+public:
+    void begin(unsigned long) {}
+
+    size_t write(const uint8_t* buf, size_t len) override {
+        std::lock_guard<std::mutex> hold(_mutex);
+        _out.append((const char*)buf, len);
+        if (_echo) fwrite(buf, 1, len, stdout);
+        return len;
+    }
+    using Print::write;
+    int available() override {
+        std::lock_guard<std::mutex> hold(_mutex);
+        return (int)(_in.size() - _inPos);
+    }
+    int read() override {
+        std::lock_guard<std::mutex> hold(_mutex);
+        return _inPos < _in.size() ? (uint8_t)_in[_inPos++] : -1;
+    }
+    int availableForWrite() { return _room; }
+    explicit operator bool() const { return true; }
+
+    // Test side
+    void feed(const char* s) {
+        std::lock_guard<std::mutex> hold(_mutex);
+        _in.append(s);
+    }
+    std::string takeOutput() {
+        std::lock_guard<std::mutex> hold(_mutex);
+        std::string out;
+        out.swap(_out);
+        return out;
+    }
+    void setRoom(int bytes) { _room = bytes; }
+    void setEcho(bool on) { _echo = on; }
+
+private:
+    std::mutex  _mutex;
+    std::string _in;
+    size_t      _inPos = 0;
+    std::string _out;
+    int         _room = 256;
+    bool        _echo = false;
+};
+
+/** Never destroyed, so the log's drain thread can write during exit */
+inline HardwareSerial& hostSerial() {
+    static HardwareSerial* serial = new HardwareSerial();
+    return *serial;
+}
+#define Serial (::hostSerial())
@@ -0,0 +1,116 @@
+#pragma once
+
+/**
+ * fs::FS over an in-memory map of paths to bytes, with SPIFFS semantics
+ * where the dashboard relies on them (rename does not replace). Tests reach
+ * the bytes through MemFS::bytes() to tear or corrupt a file.
+ */
+
+#include <Arduino.h>
+#include <map>
+#include <memory>
+#include <vector>
+
+#define FILE_READ   "r"
+#define FILE_WRITE  "w"
+#define FILE_APPEND "a"
+
+namespace fs {
+
+typedef std::vector<uint8_t> Bytes;
+
+class File {
+public:
+    File() {}
+    File(std::shared_ptr<Bytes> data, size_t pos, bool writable) : _data(data), _pos(pos), _writable(writable) {}
+
+    explicit operator bool() const { return (bool)_data; }
+
+    size_t write(const uint8_t* buf, size_t len) {
+        if (!_data || !_writable) return 0;
+        if (_pos + len > _data->size()) _data->resize(_pos + len);
+        memcpy(_data->data() + _pos, buf, len);
+        _pos += len;
+        return len;
+    }
+    size_t read(uint8_t* buf, size_t len) {
+        if (!_data) return 0;
+        size_t n = std::min(len, _data->size() - _pos);
+        memcpy(buf, _data->data() + _pos, n);
+        _pos += n;
+        return n;
+    }
+    int read() {
+        uint8_t c;
+        return read(&c, 1) ? c : -1;
+    }
+    size_t readBytes(char* buf, size_t len) { return read((uint8_t*)buf, len); }
+    int available() const { return _data ? (int)(_data->size() - _pos) : 0; }
+    size_t size() const { return _data ? _data->size() : 0; }
+    void flush() {}
+    void close() { _data.reset(); }
+
+private:
+    std::shared_ptr<Bytes> _data;
+    size_t _pos = 0;
+    bool   _writable = false;
+};
+
+class FS {
+public:
+    virtual ~FS() {}
+    virtual File open(const char* path, const char* mode) = 0;
+    virtual bool exists(const char* path) = 0;
+    virtual bool remove(const char* path) = 0;
+    virtual bool rename(const char* from, const char* to) = 0;
+
+    File open(const String& path, const char* mode) { return open(path.c_str(), mode); }
+    bool exists(const String& path) { return exists(path.c_str()); }
+    bool remove(const String& path) { return remove(path.c_str()); }
+    bool rename(const String& from, const String& to) { return rename(from.c_str(), to.c_str()); }
+};
+
+class MemFS : public FS {
+public:
+    File open(const char* path, const char* mode) override {
+        auto it = _files.find(path);
+        if (mode[0] == 'r') {
+            if (it == _files.end()) return File();
+            return File(it->second, 0, false);
+        }
+        if (it == _files.end() || mode[0] == 'w') {
+            _files[path] = std::make_shared<Bytes>();
+            it = _files.find(path);
+        }
+        return File(it->second, it->second->size(), true);
+    }
+    bool exists(const char* path) override { return _files.count(path) != 0; }
+    bool remove(const char* path) override { return _files.erase(path) != 0; }
+    bool rename(const char* from, const char* to) override {
+        auto it = _files.find(from);
+        if (it == _files.end() || _files.count(to)) return false;
+        _files[to] = it->second;
+        _files.erase(from);
+        return true;
+    }
+
+    using FS::open;
+    using FS::exists;
+    using FS::remove;
+    using FS::rename;
+
+    /** A file's contents, created empty if missing */
+    Bytes& bytes(const char* path) {
+        std::shared_ptr<Bytes>& data = _files[path];
+        if (!data) data = std::make_shared<Bytes>();
+        return *data;
+    }
+    void format() { _files.clear(); }
+
+private:
+    std::map<std::string, std::shared_ptr<Bytes>> _files;
+};
+
+} // namespace fs
+
+using fs::File;
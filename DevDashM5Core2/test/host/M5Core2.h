@@ -0,0 +1,3 @@
+#pragma once
+
+// Nothing the host-built modules use; LVGLRenderer.h includes it
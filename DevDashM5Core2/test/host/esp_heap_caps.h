@@ -0,0 +1,50 @@
+#pragma once
+
+/**
+ * heap_caps on the host: every region is the process heap. The figures
+ * heap_caps_get_info() reports are whatever the test set with
+ * host::heapInfo(), per region.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_SPIRAM   (1 << 10)
+#define MALLOC_CAP_8BIT     (1 << 2)
+
+typedef struct {
+    size_t   total_free_bytes;
+    size_t   total_allocated_bytes;
+    size_t   largest_free_block;
+    size_t   minimum_free_bytes;
+    size_t   allocated_blocks;
+    size_t   free_blocks;
+    size_t   total_blocks;
+} multi_heap_info_t;
+
+namespace host {
+
+inline multi_heap_info_t& heapInfo(uint32_t caps) {
+    static multi_heap_info_t internal = {}, psram = {};
+    return (caps & MALLOC_CAP_SPIRAM) ? psram : internal;
+}
+
+} // namespace host
+
+inline void* heap_caps_malloc(size_t size, uint32_t) { return malloc(size); }
+inline void* heap_caps_calloc(size_t n, size_t size, uint32_t) { return calloc(n, size); }
+inline void  heap_caps_free(void* p) { free(p); }
+inline void  heap_caps_get_info(multi_heap_info_t* info, uint32_t caps) { *info = host::heapInfo(caps); }
+inline size_t heap_caps_get_free_size(uint32_t caps) { return host::heapInfo(caps).total_free_bytes; }
+inline size_t heap_caps_get_largest_free_block(uint32_t caps) { return host::heapInfo(caps).largest_free_block; }
+
+// HeapTracker.cpp defines the __wrap_* hooks the device links in with
+// -Wl,--wrap; the host does not wrap, so the real allocator is plain libc
+// and tests call the hooks directly.
+extern "C" {
+inline void* __real_malloc(size_t size) { return malloc(size); }
+inline void* __real_calloc(size_t n, size_t size) { return calloc(n, size); }
+inline void* __real_realloc(void* p, size_t size) { return realloc(p, size); }
+inline void  __real_free(void* p) { free(p); }
+}
@@ -0,0 +1,206 @@
+#pragma once
+
+/**
+ * FreeRTOS as the dashboard uses it, on std::thread. Tasks are detached
+ * threads; notifications are a counter per task. Critical sections share
+ * one recursive lock, which is what disabling interrupts on both cores
+ * amounts to. The task list for uxTaskGetSystemState() is whatever the test
+ * set with host::setTasks().
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef int32_t  BaseType_t;
+typedef uint32_t UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdTRUE  1
+#define pdFALSE 0
+#define pdPASS  1
+#define pdFAIL  0
+#define portMAX_DELAY        0xFFFFFFFFu
+#define portTICK_PERIOD_MS   1
+#define pdMS_TO_TICKS(ms)    ((TickType_t)(ms))
+#define portNUM_PROCESSORS   2
+#define tskIDLE_PRIORITY     0
+#define tskNO_AFFINITY       0x7FFFFFFF
+#define ARDUINO_RUNNING_CORE 1
+#define CONFIG_FREERTOS_UNICORE 0
+
+#define configUSE_TRACE_FACILITY       1
+#define configGENERATE_RUN_TIME_STATS  1
+#define configTASKLIST_INCLUDE_COREID  1
+
+namespace host {
+
+inline std::atomic<uint64_t>& clockOffsetUs() {
+    static std::atomic<uint64_t> offset{ 0 };
+    return offset;
+}
+
+/** Time since start, plus whatever advanceMs() added */
+inline uint64_t nowUs() {
+    using namespace std::chrono;
+    static const steady_clock::time_point start = steady_clock::now();
+    return (uint64_t)duration_cast<microseconds>(steady_clock::now() - start).count() + clockOffsetUs();
+}
+
+/** Move the tick count, millis() and micros() forward without waiting */
+inline void advanceMs(uint32_t ms) { clockOffsetUs() += (uint64_t)ms * 1000; }
+
+struct Task {
+    const char* name;
+    BaseType_t  core;
+    uint32_t    notified = 0;
+    std::mutex  mutex;
+    std::condition_variable wake;
+
+    Task(const char* n, BaseType_t c) : name(n), core(c) {}
+};
+
+inline Task*& currentTask() {
+    static thread_local Task* task = nullptr;
+    return task;
+}
+
+/** The calling thread's task; a thread the shim did not start counts as loopTask */
+inline Task* selfTask() {
+    Task*& t = currentTask();
+    if (!t) t = new Task("loopTask", ARDUINO_RUNNING_CORE);
+    return t;
+}
+
+inline std::recursive_mutex& criticalLock() {
+    static std::recursive_mutex* lock = new std::recursive_mutex();
+    return *lock;
+}
+
+} // namespace host
+
+typedef host::Task* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+struct portMUX_TYPE {
+    uint32_t owner;
+};
+#define portMUX_INITIALIZER_UNLOCKED (portMUX_TYPE{ 0 })
+#define portENTER_CRITICAL(mux) ((void)(mux), host::criticalLock().lock())
+#define portEXIT_CRITICAL(mux)  ((void)(mux), host::criticalLock().unlock())
+
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t, void* arg,
+                                          UBaseType_t, TaskHandle_t* handle, BaseType_t core) {
+    host::Task* task = new host::Task(name, core == tskNO_AFFINITY ? -1 : core);
+    if (handle) *handle = task;
+    std::thread([fn, arg, task] {
+        host::currentTask() = task;
+        fn(arg);
+    }).detach();
+    return pdPASS;
+}
+
+/** The thread returns from the task function right after; nothing to free */
+inline void vTaskDelete(TaskHandle_t) {}
+
+inline void vTaskDelay(TickType_t ticks) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks ? ticks : 1));
+}
+
+inline TaskHandle_t xTaskGetCurrentTaskHandle() { return host::selfTask(); }
+inline BaseType_t xPortGetCoreID() { return host::selfTask()->core < 0 ? 0 : host::selfTask()->core; }
+inline const char* pcTaskGetTaskName(TaskHandle_t t) { return (t ? t : host::selfTask())->name; }
+inline UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t) { return 4096; }
+
+inline TickType_t xTaskGetTickCount() { return (TickType_t)(host::nowUs() / 1000); }
+
+inline BaseType_t xTaskNotifyGive(TaskHandle_t t) {
+    {
+        std::lock_guard<std::mutex> hold(t->mutex);
+        ++t->notified;
+    }
+    t->wake.notify_one();
+    return pdPASS;
+}
+
+inline uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t wait) {
+    host::Task* t = host::selfTask();
+    std::unique_lock<std::mutex> hold(t->mutex);
+    if (wait == portMAX_DELAY) {
+        t->wake.wait(hold, [t] { return t->notified != 0; });
+    } else {
+        t->wake.wait_for(hold, std::chrono::milliseconds(wait), [t] { return t->notified != 0; });
+    }
+    uint32_t n = t->notified;
+    if (n) t->notified = clear ? 0 : n - 1;
+    return n;
+}
+
+// Task list
+
+typedef enum { eRunning, eReady, eBlocked, eSuspended, eDeleted } eTaskState;
+
+struct TaskStatus_t {
+    TaskHandle_t xHandle;
+    const char*  pcTaskName;
+    UBaseType_t  xTaskNumber;
+    eTaskState   eCurrentState;
+    UBaseType_t  uxCurrentPriority;
+    UBaseType_t  uxBasePriority;
+    uint32_t     ulRunTimeCounter;
+    void*        pxStackBase;
+    uint32_t     usStackHighWaterMark;
+    BaseType_t   xCoreID;
+};
+
+namespace host {
+
+struct TaskList {
+    std::vector<TaskStatus_t> tasks;
+    uint32_t runTime = 0;
+    Task idle0{ "IDLE0", 0 };
+    Task idle1{ "IDLE1", 1 };
+};
+
+inline TaskList& taskList() {
+    static TaskList* list = new TaskList();
+    return *list;
+}
+
+/** What the next uxTaskGetSystemState() reports */
+inline void setTasks(const std::vector<TaskStatus_t>& tasks, uint32_t runTime) {
+    taskList().tasks = tasks;
+    taskList().runTime = runTime;
+}
+
+inline TaskStatus_t task(TaskHandle_t handle, const char* name, uint32_t runTime, uint32_t stackFree,
+                         BaseType_t core) {
+    TaskStatus_t t;
+    memset(&t, 0, sizeof(t));
+    t.xHandle = handle;
+    t.pcTaskName = name;
+    t.ulRunTimeCounter = runTime;
+    t.usStackHighWaterMark = stackFree;
+    t.xCoreID = core;
+    return t;
+}
+
+} // namespace host
+
+inline TaskHandle_t xTaskGetIdleTaskHandleForCPU(UBaseType_t core) {
+    return core == 0 ? &host::taskList().idle0 : core == 1 ? &host::taskList().idle1 : nullptr;
+}
+
+/** Like FreeRTOS: 0 when the array is too small */
+inline UBaseType_t uxTaskGetSystemState(TaskStatus_t* out, UBaseType_t size, uint32_t* runTime) {
+    const host::TaskList& list = host::taskList();
+    if (list.tasks.size() > size) return 0;
+    for (size_t i = 0; i < list.tasks.size(); ++i) out[i] = list.tasks[i];
+    if (runTime) *runTime = list.runTime;
+    return (UBaseType_t)list.tasks.size();
+}
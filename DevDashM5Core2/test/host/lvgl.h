@@ -0,0 +1,39 @@
+#pragma once
+
+/** The few LVGL types and calls the host-built modules name */
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct _lv_display_t lv_display_t;
+typedef struct _lv_indev_t lv_indev_t;
+typedef struct _lv_indev_data_t lv_indev_data_t;
+
+typedef struct {
+    int32_t x1, y1, x2, y2;
+} lv_area_t;
+
+typedef struct {
+    size_t   total_size;
+    size_t   free_cnt;
+    size_t   free_size;
+    size_t   free_biggest_size;
+    size_t   used_cnt;
+    size_t   max_used;
+    uint8_t  used_pct;
+    uint8_t  frag_pct;
+} lv_mem_monitor_t;
+
+namespace host {
+
+/** What lv_mem_monitor() reports */
+inline lv_mem_monitor_t& lvMem() {
+    static lv_mem_monitor_t mon = {};
+    return mon;
+}
+
+} // namespace host
+
+inline void lv_mem_monitor(lv_mem_monitor_t* mon) { *mon = host::lvMem(); }
+inline void lv_lock() {}
+inline void lv_unlock() {}
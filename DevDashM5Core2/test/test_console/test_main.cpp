@@ -0,0 +1,159 @@
+#include <unity.h>
+#include <string>
+#include <DevDashConsole.h>
+
+// DevDashConsole against the scriptable Serial: line assembly across polls,
+// one command per poll, quoting, backspace, overlong and unknown lines, and
+// output written only in whole lines the UART has room for.
+
+struct Call {
+    int         runs = 0;
+    uint8_t     argc = 0;
+    std::string argv[DevDashConsole::kMaxArgs];
+};
+
+static Call call;
+static int owner = 0;
+
+static void record(void* user, uint8_t argc, char** argv) {
+    Call* c = static_cast<Call*>(user);
+    ++c->runs;
+    c->argc = argc;
+    for (uint8_t i = 0; i < argc; ++i) c->argv[i] = argv[i];
+}
+
+static void pollAll() {
+    for (int i = 0; i < 8; ++i) DevDashConsole::poll();
+}
+
+void setUp() {
+    DevDashConsole::removeAll(&call);
+    call = Call();
+    TEST_ASSERT_TRUE(DevDashConsole::add("echo", "record the words", record, &call));
+    Serial.setRoom(256);
+    pollAll(); // flush what earlier tests left
+    Serial.takeOutput();
+}
+
+void tearDown() {}
+
+static void test_quotes_keep_spaces() {
+    Serial.feed("echo  \"my home wifi\"\tsecond \"\"\n");
+    DevDashConsole::poll();
+    TEST_ASSERT_EQUAL(1, call.runs);
+    TEST_ASSERT_EQUAL(4, call.argc);
+    TEST_ASSERT_EQUAL_STRING("my home wifi", call.argv[1].c_str());
+    TEST_ASSERT_EQUAL_STRING("second", call.argv[2].c_str());
+    TEST_ASSERT_EQUAL_STRING("", call.argv[3].c_str());
+}
+
+static void test_line_builds_over_polls_and_one_runs_per_poll() {
+    Serial.feed("ec");
+    DevDashConsole::poll();
+    TEST_ASSERT_EQUAL(0, call.runs);
+    Serial.feed("ho one\r\necho two\n");
+    DevDashConsole::poll();
+    TEST_ASSERT_EQUAL(1, call.runs);
+    TEST_ASSERT_EQUAL_STRING("one", call.argv[1].c_str());
+    DevDashConsole::poll();
+    TEST_ASSERT_EQUAL(2, call.runs);
+    TEST_ASSERT_EQUAL_STRING("two", call.argv[1].c_str());
+}
+
+static void test_reads_at_most_a_poll_budget() {
+    std::string partial(100, 'x');
+    Serial.feed(partial.c_str());
+    DevDashConsole::poll();
+    TEST_ASSERT_EQUAL(100 - DevDashConsole::kReadPerPoll, Serial.available());
+    pollAll();
+    Serial.feed("\n");
+    pollAll();
+}
+
+static void test_backspace_edits_the_line() {
+    Serial.feed("ecxx\b\bho\x7f" "o ok\n");
+    DevDashConsole::poll();
+    TEST_ASSERT_EQUAL(1, call.runs);
+    TEST_ASSERT_EQUAL_STRING("ok", call.argv[1].c_str());
+}
+
+static void test_overlong_and_unknown_lines() {
+    DevDashConsole::Stats before = DevDashConsole::stats();
+    std::string overlong = "echo " + std::string(DevDashConsole::kLineBytes, 'y') + "\n";
+    Serial.feed(overlong.c_str());
+    Serial.feed("nosuch\necho after\n");
+    pollAll();
+    TEST_ASSERT_EQUAL(before.overlong + 1, DevDashConsole::stats().overlong);
+    TEST_ASSERT_EQUAL(before.unknown + 1, DevDashConsole::stats().unknown);
+    TEST_ASSERT_EQUAL(1, call.runs); // only "echo after"
+    TEST_ASSERT_EQUAL_STRING("after", call.argv[1].c_str());
+    std::string out = Serial.takeOutput();
+    TEST_ASSERT_TRUE(out.find("line longer than 96 characters ignored\n") != std::string::npos);
+    TEST_ASSERT_TRUE(out.find("unknown command: nosuch (try help)\n") != std::string::npos);
+}
+
+static void test_output_waits_for_room_and_stays_whole() {
+    Serial.setRoom(10);
+    DevDashConsole::printf("a line of some length\n");
+    DevDashConsole::poll();
+    TEST_ASSERT_EQUAL_STRING("", Serial.takeOutput().c_str());
+    DevDashConsole::printf("half a ");
+    Serial.setRoom(256);
+    DevDashConsole::poll();
+    TEST_ASSERT_EQUAL_STRING("a line of some length\n", Serial.takeOutput().c_str());
+    DevDashConsole::printf("line\n");
+    DevDashConsole::poll();
+    TEST_ASSERT_EQUAL_STRING("half a line\n", Serial.takeOutput().c_str());
+}
+
+static void test_full_ring_drops_and_counts() {
+    Serial.setRoom(0);
+    uint32_t dropped = DevDashConsole::stats().dropped;
+    std::string line(63, 'z');
+    line += '\n';
+    for (int i = 0; i < 40; ++i) DevDashConsole::write(line.c_str(), line.size()); // 2560 bytes
+    TEST_ASSERT_EQUAL(dropped + 8, DevDashConsole::stats().dropped);
+    Serial.setRoom(256);
+    pollAll();
+    TEST_ASSERT_EQUAL(32 * 64, Serial.takeOutput().size());
+}
+
+static void test_help_and_remove_all() {
+    DevDashConsole::add("mine", "owned by this test", record, &owner);
+    Serial.feed("help\n");
+    pollAll();
+    std::string out = Serial.takeOutput();
+    TEST_ASSERT_TRUE(out.find("  echo       record the words\n") != std::string::npos);
+    TEST_ASSERT_TRUE(out.find("  mine       owned by this test\n") != std::string::npos);
+
+    DevDashConsole::removeAll(&owner);
+    Serial.feed("help\n");
+    pollAll();
+    out = Serial.takeOutput();
+    TEST_ASSERT_TRUE(out.find("mine") == std::string::npos);
+    TEST_ASSERT_TRUE(out.find("echo") != std::string::npos);
+}
+
+static void test_idle_poll_cost() {
+    static const uint32_t kPolls = 200000;
+    uint32_t t = micros();
+    for (uint32_t i = 0; i < kPolls; ++i) DevDashConsole::poll();
+    uint32_t ns = (uint32_t)((uint64_t)(micros() - t) * 1000 / kPolls);
+    Serial.setEcho(true);
+    Serial.printf("idle poll %lu ns\n", (unsigned long)ns);
+    Serial.setEcho(false);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_quotes_keep_spaces);
+    RUN_TEST(test_line_builds_over_polls_and_one_runs_per_poll);
+    RUN_TEST(test_reads_at_most_a_poll_budget);
+    RUN_TEST(test_backspace_edits_the_line);
+    RUN_TEST(test_overlong_and_unknown_lines);
+    RUN_TEST(test_output_waits_for_room_and_stays_whole);
+    RUN_TEST(test_full_ring_drops_and_counts);
+    RUN_TEST(test_help_and_remove_all);
+    RUN_TEST(test_idle_poll_cost);
+    return UNITY_END();
+}
@@ -0,0 +1,195 @@
+#include <unity.h>
+#include <FS.h>
+#include <BenchStats.h>
+#include <DevDashM5Core2/CredentialStore.h>
+
+// CredentialStore over an in-memory FS: persistence, recovery from torn
+// and corrupted logs and interrupted compactions, the entry cap, the JSON
+// migration, and save/load/compact times at 10, 100 and 1000 puts.
+
+static fs::MemFS memfs;
+static const char* const kPath = "/wifi.db";
+static const char* const kTmpPath = "/wifi.db.tmp";
+static const size_t kHeaderBytes = 12;
+
+void setUp() {
+    memfs.format();
+}
+
+void tearDown() {}
+
+static void reloadInto(CredentialStore& store) {
+    TEST_ASSERT_TRUE(store.load());
+}
+
+static void test_puts_and_erases_survive_reload() {
+    CredentialStore store(memfs, kPath);
+    TEST_ASSERT_TRUE(store.put("home", "secret-1"));
+    TEST_ASSERT_TRUE(store.put("office", "secret-2"));
+    TEST_ASSERT_TRUE(store.put("home", "secret-3"));
+    TEST_ASSERT_TRUE(store.erase("office"));
+
+    CredentialStore again(memfs, kPath);
+    reloadInto(again);
+    TEST_ASSERT_EQUAL(1, again.size());
+    TEST_ASSERT_NOT_NULL(again.find("home"));
+    TEST_ASSERT_EQUAL_STRING("secret-3", again.find("home")->password.c_str());
+    TEST_ASSERT_NULL(again.find("office"));
+}
+
+static void test_torn_commit_loses_only_the_change_in_flight() {
+    CredentialStore store(memfs, kPath);
+    store.put("home", "old-key");
+    store.put("home", "new-key");
+    // Power cut after the put record, before its commit record
+    fs::Bytes& log = memfs.bytes(kPath);
+    log.resize(log.size() - kHeaderBytes);
+
+    CredentialStore again(memfs, kPath);
+    reloadInto(again);
+    TEST_ASSERT_EQUAL(1, again.size());
+    TEST_ASSERT_EQUAL_STRING("old-key", again.find("home")->password.c_str());
+
+    // The log was rewritten, so a new record lands after a clean tail
+    TEST_ASSERT_TRUE(again.put("cafe", "latte"));
+    CredentialStore third(memfs, kPath);
+    reloadInto(third);
+    TEST_ASSERT_EQUAL(2, third.size());
+    TEST_ASSERT_NOT_NULL(third.find("cafe"));
+}
+
+static void test_torn_record_is_dropped() {
+    CredentialStore store(memfs, kPath);
+    store.put("home", "key-1");
+    store.put("office", "key-2");
+    // Cut into the second put's payload
+    fs::Bytes& log = memfs.bytes(kPath);
+    log.resize(log.size() - kHeaderBytes - 3);
+
+    CredentialStore again(memfs, kPath);
+    reloadInto(again);
+    TEST_ASSERT_EQUAL(1, again.size());
+    TEST_ASSERT_NOT_NULL(again.find("home"));
+    TEST_ASSERT_NULL(again.find("office"));
+}
+
+static void test_corrupted_record_stops_replay() {
+    CredentialStore store(memfs, kPath);
+    store.put("first", "key-1");
+    store.put("second", "key-2");
+    store.put("third", "key-3");
+    // Flip a key byte in the second put: first put + commit, then header + "second"
+    size_t second = 2 * kHeaderBytes + strlen("first") + strlen("key-1");
+    memfs.bytes(kPath)[second + kHeaderBytes + strlen("second")] ^= 0x40;
+
+    CredentialStore again(memfs, kPath);
+    reloadInto(again);
+    TEST_ASSERT_EQUAL(1, again.size());
+    TEST_ASSERT_NOT_NULL(again.find("first"));
+    TEST_ASSERT_NULL(again.find("third"));
+}
+
+static void test_interrupted_compaction_adopts_the_temp_file() {
+    CredentialStore store(memfs, kPath);
+    store.put("home", "key-1");
+    store.put("office", "key-2");
+    TEST_ASSERT_TRUE(store.compact());
+    // Power cut between remove(log) and rename(tmp, log)
+    TEST_ASSERT_TRUE(memfs.rename(kPath, kTmpPath));
+
+    CredentialStore again(memfs, kPath);
+    reloadInto(again);
+    TEST_ASSERT_EQUAL(2, again.size());
+    TEST_ASSERT_TRUE(memfs.exists(kPath));
+    TEST_ASSERT_FALSE(memfs.exists(kTmpPath));
+}
+
+static void test_stale_temp_file_is_ignored() {
+    CredentialStore store(memfs, kPath);
+    store.put("home", "key-1");
+    // Power cut while writing the temp file: the log is still complete
+    memfs.bytes(kTmpPath).assign(5, 0xD5);
+
+    CredentialStore again(memfs, kPath);
+    reloadInto(again);
+    TEST_ASSERT_EQUAL(1, again.size());
+    TEST_ASSERT_FALSE(memfs.exists(kTmpPath));
+}
+
+static void test_new_ssid_past_the_cap_is_refused() {
+    CredentialStore store(memfs, kPath);
+    char ssid[CredentialStore::kMaxSsidLen + 1];
+    for (size_t i = 0; i < CredentialStore::kMaxEntries; ++i) {
+        snprintf(ssid, sizeof(ssid), "network-%u", (unsigned)i);
+        TEST_ASSERT_TRUE(store.put(ssid, "key"));
+    }
+    TEST_ASSERT_FALSE(store.put("one-too-many", "key"));
+    TEST_ASSERT_TRUE(store.put("network-0", "updated")); // updates still work
+    TEST_ASSERT_EQUAL(CredentialStore::kMaxEntries, store.size());
+}
+
+static void test_migrates_legacy_json_and_deletes_it() {
+    const char* json = "{\"networks\":[{\"ssid\":\"home\",\"password\":\"secret\"},"
+                       "{\"ssid\":\"open-cafe\"},{\"ssid\":\"\",\"password\":\"skipped\"}]}";
+    memfs.bytes("/wifi.json").assign(json, json + strlen(json));
+
+    CredentialStore store(memfs, kPath);
+    TEST_ASSERT_TRUE(store.migrateFromJson("/wifi.json"));
+    TEST_ASSERT_FALSE(memfs.exists("/wifi.json"));
+
+    CredentialStore again(memfs, kPath);
+    reloadInto(again);
+    TEST_ASSERT_EQUAL(2, again.size());
+    TEST_ASSERT_EQUAL_STRING("secret", again.find("home")->password.c_str());
+    TEST_ASSERT_EQUAL_STRING("", again.find("open-cafe")->password.c_str());
+}
+
+static void test_save_load_compact_times() {
+    static const size_t kSizes[] = { 10, 100, 1000 };
+    static const char* const kKeys[] = { "correct horse battery staple", "tr0ub4dor&3" };
+    static uint32_t putUs[1000];
+    char ssid[CredentialStore::kMaxSsidLen + 1];
+
+    Serial.setEcho(true);
+    for (size_t n : kSizes) {
+        memfs.format();
+        CredentialStore store(memfs, kPath);
+        // Past the cap the puts update saved SSIDs, so the log keeps
+        // growing and compactions are part of the save time
+        for (size_t i = 0; i < n; ++i) {
+            snprintf(ssid, sizeof(ssid), "bench-network-%u", (unsigned)(i % CredentialStore::kMaxEntries));
+            uint32_t t = micros();
+            TEST_ASSERT_TRUE(store.put(ssid, kKeys[(i / CredentialStore::kMaxEntries) % 2]));
+            putUs[i] = micros() - t;
+        }
+        uint32_t t = micros();
+        CredentialStore loaded(memfs, kPath);
+        reloadInto(loaded);
+        uint32_t loadUs = micros() - t;
+        t = micros();
+        TEST_ASSERT_TRUE(loaded.compact());
+        uint32_t compactUs = micros() - t;
+
+        char name[16];
+        snprintf(name, sizeof(name), "put n=%u", (unsigned)n);
+        BenchStats::report(Serial, name, putUs, n);
+        Serial.printf("%-10s load %lu us  compact %lu us  (%u entries)\n", "", (unsigned long)loadUs,
+                      (unsigned long)compactUs, (unsigned)loaded.size());
+        TEST_ASSERT_EQUAL(n < CredentialStore::kMaxEntries ? n : CredentialStore::kMaxEntries, loaded.size());
+    }
+    Serial.setEcho(false);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_puts_and_erases_survive_reload);
+    RUN_TEST(test_torn_commit_loses_only_the_change_in_flight);
+    RUN_TEST(test_torn_record_is_dropped);
+    RUN_TEST(test_corrupted_record_stops_replay);
+    RUN_TEST(test_interrupted_compaction_adopts_the_temp_file);
+    RUN_TEST(test_stale_temp_file_is_ignored);
+    RUN_TEST(test_new_ssid_past_the_cap_is_refused);
+    RUN_TEST(test_migrates_legacy_json_and_deletes_it);
+    RUN_TEST(test_save_load_compact_times);
+    return UNITY_END();
+}
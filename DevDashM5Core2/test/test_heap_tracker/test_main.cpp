@@ -0,0 +1,261 @@
+#include <unity.h>
+#include <chrono>
+#include <map>
+#include <random>
+#include <vector>
+#include <esp_heap_caps.h>
+#include <lvgl.h>
+#include <DevDashM5Core2/HeapTracker.h>
+
+// HeapTracker's table and tag accounting, driven through the allocator
+// hooks the device links in with -Wl,--wrap (on the host nothing is
+// wrapped, so the tests call __wrap_* themselves). 200k random operations
+// are checked against a reference map, then the hooks' cost is measured.
+
+extern "C" {
+void* __wrap_malloc(size_t size);
+void* __wrap_calloc(size_t n, size_t size);
+void* __wrap_realloc(void* p, size_t size);
+void  __wrap_free(void* p);
+}
+
+typedef HeapTracker::Tag Tag;
+
+/** What the tracker should hold, by the rules in HeapTracker.cpp */
+struct Reference {
+    static const size_t kMaxUsed = HeapTracker::kTableSlots * 3 / 4;
+
+    std::map<void*, std::pair<uint32_t, uint8_t>> table;
+    HeapTracker::TagStats tags[HeapTracker::kTags] = {};
+    uint32_t untracked = 0;
+
+    void insert(void* p, size_t size, uint8_t tag) {
+        ++tags[tag].allocs;
+        if (table.size() >= kMaxUsed) { ++untracked; return; }
+        table[p] = std::make_pair((uint32_t)size, tag);
+        tags[tag].live += size;
+        if (tags[tag].live > tags[tag].peak) tags[tag].peak = tags[tag].live;
+    }
+    uint8_t remove(void* p) {
+        auto it = table.find(p);
+        if (it == table.end()) return 0;
+        uint8_t tag = it->second.second;
+        tags[tag].live -= it->second.first;
+        ++tags[tag].frees;
+        table.erase(it);
+        return tag;
+    }
+    void onAlloc(void* p, size_t size, uint8_t tag) { if (p && tag) insert(p, size, tag); }
+    void onFree(void* p) { if (p && !table.empty()) remove(p); }
+    void onRealloc(void* from, void* to, size_t size, uint8_t tag) {
+        if (!tag && table.empty()) return;
+        uint8_t was = (from && !table.empty()) ? remove(from) : 0;
+        if (was) tag = was;
+        if (to && tag) insert(to, size, tag);
+    }
+};
+
+static void expectMatches(const Reference& ref) {
+    HeapTracker::Snapshot s;
+    HeapTracker::snapshot(s, false);
+    for (uint8_t t = 1; t < HeapTracker::kTags; ++t) {
+        TEST_ASSERT_EQUAL_UINT32(ref.tags[t].live, s.tags[t].live);
+        TEST_ASSERT_EQUAL_UINT32(ref.tags[t].peak, s.tags[t].peak);
+        TEST_ASSERT_EQUAL_UINT32(ref.tags[t].allocs, s.tags[t].allocs);
+        TEST_ASSERT_EQUAL_UINT32(ref.tags[t].frees, s.tags[t].frees);
+    }
+    TEST_ASSERT_EQUAL_UINT32(ref.untracked, s.untracked);
+}
+
+void setUp() {}
+void tearDown() {}
+
+// Runs first: the reference starts from the tracker's zeroed counters
+static void test_random_operations_match_reference() {
+    static const int kOps = 200000;
+    static const size_t kMaxLive = 1000; // past the table's 768, so the full path runs too
+    std::mt19937 rng(12345);
+    Reference ref;
+    std::vector<void*> live;
+
+    for (int op = 0; op < kOps; ++op) {
+        uint8_t tag = rng() % HeapTracker::kTags; // 0 = outside any scope
+        HeapTracker::Scope* scope = tag ? new HeapTracker::Scope(static_cast<Tag>(tag)) : nullptr;
+        uint32_t dice = rng() % 100;
+        size_t size = 1 + rng() % 512;
+        if (live.size() >= kMaxLive) dice = 50;
+
+        if (dice < 45 || live.empty()) {
+            void* p = (dice % 2) ? __wrap_calloc(1, size) : __wrap_malloc(size);
+            ref.onAlloc(p, size, tag);
+            live.push_back(p);
+        } else if (dice < 85) {
+            size_t i = rng() % live.size();
+            __wrap_free(live[i]);
+            ref.onFree(live[i]);
+            live[i] = live.back();
+            live.pop_back();
+        } else {
+            size_t i = rng() % live.size();
+            if (dice == 99) size = 0; // frees the block
+            void* q = __wrap_realloc(live[i], size);
+            if (q || !size) ref.onRealloc(live[i], q, size, tag);
+            if (q) {
+                live[i] = q;
+            } else {
+                live[i] = live.back();
+                live.pop_back();
+            }
+        }
+        delete scope;
+        if (op % 1000 == 999) expectMatches(ref);
+    }
+    expectMatches(ref);
+    TEST_ASSERT_TRUE(ref.untracked > 0);
+
+    for (void* p : live) {
+        __wrap_free(p);
+        ref.onFree(p);
+    }
+    expectMatches(ref);
+    HeapTracker::Snapshot s;
+    HeapTracker::snapshot(s, false);
+    for (uint8_t t = 1; t < HeapTracker::kTags; ++t) TEST_ASSERT_EQUAL(0, s.tags[t].live);
+}
+
+static void test_scopes_nest_and_realloc_keeps_the_tag() {
+    HeapTracker::Snapshot before, after;
+    HeapTracker::snapshot(before, false);
+    void* ui;
+    void* wifi;
+    {
+        HeapTracker::Scope outer(Tag::Ui);
+        {
+            HeapTracker::Scope inner(Tag::Wifi);
+            wifi = __wrap_malloc(100);
+        }
+        ui = __wrap_malloc(10);
+        wifi = __wrap_realloc(wifi, 300); // still Wifi's
+    }
+    HeapTracker::snapshot(after, false);
+    TEST_ASSERT_EQUAL(10, after.tags[(int)Tag::Ui].live - before.tags[(int)Tag::Ui].live);
+    TEST_ASSERT_EQUAL(300, after.tags[(int)Tag::Wifi].live - before.tags[(int)Tag::Wifi].live);
+
+    __wrap_free(ui);
+    __wrap_free(wifi); // outside any scope: still forgotten
+    HeapTracker::snapshot(after, false);
+    TEST_ASSERT_EQUAL(before.tags[(int)Tag::Ui].live, after.tags[(int)Tag::Ui].live);
+    TEST_ASSERT_EQUAL(before.tags[(int)Tag::Wifi].live, after.tags[(int)Tag::Wifi].live);
+}
+
+static void taskChurn(void* arg) {
+    std::atomic<int>* done = static_cast<std::atomic<int>*>(arg);
+    HeapTracker::Scope scope(Tag::Sensors);
+    void* blocks[32] = {};
+    for (int i = 0; i < 20000; ++i) {
+        int k = i % 32;
+        __wrap_free(blocks[k]);
+        blocks[k] = __wrap_malloc(16 + k);
+    }
+    for (void* p : blocks) __wrap_free(p);
+    ++*done;
+}
+
+static void test_tasks_tag_their_own_allocations() {
+    HeapTracker::Snapshot before, after;
+    HeapTracker::snapshot(before, false);
+    std::atomic<int> done(0);
+    xTaskCreatePinnedToCore(taskChurn, "churn-0", 4096, &done, 1, nullptr, 0);
+    xTaskCreatePinnedToCore(taskChurn, "churn-1", 4096, &done, 1, nullptr, 1);
+    // This task allocates untagged meanwhile; none of it may land on Sensors
+    for (int i = 0; i < 20000 || done < 2; ++i) __wrap_free(__wrap_malloc(24));
+    HeapTracker::snapshot(after, false);
+    const HeapTracker::TagStats& a = after.tags[(int)Tag::Sensors];
+    const HeapTracker::TagStats& b = before.tags[(int)Tag::Sensors];
+    TEST_ASSERT_EQUAL(2 * 20000, a.allocs - b.allocs);
+    TEST_ASSERT_EQUAL(2 * 20000, a.frees - b.frees);
+    TEST_ASSERT_EQUAL(b.live, a.live);
+}
+
+static void test_snapshot_regions_and_other() {
+    multi_heap_info_t& internal = host::heapInfo(MALLOC_CAP_INTERNAL);
+    internal.total_free_bytes = 100000;
+    internal.total_allocated_bytes = 50000;
+    internal.largest_free_block = 40000;
+    internal.minimum_free_bytes = 90000;
+    multi_heap_info_t& psram = host::heapInfo(MALLOC_CAP_SPIRAM);
+    psram.total_free_bytes = 1000000;
+    psram.total_allocated_bytes = 200000;
+    psram.largest_free_block = 1000000;
+    lv_mem_monitor_t& lv = host::lvMem();
+    lv.total_size = 64000;
+    lv.free_size = 16000;
+    lv.max_used = 50000;
+    lv.free_biggest_size = 8000;
+    lv.frag_pct = 50;
+
+    void* p;
+    {
+        HeapTracker::Scope scope(Tag::Storage);
+        p = __wrap_malloc(1000);
+    }
+    HeapTracker::Snapshot s;
+    HeapTracker::snapshot(s);
+    TEST_ASSERT_EQUAL(150000, s.internal.size);
+    TEST_ASSERT_EQUAL(60, s.internal.fragPct);
+    TEST_ASSERT_EQUAL(0, s.psram.fragPct);
+    TEST_ASSERT_EQUAL(14000, s.lvgl.minFree);
+    uint32_t tagged = 0;
+    for (uint8_t t = 1; t < HeapTracker::kTags; ++t) tagged += s.tags[t].live;
+    TEST_ASSERT_EQUAL(250000 - tagged - 64000, s.tags[0].live);
+
+    HeapTracker::snapshot(s, false);
+    TEST_ASSERT_EQUAL(0, s.lvgl.size);
+    __wrap_free(p);
+}
+
+// Cost of the hooks per malloc + free pair
+
+static uint32_t pairNs(void* (*alloc)(size_t), void (*release)(void*), int n) {
+    auto t = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) release(alloc(32));
+    return (uint32_t)(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t)
+                          .count() / n);
+}
+
+static void test_hook_overhead() {
+    static const int kPairs = 200000;
+    Serial.setEcho(true);
+    uint32_t plain = pairNs(__real_malloc, __real_free, kPairs);
+    uint32_t empty = pairNs(__wrap_malloc, __wrap_free, kPairs);
+
+    // A tagged block elsewhere: every free now takes the lock and probes
+    void* held;
+    {
+        HeapTracker::Scope scope(Tag::Ui);
+        held = __wrap_malloc(8);
+    }
+    uint32_t busy = pairNs(__wrap_malloc, __wrap_free, kPairs);
+    uint32_t tagged;
+    {
+        HeapTracker::Scope scope(Tag::Ui);
+        tagged = pairNs(__wrap_malloc, __wrap_free, kPairs);
+    }
+    __wrap_free(held);
+
+    Serial.printf("malloc+free     %4lu ns  unwrapped\n", (unsigned long)plain);
+    Serial.printf("  untagged      %4lu ns  (+%ld) table empty\n", (unsigned long)empty, (long)(empty - plain));
+    Serial.printf("  untagged      %4lu ns  (+%ld) table in use\n", (unsigned long)busy, (long)(busy - plain));
+    Serial.printf("  tagged        %4lu ns  (+%ld)\n", (unsigned long)tagged, (long)(tagged - plain));
+    Serial.setEcho(false);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_random_operations_match_reference);
+    RUN_TEST(test_scopes_nest_and_realloc_keeps_the_tag);
+    RUN_TEST(test_tasks_tag_their_own_allocations);
+    RUN_TEST(test_snapshot_regions_and_other);
+    RUN_TEST(test_hook_overhead);
+    return UNITY_END();
+}
@@ -0,0 +1,119 @@
+#include <unity.h>
+#include <chrono>
+#include <BenchStats.h>
+#include <DevDashLog.h>
+
+// DevDashLog with its drain task on a host thread: arguments captured by
+// value and formatted later, level filtering, the per-site rate limit, and
+// what a call costs its caller, as examples/LogBench measures on the device
+// (here in nanoseconds instead of cycles).
+
+void setUp() {
+    DevDashLog::begin();
+    DevDashLog::setLevel(DevDashLog::Level::Info);
+    DevDashLog::setRateLimit(DevDashLog::kDefaultRate);
+    DevDashLog::flush();
+    Serial.takeOutput();
+}
+
+void tearDown() {}
+
+static void test_arguments_are_copied_and_formatted_later() {
+    char name[16] = "temporary";
+    DD_LOGI(Core, "%s %d %lu %.2f %lld %c", name, -5, 7ul, 1.5, 1LL << 40, 'x');
+    strcpy(name, "overwritten");
+    DevDashLog::flush();
+    std::string out = Serial.takeOutput();
+    TEST_ASSERT_TRUE(out.find("I core    temporary -5 7 1.50 1099511627776 x\n") != std::string::npos);
+}
+
+static void test_level_is_checked_before_queueing() {
+    DevDashLog::setLevel(DevDashLog::Module::Wifi, DevDashLog::Level::Warn);
+    uint32_t written = DevDashLog::stats().written;
+    for (int i = 0; i < 10; ++i) DD_LOGI(Wifi, "hidden %d", i);
+    TEST_ASSERT_EQUAL(written, DevDashLog::stats().written);
+    DD_LOGW(Wifi, "shown");
+    TEST_ASSERT_EQUAL(written + 1, DevDashLog::stats().written);
+    DevDashLog::flush();
+    std::string out = Serial.takeOutput();
+    TEST_ASSERT_TRUE(out.find("hidden") == std::string::npos);
+    TEST_ASSERT_TRUE(out.find("W wifi    shown") != std::string::npos);
+}
+
+static void test_rate_limit_counts_and_reports_suppressed() {
+    DevDashLog::setRateLimit(2);
+    uint32_t suppressed = DevDashLog::stats().suppressed;
+    for (int round = 0; round < 2; ++round) {
+        for (int i = 0; i < 10; ++i) DD_LOGI(Ui, "burst %d", round * 10 + i);
+        host::advanceMs(1000); // next window
+    }
+    DevDashLog::flush();
+    TEST_ASSERT_EQUAL(suppressed + 16, DevDashLog::stats().suppressed);
+    std::string out = Serial.takeOutput();
+    // The first record of the second window carries the first window's count
+    TEST_ASSERT_TRUE(out.find("burst 10 (+8 suppressed)") != std::string::npos);
+    TEST_ASSERT_TRUE(out.find("burst 2\n") == std::string::npos);
+}
+
+// Cost per call
+
+static const int kCalls = 2000;
+static uint32_t callNs[kCalls];
+
+static uint32_t nsSince(std::chrono::steady_clock::time_point t) {
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t).count();
+}
+
+static void test_call_cost() {
+    Serial.setEcho(false);
+    // Queued: flushed often enough that the ring never fills
+    DevDashLog::setRateLimit(0);
+    uint32_t dropped = DevDashLog::stats().dropped;
+    for (int i = 0; i < kCalls; ++i) {
+        auto t = std::chrono::steady_clock::now();
+        DD_LOGI(Core, "bench %d: %s %.2f", i, "queued", i * 0.5f);
+        callNs[i] = nsSince(t);
+        if (i % 32 == 31) DevDashLog::flush();
+    }
+    DevDashLog::flush();
+    TEST_ASSERT_EQUAL(dropped, DevDashLog::stats().dropped);
+    BenchStats queued = BenchStats::of(callNs, kCalls);
+
+    DevDashLog::setLevel(DevDashLog::Module::Core, DevDashLog::Level::Warn);
+    for (int i = 0; i < kCalls; ++i) {
+        auto t = std::chrono::steady_clock::now();
+        DD_LOGI(Core, "bench %d: %s %.2f", i, "disabled", i * 0.5f);
+        callNs[i] = nsSince(t);
+    }
+    BenchStats disabled = BenchStats::of(callNs, kCalls);
+    DevDashLog::setLevel(DevDashLog::Module::Core, DevDashLog::Level::Info);
+
+    DevDashLog::setRateLimit(1);
+    for (int i = 0; i < kCalls; ++i) {
+        auto t = std::chrono::steady_clock::now();
+        DD_LOGI(Core, "bench %d: %s %.2f", i, "limited", i * 0.5f);
+        callNs[i] = nsSince(t);
+    }
+    BenchStats limited = BenchStats::of(callNs, kCalls);
+    DevDashLog::flush();
+    Serial.takeOutput();
+
+    Serial.setEcho(true);
+    const BenchStats* all[] = { &queued, &disabled, &limited };
+    const char* const names[] = { "queued", "disabled", "limited" };
+    for (int i = 0; i < 3; ++i) {
+        Serial.printf("%-10s p50 %5lu  p90 %5lu  p99 %5lu  max %6lu ns\n", names[i], (unsigned long)all[i]->p50,
+                      (unsigned long)all[i]->p90, (unsigned long)all[i]->p99, (unsigned long)all[i]->max);
+    }
+    Serial.setEcho(false);
+    TEST_ASSERT_TRUE(disabled.p50 <= queued.p50);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_arguments_are_copied_and_formatted_later);
+    RUN_TEST(test_level_is_checked_before_queueing);
+    RUN_TEST(test_rate_limit_counts_and_reports_suppressed);
+    RUN_TEST(test_call_cost);
+    return UNITY_END();
+}
@@ -0,0 +1,167 @@
+#include <unity.h>
+#include <algorithm>
+#include <vector>
+
+// SystemMonitor against the FreeRTOS stand-in's task list: loop latency
+// percentiles from the histogram, frame rate, per-core CPU load from the
+// idle tasks, and the stack list. SystemMonitor.cpp reads the frame count
+// from LVGLRenderer, which the native env does not build, so it is compiled
+// here with the one static it needs.
+#include "../../src/DevDashM5Core2/SystemMonitor.cpp"
+
+LVGLRenderer::FlushStats LVGLRenderer::flush_stats;
+
+static const uint32_t kPeriodMs = SystemMonitor::kDefaultPeriodMs;
+
+/** What display_flush() counts on the device */
+static void drawFrames(uint32_t n) {
+    const_cast<LVGLRenderer::FlushStats&>(LVGLRenderer::flushStats()).frames += n;
+}
+
+static TaskHandle_t idle(int core) { return xTaskGetIdleTaskHandleForCPU(core); }
+
+/** Run one window: note the samples, then let the period pass */
+static const SystemMonitor::Sample& window(SystemMonitor& mon, const std::vector<uint32_t>& us) {
+    for (uint32_t v : us) mon.noteLoop(v);
+    host::advanceMs(kPeriodMs);
+    mon.loop();
+    return mon.latest();
+}
+
+static uint32_t exact(std::vector<uint32_t> v, uint8_t pct) {
+    std::sort(v.begin(), v.end());
+    size_t rank = (v.size() * pct + 99) / 100;
+    return v[rank ? rank - 1 : 0];
+}
+
+void setUp() {
+    host::advanceMs(1); // the monitor takes millis() 0 for "not started"
+    host::setTasks({}, 0);
+    LVGLRenderer::resetFlushStats();
+}
+
+void tearDown() {}
+
+static void test_percentiles_bound_the_exact_values() {
+    // Below 16 us buckets are exact; above, four per octave, so a
+    // percentile reads at most 25% high and never low
+    std::vector<std::vector<uint32_t>> cases(3);
+    for (uint32_t i = 0; i < 1000; ++i) cases[0].push_back(1 + i);                 // uniform to 1 ms
+    for (uint32_t i = 0; i < 1000; ++i) cases[1].push_back(i % 16);                // all exact
+    for (uint32_t i = 0; i < 1000; ++i) cases[2].push_back(i < 980 ? 200 + i % 50 // a slow tail
+                                                                   : 20000 + i);
+    for (const auto& c : cases) {
+        SystemMonitor mon;
+        mon.loop();
+        const SystemMonitor::Sample& s = window(mon, c);
+        TEST_ASSERT_EQUAL(c.size(), s.loops);
+        TEST_ASSERT_EQUAL(*std::max_element(c.begin(), c.end()), s.loopMaxUs);
+        const uint32_t got[] = { s.loopP50Us, s.loopP90Us, s.loopP99Us };
+        const uint8_t pcts[] = { 50, 90, 99 };
+        for (int i = 0; i < 3; ++i) {
+            uint32_t want = exact(c, pcts[i]);
+            TEST_ASSERT_GREATER_OR_EQUAL(want, got[i]);
+            TEST_ASSERT_LESS_OR_EQUAL(want + want / 4 + 1, got[i]);
+        }
+    }
+}
+
+static void test_each_window_starts_empty() {
+    SystemMonitor mon;
+    mon.loop();
+    window(mon, { 10, 20, 5000 });
+    const SystemMonitor::Sample& s = window(mon, { 7 });
+    TEST_ASSERT_EQUAL(1, s.loops);
+    TEST_ASSERT_EQUAL(7, s.loopMaxUs);
+    TEST_ASSERT_EQUAL(7, s.loopP99Us);
+}
+
+static void test_frame_rate_survives_a_reset() {
+    SystemMonitor mon;
+    mon.loop();
+    drawFrames(30);
+    TEST_ASSERT_EQUAL(30, (int)(window(mon, {}).fps + 0.5f));
+
+    LVGLRenderer::resetFlushStats(); // e.g. a bench sketch, mid-window
+    drawFrames(12);
+    TEST_ASSERT_EQUAL(12, (int)(window(mon, {}).fps + 0.5f));
+}
+
+static void test_cpu_load_from_idle_run_time() {
+    SystemMonitor mon;
+    mon.loop();
+    host::setTasks({ host::task(idle(0), "IDLE0", 500000, 900, 0),
+                     host::task(idle(1), "IDLE1", 800000, 900, 1) }, 1000000);
+    const SystemMonitor::Sample& first = window(mon, {});
+    TEST_ASSERT_EQUAL(-1, first.cpuPct[0]); // no baseline yet
+    TEST_ASSERT_EQUAL(-1, first.cpuPct[1]);
+
+    host::setTasks({ host::task(idle(0), "IDLE0", 750000, 900, 0),
+                     host::task(idle(1), "IDLE1", 1700000, 900, 1) }, 2000000);
+    const SystemMonitor::Sample& s = window(mon, {});
+    TEST_ASSERT_EQUAL(75, s.cpuPct[0]);
+    TEST_ASSERT_EQUAL(10, s.cpuPct[1]);
+}
+
+static void test_tasks_sorted_by_stack_left() {
+    SystemMonitor mon;
+    mon.loop();
+    host::setTasks({ host::task(idle(0), "IDLE0", 0, 3000, 0),
+                     host::task(nullptr, "loopTask", 0, 500, 1),
+                     host::task(nullptr, "devdash-work", 0, 1200, tskNO_AFFINITY) }, 1000);
+    const SystemMonitor::Sample& s = window(mon, {});
+    TEST_ASSERT_EQUAL(3, s.taskCount);
+    TEST_ASSERT_EQUAL_STRING("loopTask", s.tasks[0].name);
+    TEST_ASSERT_EQUAL_STRING("devdash-work", s.tasks[1].name);
+    TEST_ASSERT_EQUAL_STRING("IDLE0", s.tasks[2].name);
+    TEST_ASSERT_EQUAL(500, s.tasks[0].stackFree);
+    TEST_ASSERT_EQUAL(1, s.tasks[0].core);
+    TEST_ASSERT_EQUAL(-1, s.tasks[1].core);
+}
+
+static void test_too_many_tasks_lists_only_the_caller() {
+    SystemMonitor mon;
+    mon.loop();
+    std::vector<TaskStatus_t> many;
+    for (int i = 0; i < SystemMonitor::kMaxTasks + 1; ++i) many.push_back(host::task(nullptr, "t", 0, 100, 0));
+    host::setTasks(many, 1000);
+    const SystemMonitor::Sample& s = window(mon, {});
+    TEST_ASSERT_EQUAL(1, s.taskCount);
+    TEST_ASSERT_EQUAL_STRING("loopTask", s.tasks[0].name);
+    TEST_ASSERT_EQUAL(-1, s.cpuPct[0]);
+}
+
+static void test_cost() {
+    static const uint32_t kCalls = 1000000;
+    SystemMonitor mon;
+    mon.loop();
+    std::vector<TaskStatus_t> tasks;
+    for (int i = 0; i < 24; ++i) tasks.push_back(host::task(nullptr, "task", i * 1000, 4000 - i * 100, i % 2));
+    host::setTasks(tasks, 1000000);
+
+    uint32_t t = micros();
+    for (uint32_t i = 0; i < kCalls; ++i) mon.noteLoop(i & 8191);
+    uint32_t noteNs = (uint32_t)((uint64_t)(micros() - t) * 1000 / kCalls);
+    host::advanceMs(kPeriodMs);
+    t = micros();
+    mon.loop(); // the sample: percentiles, task list and sort
+    uint32_t sampleUs = micros() - t;
+
+    Serial.setEcho(true);
+    Serial.printf("noteLoop %lu ns per call, sample %lu us with %d tasks\n", (unsigned long)noteNs,
+                  (unsigned long)sampleUs, (int)tasks.size());
+    Serial.setEcho(false);
+    TEST_ASSERT_EQUAL(kCalls, mon.latest().loops);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_percentiles_bound_the_exact_values);
+    RUN_TEST(test_each_window_starts_empty);
+    RUN_TEST(test_frame_rate_survives_a_reset);
+    RUN_TEST(test_cpu_load_from_idle_run_time);
+    RUN_TEST(test_tasks_sorted_by_stack_left);
+    RUN_TEST(test_too_many_tasks_lists_only_the_caller);
+    RUN_TEST(test_cost);
+    return UNITY_END();
+}
@@ -0,0 +1,199 @@
+#include <unity.h>
+#include <atomic>
+#include <BenchStats.h>
+#include <DevDashM5Core2/WorkExecutor.h>
+
+// WorkExecutor with its worker on a host thread: start order, exactly-once
+// completions, cancellation, back-pressure, end(), and queue latency and
+// throughput measured the way examples/ExecutorBench does on the device.
+
+static std::atomic<bool> gateOpen(false);
+static std::atomic<int>  started(0);
+
+struct Record {
+    int order[WorkExecutor::kCapacity];
+    int count = 0;
+    int outcomes[3] = {};
+};
+
+struct Job {
+    Record* record;
+    int     tag;
+};
+
+/** Holds the worker until gateOpen, or until cancelled */
+static bool gateWork(void*, const volatile bool& cancel) {
+    ++started;
+    while (!gateOpen && !cancel) delay(1);
+    return true;
+}
+
+static bool recordWork(void* user, const volatile bool&) {
+    Job* job = static_cast<Job*>(user);
+    job->record->order[job->record->count++] = job->tag;
+    return job->tag >= 0;
+}
+
+static void recordDone(void* user, WorkExecutor::Outcome outcome) {
+    ++static_cast<Job*>(user)->record->outcomes[(int)outcome];
+}
+
+static void gateDone(void* user, WorkExecutor::Outcome outcome) {
+    if (user) ++static_cast<Record*>(user)->outcomes[(int)outcome];
+}
+
+static void drainUntil(WorkExecutor& work, const Record& r, int delivered) {
+    uint32_t until = millis() + 2000;
+    while (r.outcomes[0] + r.outcomes[1] + r.outcomes[2] < delivered && (int32_t)(millis() - until) < 0) {
+        work.drain();
+        delay(1);
+    }
+}
+
+/** Block the worker with a gate job, so what is submitted next stays queued */
+static void holdWorker(WorkExecutor& work, Record* record) {
+    gateOpen = false;
+    started = 0;
+    TEST_ASSERT_NOT_EQUAL(0, work.submit(gateWork, gateDone, record, WorkExecutor::Priority::High));
+    while (!started) delay(1);
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_priority_then_submit_order() {
+    WorkExecutor work;
+    TEST_ASSERT_TRUE(work.begin());
+    Record r;
+    holdWorker(work, &r);
+    Job jobs[] = { { &r, 1 }, { &r, 2 }, { &r, 3 }, { &r, 4 } };
+    work.submit(recordWork, recordDone, &jobs[0], WorkExecutor::Priority::Low);
+    work.submit(recordWork, recordDone, &jobs[1], WorkExecutor::Priority::Normal);
+    work.submit(recordWork, recordDone, &jobs[2], WorkExecutor::Priority::High);
+    work.submit(recordWork, recordDone, &jobs[3], WorkExecutor::Priority::Normal);
+    gateOpen = true;
+    drainUntil(work, r, 5);
+
+    TEST_ASSERT_EQUAL(4, r.count);
+    TEST_ASSERT_EQUAL(3, r.order[0]);
+    TEST_ASSERT_EQUAL(2, r.order[1]);
+    TEST_ASSERT_EQUAL(4, r.order[2]);
+    TEST_ASSERT_EQUAL(1, r.order[3]);
+    TEST_ASSERT_EQUAL(5, r.outcomes[(int)WorkExecutor::Outcome::Ok]);
+    work.end();
+}
+
+static void test_failed_and_cancelled_complete_once() {
+    WorkExecutor work;
+    TEST_ASSERT_TRUE(work.begin());
+    Record r;
+    holdWorker(work, &r);
+    Job failing = { &r, -1 };
+    Job dropped = { &r, 7 };
+    work.submit(recordWork, recordDone, &failing);
+    WorkExecutor::JobId id = work.submit(recordWork, recordDone, &dropped);
+    TEST_ASSERT_TRUE(work.cancel(id));
+    TEST_ASSERT_FALSE(work.cancel(id)); // already finished
+    gateOpen = true;
+    drainUntil(work, r, 3);
+    for (int i = 0; i < 20; ++i) { work.drain(); delay(1); }
+
+    TEST_ASSERT_EQUAL(1, r.count); // the cancelled job never ran
+    TEST_ASSERT_EQUAL(1, r.outcomes[(int)WorkExecutor::Outcome::Ok]);
+    TEST_ASSERT_EQUAL(1, r.outcomes[(int)WorkExecutor::Outcome::Failed]);
+    TEST_ASSERT_EQUAL(1, r.outcomes[(int)WorkExecutor::Outcome::Cancelled]);
+    work.end();
+}
+
+static void test_running_job_sees_cancel() {
+    WorkExecutor work;
+    TEST_ASSERT_TRUE(work.begin());
+    Record r;
+    gateOpen = false;
+    started = 0;
+    WorkExecutor::JobId id = work.submit(gateWork, gateDone, &r);
+    while (!started) delay(1);
+    TEST_ASSERT_TRUE(work.cancel(id));
+    drainUntil(work, r, 1);
+    TEST_ASSERT_EQUAL(1, r.outcomes[(int)WorkExecutor::Outcome::Cancelled]);
+    work.end();
+}
+
+static void test_full_queue_rejects_and_end_delivers() {
+    WorkExecutor work;
+    TEST_ASSERT_TRUE(work.begin());
+    Record r;
+    holdWorker(work, &r);
+    static Job jobs[WorkExecutor::kCapacity];
+    int queued = 0;
+    while (work.submit(recordWork, recordDone, &(jobs[queued] = Job{ &r, queued }))) ++queued;
+    TEST_ASSERT_EQUAL(WorkExecutor::kCapacity - 1, queued); // the gate job holds a slot
+    TEST_ASSERT_EQUAL(1, work.stats().rejected);
+
+    gateOpen = true; // end() cancels the queue, waits for the gate job and delivers everything
+    work.end();
+    TEST_ASSERT_EQUAL(WorkExecutor::kCapacity, r.outcomes[0] + r.outcomes[1] + r.outcomes[2]);
+    TEST_ASSERT_EQUAL(0, work.submit(recordWork, recordDone, &jobs[0]));
+}
+
+// Latency and throughput, as in ExecutorBench
+
+static const int kJobs = 2000;
+
+struct Sample {
+    uint32_t submitUs;
+    uint32_t startUs;
+};
+
+static Sample   samples[kJobs];
+static uint32_t waitUs[kJobs];
+static uint32_t roundUs[kJobs];
+static int      delivered = 0;
+
+static void test_queue_latency_and_throughput() {
+    WorkExecutor work;
+    TEST_ASSERT_TRUE(work.begin());
+    delivered = 0;
+    int submitted = 0;
+    uint32_t start = micros();
+    while (delivered < kJobs) {
+        while (submitted < kJobs) {
+            samples[submitted].submitUs = micros();
+            if (!work.submit(
+                    [](void* user, const volatile bool&) {
+                        static_cast<Sample*>(user)->startUs = micros();
+                        return true;
+                    },
+                    [](void* user, WorkExecutor::Outcome) {
+                        Sample* s = static_cast<Sample*>(user);
+                        waitUs[delivered] = s->startUs - s->submitUs;
+                        roundUs[delivered] = micros() - s->submitUs;
+                        ++delivered;
+                    }, &samples[submitted])) {
+                break;
+            }
+            ++submitted;
+        }
+        work.drain();
+    }
+    uint32_t elapsed = micros() - start;
+    work.end();
+
+    Serial.setEcho(true);
+    Serial.printf("%d jobs in %lu us: %.0f jobs/s (queue of %u)\n", kJobs, (unsigned long)elapsed,
+                  kJobs * 1e6f / elapsed, (unsigned)WorkExecutor::kCapacity);
+    BenchStats::report(Serial, "queue", waitUs, kJobs);
+    BenchStats::report(Serial, "roundtrip", roundUs, kJobs);
+    Serial.setEcho(false);
+    TEST_ASSERT_EQUAL(kJobs, (int)work.stats().completed);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_priority_then_submit_order);
+    RUN_TEST(test_failed_and_cancelled_complete_once);
+    RUN_TEST(test_running_job_sees_cancel);
+    RUN_TEST(test_full_queue_rejects_and_end_delivers);
+    RUN_TEST(test_queue_latency_and_throughput);
+    return UNITY_END();
+}
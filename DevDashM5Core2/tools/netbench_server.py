@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+"""Host side of the DevDash link benchmark (see src/DevDashM5Core2/NetBench.h).
+
+TCP: a 12-byte request  b"DDB1" | cmd | 3 reserved | uint32 LE length
+     cmd b"D": stream `length` bytes back, then close
+     cmd b"U": read `length` bytes, answer with uint32 LE bytes received
+UDP: echo every datagram.
+
+    python3 tools/netbench_server.py [--port 5399]
+"""
+
+import argparse
+import socket
+import socketserver
+import struct
+import threading
+
+MAGIC = b"DDB1"
+CHUNK = 64 * 1024
+
+
+def recv_exact(sock, n):
+    buf = bytearray()
+    while len(buf) < n:
+        part = sock.recv(n - len(buf))
+        if not part:
+            break
+        buf += part
+    return bytes(buf)
+
+
+class BenchHandler(socketserver.BaseRequestHandler):
+    def handle(self):
+        sock = self.request
+        sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        hdr = recv_exact(sock, 12)
+        if len(hdr) != 12 or hdr[:4] != MAGIC:
+            return
+        cmd = hdr[4:5]
+        (length,) = struct.unpack("<I", hdr[8:12])
+        peer = "%s:%d" % self.client_address
+
+        if cmd == b"D":
+            payload = bytes(CHUNK)
+            left = length
+            while left > 0:
+                n = min(left, CHUNK)
+                sock.sendall(payload[:n])
+                left -= n
+            print("%s download %d bytes" % (peer, length))
+        elif cmd == b"U":
+            got = 0
+            while got < length:
+                part = sock.recv(min(CHUNK, length - got))
+                if not part:
+                    break
+                got += len(part)
+            sock.sendall(struct.pack("<I", got))
+            print("%s upload %d/%d bytes" % (peer, got, length))
+
+
+class ThreadedTCPServer(socketserver.ThreadingMixIn, socketserver.TCPServer):
+    allow_reuse_address = True
+    daemon_threads = True
+
+
+def udp_echo(port):
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    sock.bind(("0.0.0.0", port))
+    while True:
+        data, addr = sock.recvfrom(2048)
+        sock.sendto(data, addr)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--port", type=int, default=5399)
+    args = parser.parse_args()
+
+    threading.Thread(target=udp_echo, args=(args.port,), daemon=True).start()
+    with ThreadedTCPServer(("0.0.0.0", args.port), BenchHandler) as server:
+        print("netbench server on tcp/udp %d" % args.port)
+        try:
+            server.serve_forever()
+        except KeyboardInterrupt:
+            pass
+
+
+if __name__ == "__main__":
+    main()